@@ -222,6 +222,8 @@ void Usage()
   puts("  -input <dir>     Input directory. Default: current dir");
   puts("  -output <dir>    Output directory/filename. Default: Textures.xbt");
   puts("  -dupecheck       Enable duplicate file detection. Reduces output file size. Default: off");
+  puts("  -nocompress      Store textures uncompressed so they're used directly from the mapped");
+  puts("                   bundle. Increases output file size but speeds up loading. Default: off");
 }
 
 static bool checkDupe(struct MD5Context* ctx,
@@ -384,6 +386,10 @@ int main(int argc, char* argv[])
     {
       dupecheck = true;
     }
+    else if (!strcmp(args[i], "-nocompress"))
+    {
+      flags &= ~FLAGS_USE_LZO;
+    }
     else if (!platform_stricmp(args[i], "-output") || !platform_stricmp(args[i], "-o"))
     {
       OutputFilename = args[++i];
@@ -104,8 +104,8 @@ void CBackgroundInfoLoader::Load(CFileItemList& items)
   m_bIsLoading = true;
 
   m_thread = new CThread(this, "BackgroundLoader");
+  m_thread->SetRole(ThreadRole::BACKGROUND_IO);
   m_thread->Create();
-  m_thread->SetPriority(THREAD_PRIORITY_BELOW_NORMAL);
 }
 
 void CBackgroundInfoLoader::StopAsync()
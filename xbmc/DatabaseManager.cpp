@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "TextureDatabase.h"
 #include "addons/AddonDatabase.h"
+#include "dbwrappers/DatabaseProfiler.h"
 #include "music/MusicDatabase.h"
 #include "pvr/PVRDatabase.h"
 #include "pvr/epg/EpgDatabase.h"
@@ -30,7 +31,12 @@ CDatabaseManager::CDatabaseManager() :
   UpdateDatabase(db);
 }
 
-CDatabaseManager::~CDatabaseManager() = default;
+CDatabaseManager::~CDatabaseManager()
+{
+  CDatabaseProfiler& profiler = CDatabaseProfiler::GetInstance();
+  if (profiler.IsEnabled())
+    profiler.LogSummary();
+}
 
 void CDatabaseManager::Initialize()
 {
@@ -42,6 +48,11 @@ void CDatabaseManager::Initialize()
 
   const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
 
+  CDatabaseProfiler& profiler = CDatabaseProfiler::GetInstance();
+  profiler.SetExplainThreshold(
+      std::chrono::milliseconds(advancedSettings->m_databaseProfilerExplainThreshold));
+  profiler.SetEnabled(advancedSettings->m_databaseProfilerEnabled);
+
   // NOTE: Order here is important. In particular, CTextureDatabase has to be updated
   //       before CVideoDatabase.
   {
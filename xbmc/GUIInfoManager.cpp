@@ -738,6 +738,16 @@ const infomap integer_bools[] =  {{ "isequal",          INTEGER_IS_EQUAL },
 ///     @skinning_v19 **[New Infolabel]** \link Player_Chapters `Player.Chapters`\endlink
 ///     <p>
 ///   }
+///   \table_row3{   <b>`Player.SeekPreview`</b>,
+///                  \anchor Player_SeekPreview
+///                  _string_,
+///     @return The preview image of the position the user is seeking to\, empty if there is none.
+///     @note Seek previews are generated in the background on first playback of a file when
+///     `<video><trickplayinterval>` is set in advancedsettings.xml.
+///     <p><hr>
+///     @skinning_v19 **[New Infolabel]** \link Player_SeekPreview `Player.SeekPreview`\endlink
+///     <p>
+///   }
 const infomap player_labels[] =  {{ "hasmedia",         PLAYER_HAS_MEDIA },
                                   { "hasaudio",         PLAYER_HAS_AUDIO },
                                   { "hasvideo",         PLAYER_HAS_VIDEO },
@@ -790,7 +800,8 @@ const infomap player_labels[] =  {{ "hasmedia",         PLAYER_HAS_MEDIA },
                                   { "frameadvance",     PLAYER_FRAMEADVANCE },
                                   { "icon",             PLAYER_ICON },
                                   { "cutlist",          PLAYER_CUTLIST },
-                                  { "chapters",         PLAYER_CHAPTERS }};
+                                  { "chapters",         PLAYER_CHAPTERS },
+                                  { "seekpreview",      PLAYER_SEEKPREVIEW }};
 
 /// \page modules__infolabels_boolean_conditions
 ///   \table_row3{   <b>`Player.Art(type)`</b>,
@@ -18,8 +18,10 @@
 #include "filesystem/File.h"
 #include "music/Album.h"
 #include "music/Artist.h"
+#include "utils/XmlPullParser.h"
 #include "video/VideoInfoDownloader.h"
 
+#include <stdlib.h>
 #include <string>
 #include <vector>
 
@@ -52,28 +54,10 @@ CInfoScanner::INFO_TYPE CNfoFile::Create(const std::string& strPath,
   {
     // first check if it's an XML file with the info we need
     CVideoInfoTag details;
-    bNfo = GetDetails(details);
-    if (episode > -1 && bNfo && m_type == ADDON_SCRAPER_TVSHOWS)
-    {
-      int infos=0;
-      while (m_headPos != std::string::npos && details.m_iEpisode != episode)
-      {
-        m_headPos = m_doc.find("<episodedetails", m_headPos + 1);
-        if (m_headPos == std::string::npos)
-          break;
-
-        bNfo  = GetDetails(details);
-        infos++;
-      }
-      if (details.m_iEpisode != episode)
-      {
-        bNfo = false;
-        details.Reset();
-        m_headPos = 0;
-        if (infos == 1) // still allow differing nfo/file numbers for single ep nfo's
-          bNfo = GetDetails(details);
-      }
-    }
+    if (episode > -1 && m_type == ADDON_SCRAPER_TVSHOWS)
+      bNfo = GetEpisodeDetails(details, episode);
+    else
+      bNfo = GetDetails(details);
   }
 
   std::vector<ScraperPtr> vecScrapers = GetScrapers(m_type, m_info);
@@ -142,6 +126,67 @@ int CNfoFile::Load(const std::string& strFile)
   return 1;
 }
 
+bool CNfoFile::GetEpisodeDetails(CVideoInfoTag& details, int episode)
+{
+  m_headPos = 0;
+  if (!GetDetails(details))
+    return false;
+  if (details.m_iEpisode == episode)
+    return true;
+
+  // look the episode up in multi-episode nfo's without loading all of them
+  unsigned int entries = 0;
+  const size_t headPos = FindEpisodeDetails(episode, entries);
+  if (headPos != std::string::npos)
+  {
+    m_headPos = headPos;
+    details.Reset();
+    return GetDetails(details);
+  }
+
+  // still allow differing nfo/file numbers for single ep nfo's
+  if (entries <= 1)
+    return true;
+
+  details.Reset();
+  return false;
+}
+
+std::string CNfoFile::GetDetailsData() const
+{
+  // only pass the element at m_headPos on, following entries of multi-episode nfo's would be
+  // parsed as well otherwise
+  CXmlPullParser parser(m_doc.c_str() + m_headPos, m_doc.size() - m_headPos);
+  if (parser.NextChildElement(0) && parser.SkipElement())
+    return m_doc.substr(m_headPos, parser.GetEndOffset());
+
+  return m_doc.substr(m_headPos);
+}
+
+size_t CNfoFile::FindEpisodeDetails(int episode, unsigned int& entries) const
+{
+  entries = 0;
+
+  CXmlPullParser parser(m_doc);
+  while (parser.NextChildElement(0))
+  {
+    if (parser.GetName() != "episodedetails")
+      continue;
+
+    entries++;
+    const size_t offset = parser.GetOffset();
+    std::string value;
+    while (parser.NextChildElement(1))
+    {
+      if (parser.GetName() == "episode" && parser.ReadElementText(value) &&
+          atoi(value.c_str()) == episode)
+        return offset;
+    }
+  }
+
+  return std::string::npos;
+}
+
 void CNfoFile::Close()
 {
   m_doc.clear();
@@ -18,6 +18,8 @@
 #include <string>
 #include <utility>
 
+class CVideoInfoTag;
+
 class CNfoFile
 {
 public:
@@ -33,13 +35,23 @@ public:
     if (document)
       doc.Parse(document, TIXML_ENCODING_UNKNOWN);
     else if (m_headPos < m_doc.size())
-      doc.Parse(m_doc.substr(m_headPos), TIXML_ENCODING_UNKNOWN);
+      doc.Parse(GetDetailsData(), TIXML_ENCODING_UNKNOWN);
     else
       return false;
 
     return details.Load(doc.RootElement(), true, prioritise);
   }
 
+  /*! \brief Get the details of an episode from a loaded nfo
+   Multi-episode nfo's are searched for the entry of the episode. The only entry of a single
+   episode nfo is used even if its episode number differs.
+   \param details [out] the details of the episode
+   \param episode the episode number looked for
+   \return true if details were found
+   */
+  bool GetEpisodeDetails(CVideoInfoTag& details, int episode);
+
+  int Load(const std::string&);
   void Close();
   void SetScraperInfo(ADDON::ScraperPtr info) { m_info = std::move(info); }
   ADDON::ScraperPtr GetScraperInfo() { return m_info; }
@@ -58,5 +70,6 @@ private:
   ADDON::TYPE m_type = ADDON::ADDON_UNKNOWN;
   CScraperUrl m_scurl;
 
-  int Load(const std::string&);
+  std::string GetDetailsData() const;
+  size_t FindEpisodeDetails(int episode, unsigned int& entries) const;
 };
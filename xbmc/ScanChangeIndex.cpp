@@ -0,0 +1,255 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ScanChangeIndex.h"
+
+#include "FileItem.h"
+#include "URL.h"
+#include "XBDateTime.h"
+#include "filesystem/File.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/URIUtils.h"
+#include "utils/Variant.h"
+#include "utils/XTimeUtils.h"
+#include "utils/auto_buffer.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+using namespace XFILE;
+
+namespace
+{
+constexpr int INDEX_VERSION = 1;
+
+/*!
+ \brief Convert a stat() modification time the way listings do for CFileItem::m_dateTime
+ */
+int64_t ToListingTime(time_t mtime)
+{
+  KODI::TIME::FileTime fileTime, localTime;
+  KODI::TIME::TimeTToFileTime(mtime, &fileTime);
+  KODI::TIME::FileTimeToLocalFileTime(&fileTime, &localTime);
+  time_t time;
+  CDateTime(localTime).GetAsTime(time);
+  return time;
+}
+} // unnamed namespace
+
+CScanChangeIndex::CScanChangeIndex(const std::string& file) : m_file(file)
+{
+}
+
+bool CScanChangeIndex::Load()
+{
+  m_folders.clear();
+  m_seen.clear();
+  m_changed = false;
+
+  XUTILS::auto_buffer buffer;
+  CFile file;
+  if (!CFile::Exists(m_file) || file.LoadFile(m_file, buffer) <= 0)
+    return false;
+
+  CVariant data;
+  if (!CJSONVariantParser::Parse(std::string(buffer.get(), buffer.size()), data) ||
+      data["version"].asInteger() != INDEX_VERSION)
+  {
+    CLog::Log(LOGWARNING, "CScanChangeIndex: Ignoring invalid index %s", m_file.c_str());
+    return false;
+  }
+
+  const CVariant& folders = data["folders"];
+  for (auto it = folders.begin_map(); it != folders.end_map(); ++it)
+  {
+    Folder& folder = m_folders[it->first];
+    folder.mtime = it->second["mtime"].asInteger();
+
+    const CVariant& entries = it->second["entries"];
+    folder.entries.reserve(entries.size());
+    for (auto entry = entries.begin_array(); entry != entries.end_array(); ++entry)
+    {
+      Entry e;
+      e.path = (*entry)[0].asString();
+      e.size = (*entry)[1].asInteger();
+      e.mtime = (*entry)[2].asInteger();
+      e.folder = (*entry)[3].asBoolean();
+      folder.entries.push_back(std::move(e));
+    }
+  }
+  return true;
+}
+
+bool CScanChangeIndex::Save()
+{
+  if (!m_changed)
+    return true;
+
+  CVariant folders(CVariant::VariantTypeObject);
+  for (const auto& folder : m_folders)
+  {
+    CVariant entries(CVariant::VariantTypeArray);
+    for (const auto& entry : folder.second.entries)
+    {
+      CVariant e(CVariant::VariantTypeArray);
+      e.push_back(entry.path);
+      e.push_back(entry.size);
+      e.push_back(entry.mtime);
+      e.push_back(entry.folder);
+      entries.push_back(std::move(e));
+    }
+
+    CVariant f(CVariant::VariantTypeObject);
+    f["mtime"] = folder.second.mtime;
+    f["entries"] = std::move(entries);
+    folders[folder.first] = std::move(f);
+  }
+
+  CVariant data(CVariant::VariantTypeObject);
+  data["version"] = INDEX_VERSION;
+  data["folders"] = std::move(folders);
+
+  std::string json;
+  CFile file;
+  if (!CJSONVariantWriter::Write(data, json, true) || !file.OpenForWrite(m_file, true) ||
+      file.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CScanChangeIndex: Unable to save index %s", m_file.c_str());
+    return false;
+  }
+
+  m_changed = false;
+  return true;
+}
+
+bool CScanChangeIndex::IsUnchanged(const std::string& directory, Folder& folder)
+{
+  auto it = m_folders.find(directory);
+  if (it == m_folders.end() || it->second.mtime == 0)
+    return false;
+
+  if (GetModificationTime(directory) != it->second.mtime)
+    return false;
+
+  // files edited in place, e.g. retagged, don't change the modification time of the folder
+  for (const auto& entry : it->second.entries)
+  {
+    if (!entry.folder && !IsUnchanged(entry))
+      return false;
+  }
+
+  m_seen.insert(directory);
+  folder = it->second;
+  return true;
+}
+
+bool CScanChangeIndex::IsUnchanged(const Entry& entry)
+{
+  struct __stat64 buffer;
+  return entry.mtime != 0 && CFile::Stat(entry.path, &buffer) == 0 &&
+         buffer.st_size == entry.size && ToListingTime(buffer.st_mtime) == entry.mtime;
+}
+
+CScanChangeIndex::Changes CScanChangeIndex::Update(const std::string& directory,
+                                                   const CFileItemList& items)
+{
+  Folder current = FromItems(items, GetModificationTime(directory));
+
+  Changes changes;
+  auto it = m_folders.find(directory);
+  if (it != m_folders.end())
+  {
+    changes = Diff(it->second, current);
+    it->second = std::move(current);
+  }
+  else
+  {
+    for (const auto& entry : current.entries)
+      changes.added.push_back(entry.path);
+    m_folders.insert(std::make_pair(directory, std::move(current)));
+  }
+
+  m_seen.insert(directory);
+  m_changed = true;
+  return changes;
+}
+
+void CScanChangeIndex::Prune(const std::string& path)
+{
+  for (auto it = m_folders.lower_bound(path);
+       it != m_folders.end() && URIUtils::PathHasParent(it->first, path);)
+  {
+    if (m_seen.find(it->first) == m_seen.end())
+    {
+      it = m_folders.erase(it);
+      m_changed = true;
+    }
+    else
+      ++it;
+  }
+}
+
+CScanChangeIndex::Changes CScanChangeIndex::Diff(const Folder& before, const Folder& after)
+{
+  // entries are kept sorted by path, so a single merge pass finds all changes
+  Changes changes;
+  auto b = before.entries.begin();
+  auto a = after.entries.begin();
+  while (b != before.entries.end() || a != after.entries.end())
+  {
+    if (a == after.entries.end() || (b != before.entries.end() && b->path < a->path))
+      changes.removed.push_back((b++)->path);
+    else if (b == before.entries.end() || a->path < b->path)
+      changes.added.push_back((a++)->path);
+    else
+    {
+      if (a->size != b->size || a->mtime != b->mtime || a->folder != b->folder)
+        changes.modified.push_back(a->path);
+      ++a;
+      ++b;
+    }
+  }
+  return changes;
+}
+
+CScanChangeIndex::Folder CScanChangeIndex::FromItems(const CFileItemList& items, int64_t mtime)
+{
+  Folder folder;
+  folder.mtime = mtime;
+  folder.entries.reserve(items.Size());
+  for (const auto& item : items)
+  {
+    if (item->IsParentFolder())
+      continue;
+
+    Entry entry;
+    entry.path = item->GetPath();
+    entry.size = item->m_dwSize;
+    entry.folder = item->m_bIsFolder;
+    if (item->m_dateTime.IsValid())
+    {
+      time_t time;
+      item->m_dateTime.GetAsTime(time);
+      entry.mtime = time;
+    }
+    folder.entries.push_back(std::move(entry));
+  }
+
+  std::sort(folder.entries.begin(), folder.entries.end(),
+            [](const Entry& lhs, const Entry& rhs) { return lhs.path < rhs.path; });
+  return folder;
+}
+
+int64_t CScanChangeIndex::GetModificationTime(const std::string& directory)
+{
+  struct __stat64 buffer;
+  if (CFile::Stat(directory, &buffer) == 0)
+    return buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
+  return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class CFileItemList;
+
+/*!
+ \brief Persistent per-folder index used by the library scanners to detect changes.
+
+ For every scanned folder the index keeps the folder's own modification time together
+ with the size and modification time of each entry. A later scan can then stat() the
+ folder and its files and, if none of them changed, reuse the stored entries (including
+ the subfolders to recurse into) instead of listing the folder again. When a folder did
+ change, the stored entries are diffed against the new listing so exactly the added,
+ removed and modified files are known.
+
+ Editing a file in place doesn't update the modification time of the folder on most
+ filesystems, so the files are stat()'ed as well. That is only cheaper than a listing on
+ some filesystems, which is why using the index to skip listings is opt-in.
+ */
+class CScanChangeIndex
+{
+public:
+  struct Entry
+  {
+    std::string path;
+    int64_t size = 0;
+    int64_t mtime = 0;
+    bool folder = false;
+  };
+
+  struct Folder
+  {
+    int64_t mtime = 0;
+    std::vector<Entry> entries;
+  };
+
+  struct Changes
+  {
+    std::vector<std::string> added;
+    std::vector<std::string> removed;
+    std::vector<std::string> modified;
+
+    bool Empty() const { return added.empty() && removed.empty() && modified.empty(); }
+  };
+
+  /*! \brief Create an index backed by the given file
+   \param file path of the file the index is loaded from and saved to
+   */
+  explicit CScanChangeIndex(const std::string& file);
+
+  bool Load();
+  bool Save();
+
+  /*! \brief Check whether a folder is unchanged since it was last recorded
+   Performs a stat() on the folder and its files and compares modification times and sizes
+   with the stored ones.
+   \param directory folder to check
+   \param folder [out] the stored entries if the folder is unchanged
+   \return true if the folder is known and unchanged, false otherwise
+   */
+  bool IsUnchanged(const std::string& directory, Folder& folder);
+
+  /*! \brief Record the current listing of a folder
+   \param directory folder that was listed
+   \param items the listing of the folder
+   \return the changes compared to the previously recorded listing
+   */
+  Changes Update(const std::string& directory, const CFileItemList& items);
+
+  /*! \brief Drop the folders below a path that weren't checked or updated since loading
+   To be called once a scan of the path completed, removes folders that were deleted or
+   are excluded from the scan now.
+   \param path the scanned path
+   */
+  void Prune(const std::string& path);
+
+  /*! \brief Compute the changes between two recorded listings
+   */
+  static Changes Diff(const Folder& before, const Folder& after);
+
+  /*! \brief Build a folder record from a listing
+   \param items the listing of the folder
+   \param mtime modification time of the folder itself
+   */
+  static Folder FromItems(const CFileItemList& items, int64_t mtime);
+
+private:
+  static int64_t GetModificationTime(const std::string& directory);
+  static bool IsUnchanged(const Entry& entry);
+
+  std::string m_file;
+  std::map<std::string, Folder> m_folders;
+  std::set<std::string> m_seen; //!< folders checked or updated since loading
+  bool m_changed = false;
+};
@@ -393,7 +393,7 @@ void CUtil::CleanString(const std::string& strFileName,
   CRegExp reTags(true, CRegExp::autoUtf8);
   CRegExp reYear(false, CRegExp::autoUtf8);
 
-  if (!reYear.RegComp(advancedSettings->m_videoCleanDateTimeRegExp))
+  if (!reYear.RegComp(advancedSettings->m_videoCleanDateTimeRegExp, CRegExp::StudyWithJitComp))
   {
     CLog::Log(LOGERROR, "%s: Invalid datetime clean RegExp:'%s'", __FUNCTION__, advancedSettings->m_videoCleanDateTimeRegExp.c_str());
   }
@@ -410,7 +410,7 @@ void CUtil::CleanString(const std::string& strFileName,
 
   for (const auto &regexp : regexps)
   {
-    if (!reTags.RegComp(regexp.c_str()))
+    if (!reTags.RegComp(regexp.c_str(), CRegExp::StudyWithJitComp))
     { // invalid regexp - complain in logs
       CLog::Log(LOGERROR, "%s: Invalid string clean RegExp:'%s'", __FUNCTION__, regexp.c_str());
       continue;
@@ -521,25 +521,16 @@ std::string CUtil::GetSplashPath()
   return CSpecialProtocol::TranslatePathConvertCase(*it);
 }
 
-bool CUtil::ExcludeFileOrFolder(const std::string& strFileOrFolder, const std::vector<std::string>& regexps)
+bool CUtil::ExcludeFileOrFolder(const std::string& strFileOrFolder, const CRegExpSet& regexps)
 {
   if (strFileOrFolder.empty())
     return false;
 
-  CRegExp regExExcludes(true, CRegExp::autoUtf8);  // case insensitive regex
-
-  for (const auto &regexp : regexps)
+  const int match = regexps.RegFind(strFileOrFolder);
+  if (match > -1)
   {
-    if (!regExExcludes.RegComp(regexp.c_str()))
-    { // invalid regexp - complain in logs
-      CLog::Log(LOGERROR, "%s: Invalid exclude RegExp:'%s'", __FUNCTION__, regexp.c_str());
-      continue;
-    }
-    if (regExExcludes.RegFind(strFileOrFolder) > -1)
-    {
-      CLog::LogF(LOGDEBUG, "File '{}' excluded. (Matches exclude rule RegExp: '{}')", CURL::GetRedacted(strFileOrFolder), regexp);
-      return true;
-    }
+    CLog::LogF(LOGDEBUG, "File '{}' excluded. (Matches exclude rule RegExp: '{}')", CURL::GetRedacted(strFileOrFolder), regexps.GetExpression(match));
+    return true;
   }
   return false;
 }
@@ -25,6 +25,7 @@
 #define LEGAL_FATX            2
 
 class CFileItemList;
+class CRegExpSet;
 class CURL;
 
 struct ExternalStreamInfo
@@ -50,7 +51,10 @@ public:
   static void RunShortcut(const char* szPath);
   static std::string GetHomePath(
       const std::string& strTarget = "KODI_HOME"); // default target is "KODI_HOME"
-  static bool ExcludeFileOrFolder(const std::string& strFileOrFolder, const std::vector<std::string>& regexps);
+  /*! \brief Check a path against an exclude list
+   \param regexps compiled exclude list, see the m_*RegExpSet members of CAdvancedSettings
+   */
+  static bool ExcludeFileOrFolder(const std::string& strFileOrFolder, const CRegExpSet& regexps);
   static void GetFileAndProtocol(const std::string& strURL, std::string& strDir);
   static int GetDVDIfoTitle(const std::string& strPathFile);
 
@@ -252,6 +252,7 @@ CActiveAE::CActiveAE() :
   m_dataPort("OutputDataPort", &m_inMsgEvent, &m_outMsgEvent),
   m_sink(&m_outMsgEvent)
 {
+  SetRole(ThreadRole::DECODER);
   m_sinkBuffers = NULL;
   m_silenceBuffers = NULL;
   m_encoderBuffers = NULL;
@@ -268,6 +268,11 @@ bool CActiveAEBufferPoolResample::ResampleBuffers(int64_t timestamp)
       else
         in = nullptr;
 
+      // skipped input is not the end of the stream, only flush the resampler when no more
+      // input follows
+      if (!in && (m_changeResampler || (m_drain && m_inputSamples.empty())))
+        m_resampler->Drain();
+
       int start = m_procSample->pkt->nb_samples *
                   m_procSample->pkt->bytes_per_sample *
                   m_procSample->pkt->config.channels /
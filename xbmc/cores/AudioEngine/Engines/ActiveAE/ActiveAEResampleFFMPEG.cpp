@@ -8,8 +8,11 @@
 
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "ActiveAEResampleFFMPEG.h"
+#include "cores/AudioEngine/Utils/AEPolyphaseResampler.h"
 #include "utils/log.h"
 
+#include <cmath>
+
 extern "C" {
 #include <libavutil/channel_layout.h>
 #include <libavutil/opt.h>
@@ -53,6 +56,27 @@ bool CActiveAEResampleFFMPEG::Init(SampleConfig dstConfig, SampleConfig srcConfi
   if (m_src_chan_layout == 0)
     m_src_chan_layout = av_get_default_channel_layout(m_src_channels);
 
+  // plain rate conversion (or drift compensation) of float data between common rates does
+  // not need swresample, use the polyphase engine with its shared filter banks for it
+  if (m_src_fmt == AV_SAMPLE_FMT_FLTP && m_dst_fmt == AV_SAMPLE_FMT_FLTP &&
+      m_src_chan_layout == m_dst_chan_layout && m_src_channels == m_dst_channels &&
+      m_src_channels > 0 && !remapLayout && (m_doesResample || force_resample) &&
+      quality != AE_QUALITY_REALLYHIGH && quality != AE_QUALITY_GPU &&
+      CAEPolyphaseResampler::SupportsRates(m_src_rate, m_dst_rate))
+  {
+    unsigned int taps = 32;
+    if (quality == AE_QUALITY_HIGH)
+      taps = 64;
+    else if (quality == AE_QUALITY_LOW)
+      taps = 16;
+
+    m_polyphase.reset(new CAEPolyphaseResampler(m_src_channels, m_src_rate, m_dst_rate, taps));
+    m_doesResample = true;
+    CLog::Log(LOGDEBUG, "CActiveAEResampleFFMPEG::Init - using polyphase resampler, %d -> %d Hz, %u taps",
+              m_src_rate, m_dst_rate, m_polyphase->GetTaps());
+    return true;
+  }
+
   m_pContext = swr_alloc_set_opts(NULL, m_dst_chan_layout, m_dst_fmt, m_dst_rate,
                                                         m_src_chan_layout, m_src_fmt, m_src_rate,
                                                         0, NULL);
@@ -171,6 +195,10 @@ bool CActiveAEResampleFFMPEG::Init(SampleConfig dstConfig, SampleConfig srcConfi
 
 int CActiveAEResampleFFMPEG::Resample(uint8_t **dst_buffer, int dst_samples, uint8_t **src_buffer, int src_samples, double ratio)
 {
+  if (m_polyphase)
+    return m_polyphase->Process(reinterpret_cast<float**>(dst_buffer), dst_samples,
+                                reinterpret_cast<const float* const*>(src_buffer), src_samples, ratio);
+
   int delta = 0;
   int distance = 0;
   if (ratio != 1.0)
@@ -250,13 +278,25 @@ int CActiveAEResampleFFMPEG::Resample(uint8_t **dst_buffer, int dst_samples, uin
   return ret;
 }
 
+void CActiveAEResampleFFMPEG::Drain()
+{
+  if (m_polyphase)
+    m_polyphase->Drain();
+}
+
 int64_t CActiveAEResampleFFMPEG::GetDelay(int64_t base)
 {
+  if (m_polyphase)
+    return static_cast<int64_t>(m_polyphase->GetBufferedInput() * base / m_src_rate);
+
   return swr_get_delay(m_pContext, base);
 }
 
 int CActiveAEResampleFFMPEG::GetBufferedSamples()
 {
+  if (m_polyphase)
+    return static_cast<int>(std::ceil(m_polyphase->GetBufferedInput() * m_dst_rate / m_src_rate));
+
   return av_rescale_rnd(swr_get_delay(m_pContext, m_src_rate),
                                     m_dst_rate, m_src_rate, AV_ROUND_UP);
 }
@@ -12,11 +12,14 @@
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Interfaces/AEResample.h"
 
+#include <memory>
+
 extern "C" {
 #include <libavutil/samplefmt.h>
 }
 
 struct SwrContext;
+class CAEPolyphaseResampler;
 
 namespace ActiveAE
 {
@@ -30,6 +33,7 @@ public:
   bool Init(SampleConfig dstConfig, SampleConfig srcConfig, bool upmix, bool normalize, double centerMix,
             CAEChannelInfo *remapLayout, AEQuality quality, bool force_resample) override;
   int Resample(uint8_t **dst_buffer, int dst_samples, uint8_t **src_buffer, int src_samples, double ratio) override;
+  void Drain() override;
   int64_t GetDelay(int64_t base) override;
   int GetBufferedSamples() override;
   bool WantsNewSamples(int samples) override { return GetBufferedSamples() <= samples * 2; }
@@ -47,6 +51,7 @@ protected:
   int m_src_bits, m_dst_bits;
   int m_src_dither_bits, m_dst_dither_bits;
   SwrContext *m_pContext;
+  std::unique_ptr<CAEPolyphaseResampler> m_polyphase; // fast path for plain rate conversion of float data
   double m_rematrix[AE_CH_MAX][AE_CH_MAX];
 };
 
@@ -41,8 +41,8 @@ void CActiveAESink::Start()
 {
   if (!IsRunning())
   {
+    SetRole(ThreadRole::AUDIO_SINK);
     Create();
-    SetPriority(THREAD_PRIORITY_ABOVE_NORMAL);
   }
 }
 
@@ -23,6 +23,8 @@ public:
   virtual bool Init(SampleConfig dstConfig, SampleConfig srcConfig, bool upmix, bool normalize, double centerMix,
                     CAEChannelInfo *remapLayout, AEQuality quality, bool force_resample) = 0;
   virtual int Resample(uint8_t **dst_buffer, int dst_samples, uint8_t **src_buffer, int src_samples, double ratio) = 0;
+  // the input has ended, following calls without input output all buffered samples
+  virtual void Drain() {}
   virtual int64_t GetDelay(int64_t base) = 0;
   virtual int GetBufferedSamples() = 0;
   virtual bool WantsNewSamples(int samples) = 0;
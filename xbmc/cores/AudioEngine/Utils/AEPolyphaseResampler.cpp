@@ -0,0 +1,228 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEPolyphaseResampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+constexpr unsigned int PHASES = 256;
+constexpr double KAISER_BETA = 8.6;
+
+double BesselI0(double x)
+{
+  double sum = 1.0;
+  double term = 1.0;
+  for (int k = 1; k < 32; ++k)
+  {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+    if (term < sum * 1e-12)
+      break;
+  }
+  return sum;
+}
+
+float DotProduct(const float* a, const float* b, unsigned int count)
+{
+  // count is a multiple of 4
+#if defined(HAVE_SSE) && defined(__SSE__)
+  __m128 sum = _mm_setzero_ps();
+  for (unsigned int i = 0; i < count; i += 4)
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  return _mm_cvtss_f32(sum);
+#elif defined(__ARM_NEON)
+  float32x4_t sum = vdupq_n_f32(0.0f);
+  for (unsigned int i = 0; i < count; i += 4)
+    sum = vmlaq_f32(sum, vld1q_f32(a + i), vld1q_f32(b + i));
+  float32x2_t pair = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+  return vget_lane_f32(vpadd_f32(pair, pair), 0);
+#else
+  float sum[4] = {};
+  for (unsigned int i = 0; i < count; i += 4)
+  {
+    sum[0] += a[i] * b[i];
+    sum[1] += a[i + 1] * b[i + 1];
+    sum[2] += a[i + 2] * b[i + 2];
+    sum[3] += a[i + 3] * b[i + 3];
+  }
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+#endif
+}
+
+} // unnamed namespace
+
+struct CAEPolyphaseResampler::FilterBank
+{
+  unsigned int taps;
+  std::vector<float> coeffs; // PHASES + 1 phases of taps coefficients each
+};
+
+CAEPolyphaseResampler::CAEPolyphaseResampler(unsigned int channels,
+                                             int srcRate,
+                                             int dstRate,
+                                             unsigned int taps)
+  : m_channels(channels), m_srcRate(srcRate), m_dstRate(dstRate)
+{
+  // the dot product works on blocks of 4
+  m_taps = std::max(8u, (taps + 3) & ~3u);
+
+  // keep the transition band within the passband of the lower rate
+  const double cutoff = std::min(1.0, static_cast<double>(dstRate) / srcRate) * (1.0 - 2.5 / m_taps);
+  m_bank = GetFilterBank(m_taps, cutoff);
+  m_coeffs.resize(m_taps);
+
+  // pre-fill history so the first output sample is centered on the first input sample
+  const unsigned int half = m_taps / 2;
+  m_history.assign(m_channels, std::vector<float>(half - 1, 0.0f));
+  m_position = half - 1;
+}
+
+bool CAEPolyphaseResampler::SupportsRates(int srcRate, int dstRate)
+{
+  auto isCommon = [](int rate) {
+    return rate == 44100 || rate == 48000 || rate == 88200 || rate == 96000;
+  };
+  if (!isCommon(srcRate) || !isCommon(dstRate))
+    return false;
+
+  return dstRate <= 2 * srcRate && srcRate <= 2 * dstRate;
+}
+
+std::shared_ptr<const CAEPolyphaseResampler::FilterBank> CAEPolyphaseResampler::GetFilterBank(
+    unsigned int taps, double cutoff)
+{
+  static std::mutex cacheLock;
+  static std::map<std::pair<unsigned int, int>, std::weak_ptr<const FilterBank>> cache;
+
+  const auto key = std::make_pair(taps, static_cast<int>(std::lround(cutoff * 1e6)));
+
+  std::unique_lock<std::mutex> lock(cacheLock);
+  auto it = cache.find(key);
+  if (it != cache.end())
+  {
+    if (auto bank = it->second.lock())
+      return bank;
+  }
+
+  auto bank = std::make_shared<FilterBank>();
+  bank->taps = taps;
+  bank->coeffs.resize((PHASES + 1) * taps);
+
+  const double half = taps / 2;
+  const double norm = BesselI0(KAISER_BETA);
+  for (unsigned int phase = 0; phase <= PHASES; ++phase)
+  {
+    float* h = &bank->coeffs[phase * taps];
+    const double frac = static_cast<double>(phase) / PHASES;
+    double sum = 0.0;
+    for (unsigned int k = 0; k < taps; ++k)
+    {
+      const double x = k - half + 1.0 - frac;
+      const double t = cutoff * x * M_PI;
+      const double sinc = t == 0.0 ? 1.0 : std::sin(t) / t;
+      const double r = x / half;
+      const double window = r * r < 1.0 ? BesselI0(KAISER_BETA * std::sqrt(1.0 - r * r)) / norm : 0.0;
+      const double value = cutoff * sinc * window;
+      h[k] = static_cast<float>(value);
+      sum += value;
+    }
+    // unity gain at DC for every phase
+    for (unsigned int k = 0; k < taps; ++k)
+      h[k] = static_cast<float>(h[k] / sum);
+  }
+
+  cache[key] = bank;
+  return bank;
+}
+
+int CAEPolyphaseResampler::Process(float** dst,
+                                   int dstSamples,
+                                   const float* const* src,
+                                   int srcSamples,
+                                   double ratio)
+{
+  const unsigned int half = m_taps / 2;
+
+  if (src && srcSamples > 0)
+  {
+    for (unsigned int ch = 0; ch < m_channels; ++ch)
+      m_history[ch].insert(m_history[ch].end(), src[ch], src[ch] + srcSamples);
+    m_drain = false;
+    m_flushed = false;
+  }
+  else if (m_drain && !m_flushed && GetBufferedInput() > 0.0)
+  {
+    // append silence so the remaining samples can be output
+    for (auto& history : m_history)
+      history.insert(history.end(), half, 0.0f);
+    m_flushed = true;
+  }
+
+  const double step = static_cast<double>(m_srcRate) / m_dstRate / ratio;
+  const std::size_t available = m_history[0].size();
+  const float* bank = m_bank->coeffs.data();
+
+  int produced = 0;
+  while (produced < dstSamples)
+  {
+    const std::size_t index = static_cast<std::size_t>(m_position);
+    if (index + half >= available)
+      break;
+
+    // interpolate the coefficients between the two closest phases
+    const double phase = (m_position - index) * PHASES;
+    const unsigned int phaseIndex = std::min(static_cast<unsigned int>(phase), PHASES - 1);
+    const float weight = static_cast<float>(phase - phaseIndex);
+    const float* h0 = bank + phaseIndex * m_taps;
+    const float* h1 = h0 + m_taps;
+    for (unsigned int k = 0; k < m_taps; ++k)
+      m_coeffs[k] = h0[k] + weight * (h1[k] - h0[k]);
+
+    const std::size_t start = index + 1 - half;
+    for (unsigned int ch = 0; ch < m_channels; ++ch)
+      dst[ch][produced] = DotProduct(m_history[ch].data() + start, m_coeffs.data(), m_taps);
+
+    ++produced;
+    m_position += step;
+  }
+
+  // drop input which is not needed for future output samples
+  const std::size_t needed = static_cast<std::size_t>(m_position) + 1 - half;
+  const std::size_t consumed = std::min(needed, available);
+  if (consumed > 0)
+  {
+    for (auto& history : m_history)
+      history.erase(history.begin(), history.begin() + consumed);
+    m_position -= consumed;
+  }
+
+  return produced;
+}
+
+double CAEPolyphaseResampler::GetBufferedInput() const
+{
+  double buffered = m_history[0].size() - m_position;
+  if (m_flushed)
+    buffered -= m_taps / 2;
+  return std::max(0.0, buffered);
+}
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+/**
+ * Windowed-sinc polyphase resampler for planar float audio.
+ *
+ * Filter banks only depend on the number of taps and the cutoff, they are shared between
+ * instances so that re-creating a resampler on stream changes does not recompute them.
+ * Arbitrary ratios, including drift compensation, are handled by interpolating between
+ * adjacent phases.
+ */
+class CAEPolyphaseResampler
+{
+public:
+  CAEPolyphaseResampler(unsigned int channels, int srcRate, int dstRate, unsigned int taps);
+
+  /**
+   * Check if the given rates are handled by this engine, callers are supposed to fall back
+   * to a generic resampler otherwise.
+   */
+  static bool SupportsRates(int srcRate, int dstRate);
+
+  /**
+   * Resample planar float data. Input which can't be consumed because dst is full is kept.
+   * @param dst one plane per channel with room for dstSamples samples
+   * @param src one plane per channel, nullptr if there is no new input
+   * @param ratio additional speed factor, values > 1.0 produce more output samples
+   * @return number of samples written per channel
+   */
+  int Process(float** dst, int dstSamples, const float* const* src, int srcSamples, double ratio);
+
+  /**
+   * Mark the end of the input. The next call without input pads the buffered samples with
+   * silence so they can be output, new input cancels the drain.
+   */
+  void Drain() { m_drain = true; }
+
+  /**
+   * @return number of input samples per channel which are buffered and not yet output
+   */
+  double GetBufferedInput() const;
+
+  unsigned int GetTaps() const { return m_taps; }
+
+private:
+  struct FilterBank;
+  static std::shared_ptr<const FilterBank> GetFilterBank(unsigned int taps, double cutoff);
+
+  unsigned int m_channels;
+  int m_srcRate;
+  int m_dstRate;
+  unsigned int m_taps;
+  std::shared_ptr<const FilterBank> m_bank;
+  std::vector<std::vector<float>> m_history;
+  std::vector<float> m_coeffs;
+  double m_position; // position of the next output sample in m_history
+  bool m_drain = false;
+  bool m_flushed = false;
+};
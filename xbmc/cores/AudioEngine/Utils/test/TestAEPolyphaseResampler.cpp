@@ -0,0 +1,149 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEPolyphaseResampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+constexpr int CHUNK = 1024;
+
+// feeds a sine in chunks and collects the output of the first channel. With emptyCalls the
+// resampler is called without input after every chunk until it has nothing left to output,
+// like the buffer pool does while its output is full.
+std::vector<float> ResampleSine(CAEPolyphaseResampler& resampler,
+                                unsigned int channels,
+                                int srcRate,
+                                int srcSamples,
+                                double ratio,
+                                double frequency,
+                                int dstSamples = 4 * CHUNK,
+                                bool emptyCalls = false)
+{
+  std::vector<std::vector<float>> in(channels, std::vector<float>(CHUNK));
+  std::vector<std::vector<float>> out(channels, std::vector<float>(dstSamples));
+  std::vector<const float*> src(channels);
+  std::vector<float*> dst(channels);
+  std::vector<float> result;
+
+  for (unsigned int ch = 0; ch < channels; ++ch)
+  {
+    src[ch] = in[ch].data();
+    dst[ch] = out[ch].data();
+  }
+
+  auto process = [&](const float* const* input, int count) {
+    const int produced = resampler.Process(dst.data(), dstSamples, input, count, ratio);
+    result.insert(result.end(), out[0].begin(), out[0].begin() + produced);
+    return produced;
+  };
+
+  for (int pos = 0; pos < srcSamples; pos += CHUNK)
+  {
+    const int count = std::min(CHUNK, srcSamples - pos);
+    for (unsigned int ch = 0; ch < channels; ++ch)
+    {
+      for (int i = 0; i < count; ++i)
+        in[ch][i] = static_cast<float>(std::sin(2.0 * M_PI * frequency * (pos + i) / srcRate));
+    }
+
+    if (process(src.data(), count) > 0 && emptyCalls)
+    {
+      while (process(nullptr, 0) > 0)
+        ;
+    }
+  }
+
+  // flush the resampler
+  resampler.Drain();
+  while (process(nullptr, 0) > 0)
+    ;
+
+  return result;
+}
+
+} // namespace
+
+TEST(TestAEPolyphaseResampler, SupportsRates)
+{
+  EXPECT_TRUE(CAEPolyphaseResampler::SupportsRates(44100, 48000));
+  EXPECT_TRUE(CAEPolyphaseResampler::SupportsRates(96000, 48000));
+  EXPECT_TRUE(CAEPolyphaseResampler::SupportsRates(48000, 48000));
+  EXPECT_FALSE(CAEPolyphaseResampler::SupportsRates(44100, 96000));
+  EXPECT_FALSE(CAEPolyphaseResampler::SupportsRates(22050, 48000));
+}
+
+TEST(TestAEPolyphaseResampler, OutputLength)
+{
+  CAEPolyphaseResampler resampler(2, 48000, 44100, 32);
+  std::vector<float> out = ResampleSine(resampler, 2, 48000, 48000, 1.0, 1000.0);
+  EXPECT_NEAR(44100.0, out.size(), 2.0);
+  EXPECT_EQ(0.0, resampler.GetBufferedInput());
+}
+
+TEST(TestAEPolyphaseResampler, Compensation)
+{
+  CAEPolyphaseResampler resampler(2, 48000, 48000, 32);
+  std::vector<float> out = ResampleSine(resampler, 2, 48000, 48000, 1.001, 1000.0);
+  EXPECT_NEAR(48048.0, out.size(), 2.0);
+}
+
+TEST(TestAEPolyphaseResampler, PreservesSine)
+{
+  const double frequency = 1000.0;
+  CAEPolyphaseResampler resampler(1, 44100, 48000, 64);
+  std::vector<float> out = ResampleSine(resampler, 1, 44100, 44100, 1.0, frequency);
+  ASSERT_GT(out.size(), 47000u);
+
+  // the first output sample is centered on the first input sample, skip the edges
+  double maxError = 0.0;
+  for (std::size_t n = 100; n < 47000; ++n)
+  {
+    const double expected = std::sin(2.0 * M_PI * frequency * n / 48000);
+    maxError = std::max(maxError, std::abs(out[n] - expected));
+  }
+  EXPECT_LT(maxError, 1e-3);
+}
+
+TEST(TestAEPolyphaseResampler, CallsWithoutInput)
+{
+  // calls without input in the middle of the stream must not insert silence
+  CAEPolyphaseResampler reference(1, 44100, 48000, 32);
+  std::vector<float> expected = ResampleSine(reference, 1, 44100, 44100, 1.0, 1000.0);
+
+  CAEPolyphaseResampler resampler(1, 44100, 48000, 32);
+  std::vector<float> out = ResampleSine(resampler, 1, 44100, 44100, 1.0, 1000.0, 100, true);
+
+  ASSERT_EQ(expected.size(), out.size());
+  float maxDifference = 0.0f;
+  for (std::size_t n = 0; n < out.size(); ++n)
+    maxDifference = std::max(maxDifference, std::abs(out[n] - expected[n]));
+  EXPECT_LT(maxDifference, 1e-5f);
+}
+
+TEST(TestAEPolyphaseResampler, LongStream)
+{
+  // 10 seconds of stereo 44.1 -> 48 kHz at the highest quality, the phase must not drift
+  CAEPolyphaseResampler resampler(2, 44100, 48000, 64);
+  std::vector<float> out = ResampleSine(resampler, 2, 44100, 10 * 44100, 1.0, 1000.0);
+  ASSERT_NEAR(480000.0, out.size(), 2.0);
+
+  double maxError = 0.0;
+  for (std::size_t n = 470000; n < 479000; ++n)
+  {
+    const double expected = std::sin(2.0 * M_PI * 1000.0 * n / 48000);
+    maxError = std::max(maxError, std::abs(out[n] - expected));
+  }
+  EXPECT_LT(maxError, 1e-3);
+}
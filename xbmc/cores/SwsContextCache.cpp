@@ -0,0 +1,113 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SwsContextCache.h"
+
+#include "utils/log.h"
+
+namespace
+{
+// a thread rarely alternates between more shapes than this
+constexpr size_t MAX_CONTEXTS = 4;
+} // namespace
+
+CSwsContextCache::~CSwsContextCache()
+{
+  for (SEntry& entry : m_entries)
+    sws_freeContext(entry.context);
+}
+
+SwsContext* CSwsContextCache::Get(int srcWidth, int srcHeight, AVPixelFormat srcFormat,
+                                  int dstWidth, int dstHeight, AVPixelFormat dstFormat,
+                                  int flags, int srcRange, int dstRange)
+{
+  return GetThreadCache().GetContext({srcWidth, srcHeight, srcFormat, dstWidth, dstHeight,
+                                      dstFormat, flags, srcRange, dstRange, nullptr});
+}
+
+void CSwsContextCache::Clear()
+{
+  std::vector<SEntry>& entries = GetThreadCache().m_entries;
+  for (SEntry& entry : entries)
+    sws_freeContext(entry.context);
+  entries.clear();
+}
+
+CSwsContextCache& CSwsContextCache::GetThreadCache()
+{
+  static thread_local CSwsContextCache cache;
+  return cache;
+}
+
+bool CSwsContextCache::SEntry::Matches(const SEntry& other) const
+{
+  return srcWidth == other.srcWidth && srcHeight == other.srcHeight &&
+         srcFormat == other.srcFormat && dstWidth == other.dstWidth &&
+         dstHeight == other.dstHeight && dstFormat == other.dstFormat && flags == other.flags &&
+         srcRange == other.srcRange && dstRange == other.dstRange;
+}
+
+SwsContext* CSwsContextCache::GetContext(const SEntry& params)
+{
+  for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+  {
+    if (it->Matches(params))
+    {
+      SEntry entry = *it;
+      m_entries.erase(it);
+      m_entries.insert(m_entries.begin(), entry);
+      return entry.context;
+    }
+  }
+
+  SEntry entry = params;
+  entry.context = CreateContext(params);
+  if (!entry.context)
+    return nullptr;
+
+  if (m_entries.size() >= MAX_CONTEXTS)
+  {
+    sws_freeContext(m_entries.back().context);
+    m_entries.pop_back();
+  }
+  m_entries.insert(m_entries.begin(), entry);
+  return entry.context;
+}
+
+SwsContext* CSwsContextCache::CreateContext(const SEntry& params)
+{
+  SwsContext* context = sws_getContext(params.srcWidth, params.srcHeight, params.srcFormat,
+                                       params.dstWidth, params.dstHeight, params.dstFormat,
+                                       params.flags, nullptr, nullptr, nullptr);
+  if (!context)
+  {
+    CLog::Log(LOGERROR, "CSwsContextCache::{} - unable to create context for {}x{} -> {}x{}",
+              __FUNCTION__, params.srcWidth, params.srcHeight, params.dstWidth, params.dstHeight);
+    return nullptr;
+  }
+
+  if (params.srcRange >= 0 || params.dstRange >= 0)
+  {
+    int* invTable = nullptr;
+    int* table = nullptr;
+    int srcRange, dstRange, brightness, contrast, saturation;
+    if (sws_getColorspaceDetails(context, &invTable, &srcRange, &table, &dstRange, &brightness,
+                                 &contrast, &saturation) < 0 ||
+        sws_setColorspaceDetails(context, invTable,
+                                 params.srcRange >= 0 ? params.srcRange : srcRange, table,
+                                 params.dstRange >= 0 ? params.dstRange : dstRange, brightness,
+                                 contrast, saturation) < 0)
+    {
+      CLog::Log(LOGERROR, "CSwsContextCache::{} - unable to set colour range", __FUNCTION__);
+      sws_freeContext(context);
+      return nullptr;
+    }
+  }
+
+  return context;
+}
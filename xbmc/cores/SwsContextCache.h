@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <vector>
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+#include <libswscale/swscale.h>
+}
+
+/*!
+ \brief Per thread cache of swscale contexts.
+
+ Setting up a context (filters, colour conversion tables) costs more than
+ converting a thumbnail sized picture with it. Code converting many pictures
+ of the same shape, like texture caching, thumbnail extraction and
+ screenshots, gets its context from here instead of creating one per picture.
+ Contexts aren't thread safe, so each thread keeps its own few. They are freed when
+ the thread exits, long lived threads call Clear() once they are done converting.
+ */
+class CSwsContextCache
+{
+public:
+  ~CSwsContextCache();
+
+  /*!
+   \brief Get a context for the given conversion.
+   \param srcRange,dstRange 1 for full (jpeg) range, 0 for limited range, -1 for
+          the swscale default of the format
+   \return the context, owned by the cache and valid until the next call on this
+           thread, or nullptr on failure
+   */
+  static SwsContext* Get(int srcWidth, int srcHeight, AVPixelFormat srcFormat,
+                         int dstWidth, int dstHeight, AVPixelFormat dstFormat,
+                         int flags, int srcRange = -1, int dstRange = -1);
+
+  /*!
+   \brief Free the contexts cached for the calling thread.
+   */
+  static void Clear();
+
+private:
+  struct SEntry
+  {
+    int srcWidth;
+    int srcHeight;
+    AVPixelFormat srcFormat;
+    int dstWidth;
+    int dstHeight;
+    AVPixelFormat dstFormat;
+    int flags;
+    int srcRange;
+    int dstRange;
+    SwsContext* context;
+
+    bool Matches(const SEntry& other) const;
+  };
+
+  static CSwsContextCache& GetThreadCache();
+  SwsContext* GetContext(const SEntry& params);
+  static SwsContext* CreateContext(const SEntry& params);
+
+  std::vector<SEntry> m_entries; // most recently used first
+};
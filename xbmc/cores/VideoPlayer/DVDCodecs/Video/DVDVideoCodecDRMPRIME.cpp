@@ -17,6 +17,7 @@
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "threads/SingleLock.h"
+#include "utils/CPUBudget.h"
 #include "utils/CPUInfo.h"
 #include "utils/log.h"
 
@@ -84,6 +85,7 @@ CDVDVideoCodecDRMPRIME::~CDVDVideoCodecDRMPRIME()
 {
   av_frame_free(&m_pFrame);
   avcodec_free_context(&m_pCodecContext);
+  CCPUBudget::GetInstance().ReleaseDecoderThreads(m_decoderThreads);
 }
 
 CDVDVideoCodec* CDVDVideoCodecDRMPRIME::Create(CProcessInfo& processInfo)
@@ -314,7 +316,10 @@ bool CDVDVideoCodecDRMPRIME::Open(CDVDStreamInfo& hints, CDVDCodecOptions& optio
   m_pCodecContext->time_base.num = 1;
   m_pCodecContext->time_base.den = DVD_TIME_BASE;
   m_pCodecContext->thread_safe_callbacks = 1;
-  m_pCodecContext->thread_count = CServiceBroker::GetCPUInfo()->GetCPUCount();
+  CCPUBudget& budget = CCPUBudget::GetInstance();
+  budget.ReleaseDecoderThreads(m_decoderThreads);
+  m_decoderThreads = budget.AcquireDecoderThreads(CServiceBroker::GetCPUInfo()->GetCPUCount());
+  m_pCodecContext->thread_count = m_decoderThreads;
 
   if (hints.extradata && hints.extrasize > 0)
   {
@@ -43,5 +43,6 @@ protected:
   CDVDStreamInfo m_hints;
   AVCodecContext* m_pCodecContext = nullptr;
   AVFrame* m_pFrame = nullptr;
+  int m_decoderThreads = 0;
   std::shared_ptr<IVideoBufferPool> m_videoBufferPool;
 };
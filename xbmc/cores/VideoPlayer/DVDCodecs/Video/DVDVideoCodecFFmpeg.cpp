@@ -18,6 +18,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/CPUBudget.h"
 #include "utils/CPUInfo.h"
 #include "utils/StringUtils.h"
 #include "utils/XTimeUtils.h"
@@ -369,12 +370,14 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     }
     else
     {
-      int num_threads = CServiceBroker::GetCPUInfo()->GetCPUCount() * 3 / 2;
-      num_threads = std::max(1, std::min(num_threads, 16));
-      m_pCodecContext->thread_count = num_threads;
+      CCPUBudget& budget = CCPUBudget::GetInstance();
+      budget.ReleaseDecoderThreads(m_decoderThreads);
+      m_decoderThreads = budget.AcquireDecoderThreads(CCPUBudget::GetPreferredDecoderThreads());
+      m_pCodecContext->thread_count = m_decoderThreads;
       m_pCodecContext->thread_safe_callbacks = 1;
       m_decoderState = STATE_SW_MULTI;
-      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open frame threaded with %d threads", num_threads);
+      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open frame threaded with %d threads (%d of %d in use)",
+                m_decoderThreads, budget.GetDecoderThreadsInUse(), budget.GetDecoderThreadLimit());
     }
   }
   else
@@ -454,6 +457,8 @@ void CDVDVideoCodecFFmpeg::Dispose()
   av_frame_free(&m_pFilterFrame);
   avcodec_free_context(&m_pCodecContext);
   SAFE_RELEASE(m_pHardware);
+  CCPUBudget::GetInstance().ReleaseDecoderThreads(m_decoderThreads);
+  m_decoderThreads = 0;
 
   FilterClose();
 }
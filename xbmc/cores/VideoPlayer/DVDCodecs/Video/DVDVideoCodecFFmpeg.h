@@ -83,6 +83,7 @@ protected:
 
   std::string m_name;
   int m_decoderState;
+  int m_decoderThreads = 0; //!< threads leased from CCPUBudget
   IHardwareDecoder *m_pHardware = nullptr;
   int m_iLastKeyframe = 0;
   double m_dts = DVD_NOPTS_VALUE;
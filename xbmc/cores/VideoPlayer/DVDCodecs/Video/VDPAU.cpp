@@ -2811,6 +2811,7 @@ COutput::COutput(CDecoder &decoder, CEvent *inMsgEvent) :
   m_vdpau(decoder),
   m_mixer(&m_outMsgEvent)
 {
+  SetRole(ThreadRole::RENDER);
   m_inMsgEvent = inMsgEvent;
   m_bufferPool = std::make_shared<CVdpauBufferPool>(decoder);
 }
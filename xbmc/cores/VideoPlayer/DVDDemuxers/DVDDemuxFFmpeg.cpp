@@ -9,6 +9,7 @@
 #include "DVDDemuxFFmpeg.h"
 
 #include "DVDDemuxUtils.h"
+#include "DemuxKeyframeIndex.h"
 #include "DVDInputStreams/DVDInputStream.h"
 #include "DVDInputStreams/DVDInputStreamFFmpeg.h"
 #include "ServiceBroker.h"
@@ -661,6 +662,9 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     m_pFormatContext->duration = duration;
   }
 
+  if (!m_keyframeIndex)
+    OpenKeyframeIndex();
+
   return true;
 }
 
@@ -669,6 +673,13 @@ void CDVDDemuxFFmpeg::Dispose()
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
+  if (m_keyframeIndex)
+  {
+    m_keyframeIndex->Save();
+    m_keyframeIndex.reset();
+  }
+  m_keyframeIndexApplied = false;
+
   if (m_pFormatContext)
   {
     if (m_ioContext && m_pFormatContext->pb && m_pFormatContext->pb != m_ioContext)
@@ -1061,6 +1072,9 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
 
       AVStream* stream = m_pFormatContext->streams[m_pkt.pkt.stream_index];
 
+      if (m_keyframeIndex)
+        UpdateKeyframeIndex(m_pkt.pkt);
+
       if (IsTransportStreamReady())
       {
         if (m_program != UINT_MAX)
@@ -1261,6 +1275,9 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
   int ret;
   {
     CSingleLock lock(m_critSection);
+    if (m_keyframeIndex)
+      ApplyKeyframeIndex();
+
     ret = av_seek_frame(m_pFormatContext, m_seekStream, seek_pts, backwards ? AVSEEK_FLAG_BACKWARD : 0);
 
     if (ret < 0)
@@ -2217,6 +2234,75 @@ void CDVDDemuxFFmpeg::ParsePacket(AVPacket* pkt)
   }
 }
 
+void CDVDDemuxFFmpeg::OpenKeyframeIndex()
+{
+  // only for files in formats that have no or an unreliable index of their own. Matroska
+  // has cues, and entries added by position would corrupt its index of cluster positions.
+  if (!m_pFormatContext || !m_pFormatContext->iformat || !m_pInput ||
+      !m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) || m_pInput->IsRealtime())
+    return;
+
+  const char* name = m_pFormatContext->iformat->name;
+  if (strcmp(name, "mpegts") != 0 && strcmp(name, "avi") != 0 && strcmp(name, "mpeg") != 0)
+    return;
+
+  const int64_t length = m_pInput->GetLength();
+  if (length <= 0)
+    return;
+
+  m_keyframeIndex.reset(new CDemuxKeyframeIndex(m_pInput->GetFileName(), length));
+  m_keyframeIndex->Load();
+  m_keyframeIndexApplied = false;
+}
+
+int CDVDDemuxFFmpeg::GetKeyframeIndexStream() const
+{
+  // the stream av_seek_frame is going to use
+  if (m_seekStream >= 0)
+    return m_seekStream;
+  return av_find_default_stream_index(m_pFormatContext);
+}
+
+void CDVDDemuxFFmpeg::ApplyKeyframeIndex()
+{
+  const int streamIdx = GetKeyframeIndexStream();
+  if (streamIdx < 0 || streamIdx >= static_cast<int>(m_pFormatContext->nb_streams))
+    return;
+
+  if (m_keyframeIndexApplied && streamIdx == m_keyframeIndex->GetStream())
+    return;
+
+  AVStream* st = m_pFormatContext->streams[streamIdx];
+  if (m_keyframeIndex->SetStream(streamIdx, st->time_base.num, st->time_base.den))
+  {
+    // known keyframes bound the binary search of av_seek_frame to a small byte range
+    for (const auto& entry : m_keyframeIndex->GetEntries())
+      av_add_index_entry(st, entry.second, entry.first, 0, 0, AVINDEX_KEYFRAME);
+
+    CLog::Log(LOGDEBUG, "CDVDDemuxFFmpeg::%s - added %zu keyframes to the index of stream %d",
+              __FUNCTION__, m_keyframeIndex->GetEntries().size(), streamIdx);
+  }
+  m_keyframeIndexApplied = true;
+}
+
+void CDVDDemuxFFmpeg::UpdateKeyframeIndex(const AVPacket& pkt)
+{
+  if (!(pkt.flags & AV_PKT_FLAG_KEY) || pkt.pos < 0)
+    return;
+
+  ApplyKeyframeIndex();
+  if (pkt.stream_index != m_keyframeIndex->GetStream())
+    return;
+
+  const int64_t timestamp = pkt.dts != AV_NOPTS_VALUE ? pkt.dts : pkt.pts;
+  if (timestamp == AV_NOPTS_VALUE)
+    return;
+
+  if (m_keyframeIndex->Add(timestamp, pkt.pos))
+    av_add_index_entry(m_pFormatContext->streams[pkt.stream_index], pkt.pos, timestamp, pkt.size,
+                       0, AVINDEX_KEYFRAME);
+}
+
 TRANSPORT_STREAM_STATE CDVDDemuxFFmpeg::TransportStreamAudioState()
 {
   AVStream* st = nullptr;
@@ -19,6 +19,7 @@ extern "C" {
 #include <libavformat/avformat.h>
 }
 
+class CDemuxKeyframeIndex;
 class CDVDDemuxFFmpeg;
 class CURL;
 
@@ -133,6 +134,10 @@ protected:
   void UpdateCurrentPTS();
   bool IsProgramChange();
   unsigned int HLSSelectProgram();
+  void OpenKeyframeIndex();
+  int GetKeyframeIndexStream() const;
+  void ApplyKeyframeIndex();
+  void UpdateKeyframeIndex(const AVPacket& pkt);
 
   std::string GetStereoModeFromMetadata(AVDictionary* pMetadata);
   std::string ConvertCodecToInternalStereoMode(const std::string& mode, const StereoModeConversionMap* conversionMap);
@@ -175,5 +180,8 @@ protected:
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
   double m_startTime = 0;
+
+  std::unique_ptr<CDemuxKeyframeIndex> m_keyframeIndex;
+  bool m_keyframeIndexApplied = false;
 };
 
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxKeyframeIndex.h"
+
+#include "FileItem.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/auto_buffer.h"
+#include "utils/log.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace XFILE;
+
+namespace
+{
+const char* INDEX_FOLDER = "special://temp/keyframeindex/";
+const char INDEX_MAGIC[4] = {'K', 'F', 'I', '1'};
+// the least recently written indexes are removed above this size of the folder
+constexpr int64_t MAX_FOLDER_SIZE = 64 * 1024 * 1024;
+
+struct IndexHeader
+{
+  char magic[4];
+  int32_t stream;
+  int32_t timeBaseNum;
+  int32_t timeBaseDen;
+  uint32_t count;
+};
+
+struct IndexEntry
+{
+  int64_t timestamp;
+  int64_t pos;
+};
+} // unnamed namespace
+
+CDemuxKeyframeIndex::CDemuxKeyframeIndex(const std::string& path, int64_t size)
+{
+  const uint32_t crc = Crc32::Compute(path);
+  m_file = StringUtils::Format("%s%08x_%llx.kfi", INDEX_FOLDER, crc,
+                               static_cast<unsigned long long>(size));
+}
+
+bool CDemuxKeyframeIndex::Load()
+{
+  XUTILS::auto_buffer buffer;
+  CFile file;
+  if (!CFile::Exists(m_file))
+    return false;
+
+  const ssize_t read = file.LoadFile(m_file, buffer);
+  if (read < 0 || static_cast<size_t>(read) < sizeof(IndexHeader) ||
+      buffer.size() < sizeof(IndexHeader))
+    return false;
+
+  IndexHeader header;
+  memcpy(&header, buffer.get(), sizeof(header));
+  if (memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+      static_cast<uint64_t>(buffer.size() - sizeof(header)) !=
+          static_cast<uint64_t>(header.count) * sizeof(IndexEntry))
+  {
+    CLog::Log(LOGWARNING, "CDemuxKeyframeIndex: Ignoring invalid index %s", m_file.c_str());
+    return false;
+  }
+
+  m_stream = header.stream;
+  m_timeBaseNum = header.timeBaseNum;
+  m_timeBaseDen = header.timeBaseDen;
+
+  const char* data = buffer.get() + sizeof(header);
+  for (uint32_t i = 0; i < header.count; ++i, data += sizeof(IndexEntry))
+  {
+    IndexEntry entry;
+    memcpy(&entry, data, sizeof(entry));
+    m_entries.emplace_hint(m_entries.end(), entry.timestamp, entry.pos);
+  }
+  m_modified = false;
+
+  CLog::Log(LOGDEBUG, "CDemuxKeyframeIndex: Loaded %u keyframes from %s", header.count, m_file.c_str());
+  return true;
+}
+
+bool CDemuxKeyframeIndex::Save()
+{
+  if (!m_modified || m_entries.empty())
+    return true;
+
+  IndexHeader header;
+  memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+  header.stream = m_stream;
+  header.timeBaseNum = m_timeBaseNum;
+  header.timeBaseDen = m_timeBaseDen;
+  header.count = static_cast<uint32_t>(m_entries.size());
+
+  std::vector<char> data(sizeof(header) + m_entries.size() * sizeof(IndexEntry));
+  memcpy(data.data(), &header, sizeof(header));
+  char* out = data.data() + sizeof(header);
+  for (const auto& it : m_entries)
+  {
+    IndexEntry entry = {it.first, it.second};
+    memcpy(out, &entry, sizeof(entry));
+    out += sizeof(entry);
+  }
+
+  if (!CDirectory::Exists(INDEX_FOLDER))
+    CDirectory::Create(INDEX_FOLDER);
+  else if (!CFile::Exists(m_file))
+    Prune(data.size());
+
+  CFile file;
+  if (!file.OpenForWrite(m_file, true) ||
+      file.Write(data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+  {
+    CLog::Log(LOGERROR, "CDemuxKeyframeIndex: Unable to save index %s", m_file.c_str());
+    return false;
+  }
+
+  m_modified = false;
+  return true;
+}
+
+void CDemuxKeyframeIndex::Prune(size_t needed)
+{
+  CFileItemList items;
+  if (!CDirectory::GetDirectory(INDEX_FOLDER, items, ".kfi", DIR_FLAG_NO_FILE_DIRS))
+    return;
+
+  int64_t size = static_cast<int64_t>(needed);
+  for (const auto& item : items)
+    size += item->m_dwSize;
+  if (size <= MAX_FOLDER_SIZE)
+    return;
+
+  items.Sort(SortByDate, SortOrderAscending);
+  for (int i = 0; i < items.Size() && size > MAX_FOLDER_SIZE; ++i)
+  {
+    if (CFile::Delete(items[i]->GetPath()))
+      size -= items[i]->m_dwSize;
+  }
+  CLog::Log(LOGDEBUG, "CDemuxKeyframeIndex: Pruned %s to %lld bytes", INDEX_FOLDER,
+            static_cast<long long>(size));
+}
+
+bool CDemuxKeyframeIndex::SetStream(int stream, int timeBaseNum, int timeBaseDen)
+{
+  if (stream == m_stream && timeBaseNum == m_timeBaseNum && timeBaseDen == m_timeBaseDen)
+    return true;
+
+  m_stream = stream;
+  m_timeBaseNum = timeBaseNum;
+  m_timeBaseDen = timeBaseDen;
+  m_entries.clear();
+  return false;
+}
+
+bool CDemuxKeyframeIndex::Add(int64_t timestamp, int64_t pos)
+{
+  if (!m_entries.emplace(timestamp, pos).second)
+    return false;
+
+  m_modified = true;
+  return true;
+}
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <map>
+#include <stdint.h>
+#include <string>
+
+/*!
+ \brief Persistent keyframe index of a media file
+
+ Formats like MPEG-TS or AVI without an index force the demuxer to bisect the file on every
+ seek. The keyframes seen while demuxing are recorded here and stored in the temp folder,
+ keyed by path and size of the file, so later seeks - also in later playbacks - can be
+ narrowed down to the byte range between two known keyframes. The folder is kept below a
+ fixed size by removing the least recently written indexes.
+ */
+class CDemuxKeyframeIndex
+{
+public:
+  /*!
+   \param path path of the media file
+   \param size size of the media file in bytes
+   */
+  CDemuxKeyframeIndex(const std::string& path, int64_t size);
+
+  /*! \brief Load the stored index of the file
+   \return true if an index was found
+   */
+  bool Load();
+
+  /*! \brief Store the index if keyframes have been added since it was loaded
+   */
+  bool Save();
+
+  /*! \brief Set the stream the index applies to
+   Keyframes recorded for another stream or time base are dropped.
+   \return true if the existing keyframes apply to the stream
+   */
+  bool SetStream(int stream, int timeBaseNum, int timeBaseDen);
+  int GetStream() const { return m_stream; }
+
+  /*! \brief Record a keyframe
+   \param timestamp decode timestamp in the time base of the stream
+   \param pos byte position of the packet in the file
+   \return true if the keyframe wasn't known yet
+   */
+  bool Add(int64_t timestamp, int64_t pos);
+
+  /*! \brief Keyframe byte positions by timestamp */
+  const std::map<int64_t, int64_t>& GetEntries() const { return m_entries; }
+
+private:
+  /*! \brief Remove the least recently written indexes if the folder grows too large
+   \param needed size in bytes of the index about to be added
+   */
+  static void Prune(size_t needed);
+
+  std::string m_file;
+  int m_stream = -1;
+  int m_timeBaseNum = 0;
+  int m_timeBaseDen = 0;
+  std::map<int64_t, int64_t> m_entries;
+  bool m_modified = false;
+};
@@ -37,10 +37,12 @@
 #include <libswscale/swscale.h>
 #include "filesystem/File.h"
 #include "cores/FFmpeg.h"
+#include "cores/SwsContextCache.h"
 #include "TextureCache.h"
 #include "Util.h"
 #include "utils/LangCodeExpander.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 
@@ -86,48 +88,199 @@ int DegreeToOrientation(int degrees)
   }
 }
 
-bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
-                                CTextureDetails &details,
-                                CStreamDetails *pStreamDetails,
-                                int64_t pos)
+namespace
+{
+std::shared_ptr<CDVDInputStream> OpenInputStream(const CFileItem& item, const std::string& redactPath)
 {
-  const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
-  unsigned int nTime = XbmcThreads::SystemClockMillis();
-
-  CFileItem item(fileItem);
-  item.SetMimeTypeForInternetFile();
   auto pInputStream = CDVDFactoryInputStream::CreateInputStream(NULL, item);
   if (!pInputStream)
   {
     CLog::Log(LOGERROR, "InputStream: Error creating stream for %s", redactPath.c_str());
-    return false;
+    return nullptr;
   }
 
   if (!pInputStream->Open())
   {
     CLog::Log(LOGERROR, "InputStream: Error opening, %s", redactPath.c_str());
-    return false;
+    return nullptr;
   }
+  return pInputStream;
+}
 
+CDVDDemux* CreateDemuxer(const std::shared_ptr<CDVDInputStream>& pInputStream)
+{
   CDVDDemux *pDemuxer = NULL;
 
   try
   {
     pDemuxer = CDVDFactoryDemuxer::CreateDemuxer(pInputStream, true);
     if(!pDemuxer)
-    {
       CLog::Log(LOGERROR, "%s - Error creating demuxer", __FUNCTION__);
-      return false;
-    }
   }
   catch(...)
   {
     CLog::Log(LOGERROR, "%s - Exception thrown when opening demuxer", __FUNCTION__);
-    if (pDemuxer)
-      delete pDemuxer;
+    delete pDemuxer;
+    pDemuxer = NULL;
+  }
+  return pDemuxer;
+}
 
-    return false;
+/*!
+ \brief Select the main video stream and disable all others
+ \return the unique id of the video stream, -1 if there is none
+ */
+int SelectVideoStream(CDVDDemux* pDemuxer, int64_t& demuxerId)
+{
+  int nVideoStream = -1;
+  for (CDemuxStream* pStream : pDemuxer->GetStreams())
+  {
+    if (pStream)
+    {
+      // ignore if it's a picture attachment (e.g. jpeg artwork)
+      if (pStream->type == STREAM_VIDEO && !(pStream->flags & AV_DISPOSITION_ATTACHED_PIC))
+      {
+        nVideoStream = pStream->uniqueId;
+        demuxerId = pStream->demuxerId;
+      }
+      else
+        pDemuxer->EnableStream(pStream->demuxerId, pStream->uniqueId, false);
+    }
   }
+  return nVideoStream;
+}
+
+CDVDVideoCodec* CreateThumbCodec(const CDVDStreamInfo& hint, CProcessInfo& processInfo)
+{
+  std::vector<AVPixelFormat> pixFmts;
+  pixFmts.push_back(AV_PIX_FMT_YUV420P);
+  processInfo.SetPixFormats(pixFmts);
+
+  return CDVDFactoryCodec::CreateVideoCodec(hint, processInfo);
+}
+
+/*!
+ \brief Seek to the keyframe before a position and decode the first picture from there
+ */
+bool DecodeFrame(CDVDDemux* pDemuxer,
+                 CDVDVideoCodec* pVideoCodec,
+                 int nVideoStream,
+                 int64_t nSeekTo,
+                 VideoPicture& picture,
+                 int& packetsTried)
+{
+  if (!pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
+    return false;
+
+  CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
+
+  // num streams * 160 frames, should get a valid frame, if not abort.
+  int abort_index = pDemuxer->GetNrOfStreams() * 160;
+  do
+  {
+    DemuxPacket* pPacket = pDemuxer->Read();
+    packetsTried++;
+
+    if (!pPacket)
+      break;
+
+    if (pPacket->iStreamId != nVideoStream)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+      continue;
+    }
+
+    pVideoCodec->AddData(*pPacket);
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+
+    iDecoderState = CDVDVideoCodec::VC_NONE;
+    while (iDecoderState == CDVDVideoCodec::VC_NONE)
+    {
+      iDecoderState = pVideoCodec->GetPicture(&picture);
+    }
+
+    if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+    {
+      if(!(picture.iFlags & DVP_FLAG_DROPPED))
+        break;
+    }
+
+  } while (abort_index--);
+
+  return iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED);
+}
+
+/*!
+ \brief Scale a decoded picture to the thumbnail size and store it in the texture cache
+ */
+bool CacheFrame(const VideoPicture& picture,
+                const CDVDStreamInfo& hint,
+                CTextureDetails& details,
+                unsigned int maxWidth = 0)
+{
+  if (maxWidth == 0)
+    maxWidth = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes;
+  unsigned int nWidth = std::min(picture.iDisplayWidth, maxWidth);
+  double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+  if(hint.forced_aspect && hint.aspect != 0)
+    aspect = hint.aspect;
+  unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
+
+  SwsContext* context = CSwsContextCache::Get(picture.iWidth, picture.iHeight, AV_PIX_FMT_YUV420P,
+                                               nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR);
+  if (!context)
+    return false;
+
+  // We pass the buffers to sws_scale uses 16 aligned widths when using intrinsics
+  int sizeNeeded = FFALIGN(nWidth, 16) * nHeight * 4;
+  uint8_t *pOutBuf = static_cast<uint8_t*>(av_malloc(sizeNeeded));
+
+  uint8_t *planes[YuvImage::MAX_PLANES];
+  int stride[YuvImage::MAX_PLANES];
+  picture.videoBuffer->GetPlanes(planes);
+  picture.videoBuffer->GetStrides(stride);
+  uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
+  int srcStride[] = { stride[0], stride[1], stride[2], 0 };
+  uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
+  int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
+  int orientation = DegreeToOrientation(hint.orientation);
+  sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
+
+  details.width = nWidth;
+  details.height = nHeight;
+  CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
+  av_free(pOutBuf);
+  return true;
+}
+
+/*!
+ \brief Leave an empty file in the cache so extraction isn't retried for a failed thumb
+ */
+void CacheFailedThumb(const CTextureDetails& details)
+{
+  XFILE::CFile file;
+  if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
+    file.Close();
+}
+} // unnamed namespace
+
+bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
+                                CTextureDetails &details,
+                                CStreamDetails *pStreamDetails,
+                                int64_t pos)
+{
+  const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
+  unsigned int nTime = XbmcThreads::SystemClockMillis();
+
+  CFileItem item(fileItem);
+  item.SetMimeTypeForInternetFile();
+  auto pInputStream = OpenInputStream(item, redactPath);
+  if (!pInputStream)
+    return false;
+
+  CDVDDemux *pDemuxer = CreateDemuxer(pInputStream);
+  if (!pDemuxer)
+    return false;
 
   if (pStreamDetails)
   {
@@ -164,142 +317,110 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     }
   }
 
-  int nVideoStream = -1;
   int64_t demuxerId = -1;
-  for (CDemuxStream* pStream : pDemuxer->GetStreams())
-  {
-    if (pStream)
-    {
-      // ignore if it's a picture attachment (e.g. jpeg artwork)
-      if (pStream->type == STREAM_VIDEO && !(pStream->flags & AV_DISPOSITION_ATTACHED_PIC))
-      {
-        nVideoStream = pStream->uniqueId;
-        demuxerId = pStream->demuxerId;
-      }
-      else
-        pDemuxer->EnableStream(pStream->demuxerId, pStream->uniqueId, false);
-    }
-  }
+  int nVideoStream = SelectVideoStream(pDemuxer, demuxerId);
 
   bool bOk = false;
   int packetsTried = 0;
 
   if (nVideoStream != -1)
   {
-    CDVDVideoCodec *pVideoCodec;
     std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
-    std::vector<AVPixelFormat> pixFmts;
-    pixFmts.push_back(AV_PIX_FMT_YUV420P);
-    pProcessInfo->SetPixFormats(pixFmts);
-
     CDVDStreamInfo hint(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
     hint.codecOptions = CODEC_FORCE_SOFTWARE;
 
-    pVideoCodec = CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo);
-
+    CDVDVideoCodec *pVideoCodec = CreateThumbCodec(hint, *pProcessInfo);
     if (pVideoCodec)
     {
       int nTotalLen = pDemuxer->GetStreamLength();
       int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
 
       CLog::Log(LOGDEBUG, "%s - seeking to pos %lldms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
-      if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
-      {
-        CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
-        VideoPicture picture = {};
+      VideoPicture picture = {};
+      if (DecodeFrame(pDemuxer, pVideoCodec, nVideoStream, nSeekTo, picture, packetsTried))
+        bOk = CacheFrame(picture, hint, details);
+      else
+        CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
 
-        // num streams * 160 frames, should get a valid frame, if not abort.
-        int abort_index = pDemuxer->GetNrOfStreams() * 160;
-        do
-        {
-          DemuxPacket* pPacket = pDemuxer->Read();
-          packetsTried++;
+      picture.Reset();
+      delete pVideoCodec;
+    }
+  }
 
-          if (!pPacket)
-            break;
+  delete pDemuxer;
 
-          if (pPacket->iStreamId != nVideoStream)
-          {
-            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-            continue;
-          }
+  if(!bOk)
+    CacheFailedThumb(details);
 
-          pVideoCodec->AddData(*pPacket);
-          CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+  unsigned int nTotalTime = XbmcThreads::SystemClockMillis() - nTime;
+  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract thumb from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, redactPath.c_str(), packetsTried);
+  return bOk;
+}
 
-          iDecoderState = CDVDVideoCodec::VC_NONE;
-          while (iDecoderState == CDVDVideoCodec::VC_NONE)
-          {
-            iDecoderState = pVideoCodec->GetPicture(&picture);
-          }
+int CDVDFileInfo::ExtractThumbs(const CFileItem& fileItem,
+                                const std::vector<int64_t>& positions,
+                                std::vector<CTextureDetails>& details,
+                                const std::function<bool(unsigned int)>& progress,
+                                unsigned int maxWidth)
+{
+  const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
+  unsigned int nTime = XbmcThreads::SystemClockMillis();
 
-          if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
-          {
-            if(!(picture.iFlags & DVP_FLAG_DROPPED))
-              break;
-          }
+  if (details.size() != positions.size())
+    return 0;
 
-        } while (abort_index--);
+  CFileItem item(fileItem);
+  item.SetMimeTypeForInternetFile();
+  auto pInputStream = OpenInputStream(item, redactPath);
+  if (!pInputStream)
+    return 0;
 
-        if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
-        {
-          {
-            unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
-            double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-            if(hint.forced_aspect && hint.aspect != 0)
-              aspect = hint.aspect;
-            unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
-
-            // We pass the buffers to sws_scale uses 16 aligned widths when using intrinsics
-            int sizeNeeded = FFALIGN(nWidth, 16) * nHeight * 4;
-            uint8_t *pOutBuf = static_cast<uint8_t*>(av_malloc(sizeNeeded));
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
-            {
-              uint8_t *planes[YuvImage::MAX_PLANES];
-              int stride[YuvImage::MAX_PLANES];
-              picture.videoBuffer->GetPlanes(planes);
-              picture.videoBuffer->GetStrides(stride);
-              uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
-              int srcStride[] = { stride[0], stride[1], stride[2], 0 };
-              uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
-              int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
-
-              details.width = nWidth;
-              details.height = nHeight;
-              CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
-            }
-            av_free(pOutBuf);
-          }
-        }
-        else
-        {
-          CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
-        }
-      }
-      delete pVideoCodec;
-    }
-  }
+  std::unique_ptr<CDVDDemux> pDemuxer(CreateDemuxer(pInputStream));
+  if (!pDemuxer)
+    return 0;
 
-  if (pDemuxer)
-    delete pDemuxer;
+  int64_t demuxerId = -1;
+  int nVideoStream = SelectVideoStream(pDemuxer.get(), demuxerId);
+  if (nVideoStream == -1)
+    return 0;
 
-  if(!bOk)
+  std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
+  CDVDStreamInfo hint(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
+  hint.codecOptions = CODEC_FORCE_SOFTWARE;
+
+  // the decoder is kept open for all positions and only flushed between seeks
+  std::unique_ptr<CDVDVideoCodec> pVideoCodec(CreateThumbCodec(hint, *pProcessInfo));
+  if (!pVideoCodec)
+    return 0;
+
+  int extracted = 0;
+  int packetsTried = 0;
+  VideoPicture picture = {};
+  for (size_t i = 0; i < positions.size(); ++i)
   {
-    XFILE::CFile file;
-    if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
-      file.Close();
+    if (i > 0)
+      pVideoCodec->Reset();
+
+    bool bOk = false;
+    if (DecodeFrame(pDemuxer.get(), pVideoCodec.get(), nVideoStream, positions[i], picture, packetsTried))
+      bOk = CacheFrame(picture, hint, details[i], maxWidth);
+
+    if (bOk)
+      extracted++;
+    else
+    {
+      CLog::Log(LOGDEBUG, "%s - decode failed at pos %lldms in %s", __FUNCTION__, positions[i], redactPath.c_str());
+      CacheFailedThumb(details[i]);
+    }
+
+    if (progress && !progress(i + 1))
+      break;
   }
+  picture.Reset();
 
   unsigned int nTotalTime = XbmcThreads::SystemClockMillis() - nTime;
-  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract thumb from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, redactPath.c_str(), packetsTried);
-  return bOk;
+  CLog::Log(LOGDEBUG, "%s - measured %u ms to extract %d of %zu thumbs from file <%s> in %d packets", __FUNCTION__, nTotalTime, extracted, positions.size(), redactPath.c_str(), packetsTried);
+  return extracted;
 }
 
 /**
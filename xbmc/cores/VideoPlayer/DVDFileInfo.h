@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -28,6 +30,20 @@ public:
                            CStreamDetails *pStreamDetails,
                            int64_t pos);
 
+  /** \brief Extract thumbnail images at several positions of the media in a single pass.
+  *   Input stream, demuxer and decoder are opened once and reused for all positions.
+  *   \param positions positions in ms to extract the thumbnails from.
+  *   \param[in,out] details one entry per position, the cache file has to be set by the caller.
+  *   \param progress optional callback, called with the number of processed positions. Extraction stops if it returns false.
+  *   \param maxWidth maximum width of the thumbnails, 0 to use the configured image resolution.
+  *   \return the number of extracted thumbnails.
+  */
+  static int ExtractThumbs(const CFileItem& fileItem,
+                           const std::vector<int64_t>& positions,
+                           std::vector<CTextureDetails>& details,
+                           const std::function<bool(unsigned int)>& progress = nullptr,
+                           unsigned int maxWidth = 0);
+
   // Probe the files streams and store the info in the VideoInfoTag
   static bool GetFileStreamDetails(CFileItem *pItem);
   static bool DemuxerToStreamDetails(const std::shared_ptr<CDVDInputStream>& pInputStream,
@@ -8,17 +8,7 @@
 
 #include "DVDSubtitleLineCollection.h"
 
-#include <stddef.h>
-
-
-CDVDSubtitleLineCollection::CDVDSubtitleLineCollection()
-{
-  m_pHead = NULL;
-  m_pCurrent = NULL;
-  m_pTail = NULL;
-
-  m_iSize = 0;
-}
+#include <algorithm>
 
 CDVDSubtitleLineCollection::~CDVDSubtitleLineCollection()
 {
@@ -27,85 +17,61 @@ CDVDSubtitleLineCollection::~CDVDSubtitleLineCollection()
 
 void CDVDSubtitleLineCollection::Add(CDVDOverlay* pOverlay)
 {
-  ListElement* pElement = new ListElement;
-  pElement->pOverlay = pOverlay;
-  pElement->pNext = NULL;
-
-  if (!m_pHead)
-  {
-    m_pHead = m_pTail = pElement;
-    m_pCurrent = m_pHead;
-  }
-  else
-  {
-    m_pTail->pNext = pElement;
-    m_pTail = pElement;
-  }
+  double maxStopTime = pOverlay->iPTSStopTime;
+  if (!m_maxStopTime.empty())
+    maxStopTime = std::max(maxStopTime, m_maxStopTime.back());
 
-  m_iSize++;
+  m_overlays.push_back(pOverlay);
+  m_maxStopTime.push_back(maxStopTime);
 }
 
 void CDVDSubtitleLineCollection::Sort()
 {
-  if (!m_pHead || !m_pHead->pNext)
-    return;
+  std::stable_sort(m_overlays.begin(), m_overlays.end(),
+                   [](const CDVDOverlay* lhs, const CDVDOverlay* rhs) {
+                     return lhs->iPTSStartTime < rhs->iPTSStartTime;
+                   });
 
-  for (ListElement* p1 = m_pHead; p1->pNext != NULL; p1 = p1->pNext)
+  double maxStopTime = 0;
+  for (std::size_t i = 0; i < m_overlays.size(); i++)
   {
-    for (ListElement* p2 = p1->pNext; p2 != NULL; p2 = p2->pNext)
-    {
-      if (p1->pOverlay->iPTSStartTime > p2->pOverlay->iPTSStartTime)
-      {
-        CDVDOverlay* temp = p1->pOverlay;
-        p1->pOverlay = p2->pOverlay;
-        p2->pOverlay = temp;
-      }
-    }
+    maxStopTime = i ? std::max(maxStopTime, m_overlays[i]->iPTSStopTime)
+                    : m_overlays[i]->iPTSStopTime;
+    m_maxStopTime[i] = maxStopTime;
   }
 }
 
 CDVDOverlay* CDVDSubtitleLineCollection::Get(double iPts)
 {
-  CDVDOverlay* pOverlay = NULL;
-
-  if (m_pCurrent)
-  {
-    while (m_pCurrent && m_pCurrent->pOverlay->iPTSStopTime < iPts)
-    {
-      m_pCurrent = m_pCurrent->pNext;
-    }
-
-    if (m_pCurrent)
-    {
-      pOverlay = m_pCurrent->pOverlay;
-
-      // advance to the next overlay
-      m_pCurrent = m_pCurrent->pNext;
-    }
-  }
-  return pOverlay;
+  if (m_current >= m_overlays.size())
+    return nullptr;
+
+  // skip overlays that stopped before iPts. Everything before the first index whose
+  // running maximum reaches iPts has stopped, behind it an earlier long overlay can
+  // hide shorter ones that have stopped as well
+  auto it = std::lower_bound(m_maxStopTime.begin() + m_current, m_maxStopTime.end(), iPts);
+  m_current = it - m_maxStopTime.begin();
+  while (m_current < m_overlays.size() && m_overlays[m_current]->iPTSStopTime < iPts)
+    m_current++;
+
+  if (m_current >= m_overlays.size())
+    return nullptr;
+
+  // advance to the next overlay
+  return m_overlays[m_current++];
 }
 
 void CDVDSubtitleLineCollection::Reset()
 {
-  m_pCurrent = m_pHead;
+  m_current = 0;
 }
 
 void CDVDSubtitleLineCollection::Clear()
 {
-  ListElement* pElement = NULL;
-
-  while (m_pHead)
-  {
-    pElement = m_pHead;
-    m_pHead = pElement->pNext;
-
-    pElement->pOverlay->Release();
-    delete pElement;
-  }
+  for (CDVDOverlay* overlay : m_overlays)
+    overlay->Release();
 
-  m_pTail    = NULL;
-  m_pHead    = NULL;
-  m_pCurrent = NULL;
-  m_iSize    = 0;
+  m_overlays.clear();
+  m_maxStopTime.clear();
+  m_current = 0;
 }
@@ -10,22 +10,15 @@
 
 #include "../DVDCodecs/Overlay/DVDOverlay.h"
 
-typedef struct stListElement
-{
-  CDVDOverlay* pOverlay;
-  struct stListElement* pNext;
-
-} ListElement;
+#include <cstddef>
+#include <vector>
 
 class CDVDSubtitleLineCollection
 {
 public:
-  CDVDSubtitleLineCollection();
+  CDVDSubtitleLineCollection() = default;
   virtual ~CDVDSubtitleLineCollection();
 
-  //void Lock()   { EnterCriticalSection(&m_critSection); }
-  //void Unlock() { LeaveCriticalSection(&m_critSection); }
-
   void Add(CDVDOverlay* pSubtitle);
   void Sort();
 
@@ -33,16 +26,13 @@ public:
 
   void Reset();
 
-  void Remove();
   void Clear();
-  int GetSize() { return m_iSize; }
+  int GetSize() { return static_cast<int>(m_overlays.size()); }
 
 private:
-  ListElement* m_pHead;
-  ListElement* m_pCurrent;
-  ListElement* m_pTail;
-
-  int m_iSize;
-  //CRITICAL_SECTION m_critSection;
+  std::vector<CDVDOverlay*> m_overlays;
+  // running maximum of the stop times, stop times themselves aren't ordered
+  // but this lets Get() binary search for the first overlay still showing
+  std::vector<double> m_maxStopTime;
+  std::size_t m_current = 0;
 };
-
@@ -17,7 +17,9 @@
 #include "utils/Utf8Utils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
 #include <memory>
 
 
@@ -46,13 +48,21 @@ bool CDVDSubtitleStream::Open(const std::string& strFile)
 
     static const size_t chunksize = 64 * 1024;
 
+    // read the whole file in one go when its size is known
+    const int64_t length = pInputStream->GetLength();
+    if (length > 0 && static_cast<uint64_t>(length) > buf.size())
+      buf.resize(static_cast<size_t>(length));
+
     int read;
     do
     {
       if (totalread == buf.size())
         buf.resize(buf.size() + chunksize);
 
-      read = pInputStream->Read((uint8_t*)buf.get() + totalread, static_cast<int>(buf.size() - totalread));
+      // Read takes an int, so huge files are read in several steps
+      const size_t toRead = std::min(buf.size() - totalread,
+                                     static_cast<size_t>(std::numeric_limits<int>::max()));
+      read = pInputStream->Read((uint8_t*)buf.get() + totalread, static_cast<int>(toRead));
       if (read > 0)
         totalread += read;
     } while (read > 0);
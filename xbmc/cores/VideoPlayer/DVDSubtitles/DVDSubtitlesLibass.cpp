@@ -20,6 +20,10 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 namespace
 {
 std::string GetDefaultFontPath(std::string& font)
@@ -37,6 +41,23 @@ std::string GetDefaultFontPath(std::string& font)
   CLog::Log(LOGERROR, "CDVDSubtitlesLibass: Could not find font {} in font sources", font);
   return "";
 }
+
+// whether the event renders differently over its lifetime
+bool IsAnimated(const ASS_Event& event)
+{
+  if (event.Effect && event.Effect[0])
+    return true;
+  if (!event.Text)
+    return false;
+
+  // transforms, movement, fades and karaoke
+  for (const char* tag : {"\\t(", "\\move", "\\fad", "\\k", "\\K"})
+  {
+    if (strstr(event.Text, tag))
+      return true;
+  }
+  return false;
+}
 } // namespace
 
 static void libass_log(int level, const char *fmt, va_list args, void *data)
@@ -112,6 +133,7 @@ bool CDVDSubtitlesLibass::DecodeHeader(char* data, int size)
   }
 
   ass_process_codec_private(m_track, data, size);
+  InvalidateImage();
   return true;
 }
 
@@ -126,6 +148,7 @@ bool CDVDSubtitlesLibass::DecodeDemuxPkt(const char* data, int size, double star
 
   //! @bug libass isn't const correct
   ass_process_chunk(m_track, const_cast<char*>(data), size, DVD_TIME_TO_MSEC(start), DVD_TIME_TO_MSEC(duration));
+  InvalidateImage();
   return true;
 }
 
@@ -144,6 +167,8 @@ bool CDVDSubtitlesLibass::CreateTrack(char* buf, size_t size)
   if(m_track == NULL)
     return false;
 
+  InvalidateImage();
+
   return true;
 }
 
@@ -157,6 +182,19 @@ ASS_Image* CDVDSubtitlesLibass::RenderImage(int frameWidth, int frameHeight, int
     return NULL;
   }
 
+  // libass lays out every visible event on each call, skip that while the
+  // previous image can't have changed. It stays valid until the next call to
+  // ass_render_frame.
+  const long long now = DVD_TIME_TO_MSEC(pts);
+  const SRenderParams params{frameWidth, frameHeight, videoWidth, videoHeight,
+                             sourceWidth, sourceHeight, useMargin, position};
+  if (params == m_renderParams && now >= m_validFrom && now < m_validUntil)
+  {
+    if (changes)
+      *changes = 0;
+    return m_image;
+  }
+
   double sar = (double)sourceWidth / sourceHeight;
   double dar = (double)videoWidth / videoHeight;
   ass_set_frame_size(m_renderer, frameWidth, frameHeight);
@@ -166,7 +204,45 @@ ASS_Image* CDVDSubtitlesLibass::RenderImage(int frameWidth, int frameHeight, int
   ass_set_use_margins(m_renderer, useMargin);
   ass_set_line_position(m_renderer, position);
   ass_set_aspect_ratio(m_renderer, dar, sar);
-  return ass_render_frame(m_renderer, m_track, DVD_TIME_TO_MSEC(pts), changes);
+  m_image = ass_render_frame(m_renderer, m_track, now, changes);
+  m_renderParams = params;
+  UpdateValidInterval(now);
+  return m_image;
+}
+
+bool CDVDSubtitlesLibass::SRenderParams::operator==(const SRenderParams& other) const
+{
+  return frameWidth == other.frameWidth && frameHeight == other.frameHeight &&
+         videoWidth == other.videoWidth && videoHeight == other.videoHeight &&
+         sourceWidth == other.sourceWidth && sourceHeight == other.sourceHeight &&
+         useMargin == other.useMargin && position == other.position;
+}
+
+void CDVDSubtitlesLibass::UpdateValidInterval(long long now)
+{
+  // find the interval around now in which no event starts or ends
+  m_validFrom = std::numeric_limits<long long>::min();
+  m_validUntil = std::numeric_limits<long long>::max();
+
+  for (int i = 0; i < m_track->n_events; i++)
+  {
+    const ASS_Event& event = m_track->events[i];
+    const long long end = event.Start + event.Duration;
+    if (now < event.Start)
+      m_validUntil = std::min(m_validUntil, event.Start);
+    else if (now >= end)
+      m_validFrom = std::max(m_validFrom, end);
+    else if (IsAnimated(event))
+    {
+      InvalidateImage();
+      return;
+    }
+    else
+    {
+      m_validFrom = std::max(m_validFrom, event.Start);
+      m_validUntil = std::min(m_validUntil, end);
+    }
+  }
 }
 
 ASS_Event* CDVDSubtitlesLibass::GetEvents()
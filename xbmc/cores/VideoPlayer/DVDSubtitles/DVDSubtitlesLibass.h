@@ -32,9 +32,33 @@ public:
   bool CreateTrack(char* buf, size_t size);
 
 private:
+  struct SRenderParams
+  {
+    int frameWidth = 0;
+    int frameHeight = 0;
+    int videoWidth = 0;
+    int videoHeight = 0;
+    int sourceWidth = 0;
+    int sourceHeight = 0;
+    int useMargin = 0;
+    double position = 0.0;
+
+    bool operator==(const SRenderParams& other) const;
+  };
+
+  void UpdateValidInterval(long long now);
+  void InvalidateImage() { m_validUntil = m_validFrom; }
+
   ASS_Library* m_library = nullptr;
   ASS_Track* m_track = nullptr;
   ASS_Renderer* m_renderer = nullptr;
   CCriticalSection m_section;
+
+  // the last rendered image stays valid until the set of visible events changes,
+  // as long as none of the visible events is animated
+  SRenderParams m_renderParams;
+  ASS_Image* m_image = nullptr;
+  long long m_validFrom = 0;
+  long long m_validUntil = 0;
 };
 
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDSubtitles/DVDSubtitleLineCollection.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+CDVDOverlay* CreateOverlay(double start, double stop)
+{
+  CDVDOverlay* overlay = new CDVDOverlay(DVDOVERLAY_TYPE_TEXT);
+  overlay->iPTSStartTime = start;
+  overlay->iPTSStopTime = stop;
+  return overlay;
+}
+
+} // unnamed namespace
+
+TEST(TestDVDSubtitleLineCollection, Sorted)
+{
+  CDVDSubtitleLineCollection collection;
+  CDVDOverlay* a = CreateOverlay(30, 40);
+  CDVDOverlay* b = CreateOverlay(0, 10);
+  CDVDOverlay* c = CreateOverlay(10, 20);
+  collection.Add(a);
+  collection.Add(b);
+  collection.Add(c);
+  collection.Sort();
+
+  EXPECT_EQ(3, collection.GetSize());
+  EXPECT_EQ(c, collection.Get(15));
+  EXPECT_EQ(a, collection.Get(15));
+  EXPECT_EQ(nullptr, collection.Get(15));
+
+  collection.Reset();
+  EXPECT_EQ(b, collection.Get(0));
+  EXPECT_EQ(nullptr, collection.Get(50));
+}
+
+TEST(TestDVDSubtitleLineCollection, Overlapping)
+{
+  // a long overlay must not hide that the shorter ones behind it have stopped
+  CDVDSubtitleLineCollection collection;
+  CDVDOverlay* a = CreateOverlay(0, 100);
+  CDVDOverlay* b = CreateOverlay(10, 20);
+  CDVDOverlay* c = CreateOverlay(30, 40);
+  collection.Add(a);
+  collection.Add(b);
+  collection.Add(c);
+  collection.Sort();
+
+  EXPECT_EQ(a, collection.Get(35));
+  EXPECT_EQ(c, collection.Get(35));
+  EXPECT_EQ(nullptr, collection.Get(35));
+
+  collection.Reset();
+  EXPECT_EQ(a, collection.Get(15));
+  EXPECT_EQ(b, collection.Get(15));
+  EXPECT_EQ(c, collection.Get(15));
+}
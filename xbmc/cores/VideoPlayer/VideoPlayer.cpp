@@ -57,6 +57,8 @@
 #include "utils/Variant.h"
 #include "storage/MediaManager.h"
 #include "dialogs/GUIDialogKaiToast.h"
+#include "threads/Event.h"
+#include "utils/CPUBudget.h"
 #include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "video/Bookmark.h"
@@ -607,6 +609,7 @@ CVideoPlayer::CVideoPlayer(IPlayerCallback& callback)
       m_messenger("player"),
       m_renderManager(m_clock, this)
 {
+  SetRole(ThreadRole::DEMUX);
   m_outboundEvents.reset(new CJobQueue(false, 1, CJob::PRIORITY_NORMAL));
   m_players_created = false;
   m_pDemuxer = nullptr;
@@ -780,39 +783,79 @@ bool CVideoPlayer::OpenInputStream()
   // find any available external subtitles for non dvd files
   if (!m_pInputStream->IsStreamType(DVDSTREAM_TYPE_DVD) &&
       !m_pInputStream->IsStreamType(DVDSTREAM_TYPE_PVRMANAGER))
+    StartExternalSubtitleScan();
+
+  m_clock.Reset();
+  m_dvd.Clear();
+
+  return true;
+}
+
+struct CVideoPlayer::SExternalSubtitleScan
+{
+  std::string path;
+  std::vector<std::string> filenames;
+  std::atomic_flag claimed = ATOMIC_FLAG_INIT;
+  CEvent done{true};
+
+  void Run()
   {
-    // find any available external subtitles
-    std::vector<std::string> filenames;
-    CUtil::ScanForExternalSubtitles(m_item.GetDynPath(), filenames);
+    CUtil::ScanForExternalSubtitles(path, filenames);
+    done.Set();
+  }
+};
 
-    // load any subtitles from file item
-    std::string key("subtitle:1");
-    for (unsigned s = 1; m_item.HasProperty(key); key = StringUtils::Format("subtitle:%u", ++s))
-      filenames.push_back(m_item.GetProperty(key).asString());
+void CVideoPlayer::StartExternalSubtitleScan()
+{
+  auto scan = std::make_shared<SExternalSubtitleScan>();
+  scan->path = m_item.GetDynPath();
+  m_externalSubtitleScan = scan;
 
-    for (unsigned int i=0;i<filenames.size();i++)
+  CJobManager::GetInstance().Submit([scan]() {
+    if (!scan->claimed.test_and_set())
+      scan->Run();
+  }, CJob::PRIORITY_HIGH);
+}
+
+void CVideoPlayer::AddExternalSubtitles()
+{
+  if (!m_externalSubtitleScan)
+    return;
+
+  std::shared_ptr<SExternalSubtitleScan> scan = std::move(m_externalSubtitleScan);
+
+  // the job may still be queued behind others, in that case scan here instead of waiting
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  if (!scan->claimed.test_and_set())
+    scan->Run();
+  else
+    scan->done.Wait();
+  m_startupTiming.subtitleWait = XbmcThreads::SystemClockMillis() - start;
+
+  std::vector<std::string>& filenames = scan->filenames;
+
+  // load any subtitles from file item
+  std::string key("subtitle:1");
+  for (unsigned s = 1; m_item.HasProperty(key); key = StringUtils::Format("subtitle:%u", ++s))
+    filenames.push_back(m_item.GetProperty(key).asString());
+
+  for (unsigned int i=0;i<filenames.size();i++)
+  {
+    // if vobsub subtitle:
+    if (URIUtils::HasExtension(filenames[i], ".idx"))
     {
-      // if vobsub subtitle:
-      if (URIUtils::HasExtension(filenames[i], ".idx"))
+      std::string strSubFile;
+      if (CUtil::FindVobSubPair( filenames, filenames[i], strSubFile))
+        AddSubtitleFile(filenames[i], strSubFile);
+    }
+    else
+    {
+      if (!CUtil::IsVobSub(filenames, filenames[i] ))
       {
-        std::string strSubFile;
-        if (CUtil::FindVobSubPair( filenames, filenames[i], strSubFile))
-          AddSubtitleFile(filenames[i], strSubFile);
+        AddSubtitleFile(filenames[i]);
       }
-      else
-      {
-        if (!CUtil::IsVobSub(filenames, filenames[i] ))
-        {
-          AddSubtitleFile(filenames[i]);
-        }
-      }
-    } // end loop over all subtitle files
-  }
-
-  m_clock.Reset();
-  m_dvd.Clear();
-
-  return true;
+    }
+  } // end loop over all subtitle files
 }
 
 bool CVideoPlayer::OpenDemuxStream()
@@ -858,6 +901,8 @@ bool CVideoPlayer::OpenDemuxStream()
 
   m_offset_pts = 0;
 
+  AddExternalSubtitles();
+
   return true;
 }
 
@@ -1206,12 +1251,16 @@ void CVideoPlayer::Prepare()
     cb->RequestVideoSettings(fileItem);
   });
 
+  m_startupTiming = SStartupTiming();
+  m_startupTiming.start = XbmcThreads::SystemClockMillis();
+
   if (!OpenInputStream())
   {
     m_bAbortRequest = true;
     m_error = true;
     return;
   }
+  m_startupTiming.inputOpen = XbmcThreads::SystemClockMillis() - m_startupTiming.start;
 
   bool discStateRestored = false;
   if (std::shared_ptr<CDVDInputStream::IMenus> ptr = std::dynamic_pointer_cast<CDVDInputStream::IMenus>(m_pInputStream))
@@ -1226,17 +1275,23 @@ void CVideoPlayer::Prepare()
       nav->EnableSubtitleStream(m_processInfo->GetVideoSettings().m_SubtitleOn);
   }
 
+  unsigned int demuxStart = XbmcThreads::SystemClockMillis();
   if (!OpenDemuxStream())
   {
     m_bAbortRequest = true;
     m_error = true;
     return;
   }
+  m_startupTiming.demuxOpen = XbmcThreads::SystemClockMillis() - demuxStart -
+                              m_startupTiming.subtitleWait;
+
+  unsigned int streamStart = XbmcThreads::SystemClockMillis();
   // give players a chance to reconsider now codecs are known
   CreatePlayers();
 
   if (!discStateRestored)
     OpenDefaultStreams();
+  m_startupTiming.streamOpen = XbmcThreads::SystemClockMillis() - streamStart;
 
   /*
    * Check to see if the demuxer should start at something other than time 0. This will be the case
@@ -2971,6 +3026,16 @@ void CVideoPlayer::SetCaching(ECacheState state)
     m_cachingTimer.Set(5000);
   }
 
+  if ((state == CACHESTATE_PLAY || state == CACHESTATE_DONE) && m_startupTiming.start)
+  {
+    CLog::Log(LOGINFO,
+              "CVideoPlayer::SetCaching - startup took {} ms (input {} ms, demuxer {} ms, "
+              "subtitle scan wait {} ms, streams {} ms)",
+              XbmcThreads::SystemClockMillis() - m_startupTiming.start, m_startupTiming.inputOpen,
+              m_startupTiming.demuxOpen, m_startupTiming.subtitleWait, m_startupTiming.streamOpen);
+    m_startupTiming.start = 0;
+  }
+
   if (state == CACHESTATE_PLAY ||
      (state == CACHESTATE_DONE && m_caching != CACHESTATE_PLAY))
   {
@@ -3168,6 +3233,21 @@ void CVideoPlayer::GetGeneralInfo(std::string& strGeneralInfo)
         strBuf += StringUtils::Format(" %d msec", DVD_TIME_TO_MSEC(m_State.cache_delay));
     }
 
+    // cpu usage per player thread, the frame threads of software decoders are
+    // not accounted for here but show up as their share of the decoder budget
+    float videoUsage = 0;
+    float audioUsage = 0;
+    if (CThread* thread = dynamic_cast<CThread*>(m_VideoPlayerVideo))
+      videoUsage = thread->GetRelativeUsage();
+    if (CThread* thread = dynamic_cast<CThread*>(m_VideoPlayerAudio))
+      audioUsage = thread->GetRelativeUsage();
+
+    const CCPUBudget& budget = CCPUBudget::GetInstance();
+    strBuf += StringUtils::Format(" cpu: dmx:%.0f%% vid:%.0f%% aud:%.0f%% jobs:%.0f%% dec:%d/%d",
+                                  GetRelativeUsage() * 100, videoUsage * 100, audioUsage * 100,
+                                  CJobManager::GetInstance().GetWorkerUsage() * 100,
+                                  budget.GetDecoderThreadsInUse(), budget.GetDecoderThreadLimit());
+
     strGeneralInfo = StringUtils::Format("Player: a/v:% 6.3f, %s"
                                          , dDiff
                                          , strBuf.c_str());
@@ -382,6 +382,14 @@ protected:
   void ProcessRadioRDSData(CDemuxStream* pStream, DemuxPacket* pPacket);
 
   int  AddSubtitleFile(const std::string& filename, const std::string& subfilename = "");
+
+  /** \brief Starts scanning for external subtitles in the background so that the
+  *          directory listing overlaps with opening the demuxer.
+  */
+  void StartExternalSubtitleScan();
+  /** \brief Waits for a pending external subtitle scan and adds its results.
+  */
+  void AddExternalSubtitles();
   void SetSubtitleVisibleInternal(bool bVisible);
 
   /**
@@ -451,6 +459,19 @@ protected:
   ECacheState  m_caching;
   XbmcThreads::EndTime m_cachingTimer;
 
+  struct SExternalSubtitleScan;
+  std::shared_ptr<SExternalSubtitleScan> m_externalSubtitleScan;
+
+  // per phase durations (ms) of the current startup, logged once playback begins
+  struct SStartupTiming
+  {
+    unsigned int start = 0;
+    unsigned int inputOpen = 0;
+    unsigned int demuxOpen = 0;
+    unsigned int subtitleWait = 0;
+    unsigned int streamOpen = 0;
+  } m_startupTiming;
+
   std::unique_ptr<CProcessInfo> m_processInfo;
 
   CCurrentStream m_CurrentAudio;
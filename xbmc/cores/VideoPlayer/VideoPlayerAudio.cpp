@@ -52,6 +52,7 @@ CVideoPlayerAudio::CVideoPlayerAudio(CDVDClock* pClock, CDVDMessageQueue& parent
 , m_messageParent(parent)
 , m_audioSink(pClock)
 {
+  SetRole(ThreadRole::DECODER);
   m_pClock = pClock;
   m_pAudioCodec = NULL;
   m_audioClock = 0;
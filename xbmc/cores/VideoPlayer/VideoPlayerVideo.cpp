@@ -54,6 +54,7 @@ CVideoPlayerVideo::CVideoPlayerVideo(CDVDClock* pClock
 , m_messageParent(parent)
 , m_renderManager(renderManager)
 {
+  SetRole(ThreadRole::DECODER);
   m_pClock = pClock;
   m_pOverlayContainer = pOverlayContainer;
   m_pVideoCodec = NULL;
@@ -20,6 +20,7 @@
 
 CVideoReferenceClock::CVideoReferenceClock() : CThread("RefClock")
 {
+  SetRole(ThreadRole::RENDER);
   m_SystemFrequency = CurrentHostFrequency();
   m_ClockSpeed = 1.0;
   m_TotalMissedVblanks = 0;
@@ -13,11 +13,13 @@
 #include "FileItem.h"
 #include "ServiceBroker.h"
 #include "music/tags/MusicInfoTag.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <math.h>
 
 CAudioDecoder::CAudioDecoder()
@@ -36,6 +38,7 @@ CAudioDecoder::CAudioDecoder()
   memset(&m_inputBuffer, 0, INPUT_SAMPLES * sizeof(float));
 
   m_rawBufferSize = 0;
+  m_queuedSize = 0;
 }
 
 CAudioDecoder::~CAudioDecoder()
@@ -94,8 +97,12 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
     return false;
   }
 
-  /* allocate the pcmBuffer for 2 seconds of audio */
-  m_pcmBuffer.Create(2 * blockSize * m_codec->m_format.m_sampleRate);
+  /* playback starts once 2 seconds of audio are queued, the pcmBuffer may hold more than that
+   * so songs can be decoded ahead and ride out stalls of slow sources */
+  const unsigned int queueSize = 2 * blockSize * m_codec->m_format.m_sampleRate;
+  const unsigned int decodeAheadSize = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioDecodeAheadMemory * 1024 * 1024;
+  m_pcmBuffer.Create(std::max(queueSize, decodeAheadSize));
+  m_queuedSize = queueSize * 9 / 10;
 
   if (file.HasMusicInfoTag())
   {
@@ -259,7 +266,7 @@ int CAudioDecoder::ReadSamples(int numsamples)
         m_pcmBuffer.WriteData((char *)m_pcmInputBuffer, readSize);
 
         // update status
-        if (m_status == STATUS_QUEUING && m_pcmBuffer.getMaxReadSize() > m_pcmBuffer.getSize() * 0.9)
+        if (m_status == STATUS_QUEUING && m_pcmBuffer.getMaxReadSize() > m_queuedSize)
         {
           CLog::Log(LOGINFO, "AudioDecoder: File is queued");
           m_status = STATUS_QUEUED;
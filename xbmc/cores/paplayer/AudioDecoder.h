@@ -68,6 +68,7 @@ public:
 private:
   // pcm buffer
   CRingBuffer m_pcmBuffer;
+  unsigned int m_queuedSize; // fill level at which the file counts as queued
 
   // output buffer (for transferring data from the Pcm Buffer to the rest of the audio chain)
   float m_outputBuffer[OUTPUT_SAMPLES];
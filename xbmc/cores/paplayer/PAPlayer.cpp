@@ -22,6 +22,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/SystemClock.h"
 #include "utils/JobManager.h"
 #include "utils/log.h"
 #include "video/Bookmark.h"
@@ -51,6 +52,7 @@ PAPlayer::PAPlayer(IPlayerCallback& callback) :
   m_newForcedPlayerTime(-1),
   m_newForcedTotalTime (-1)
 {
+  SetRole(ThreadRole::DECODER);
   memset(&m_playerGUIData, 0, sizeof(m_playerGUIData));
   m_processInfo.reset(CProcessInfo::CreateInstance());
   m_processInfo->SetDataCache(&CServiceBroker::GetDataCacheCore());
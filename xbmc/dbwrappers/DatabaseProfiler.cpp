@@ -0,0 +1,193 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DatabaseProfiler.h"
+
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cctype>
+
+CDatabaseProfiler& CDatabaseProfiler::GetInstance()
+{
+  static CDatabaseProfiler profiler;
+  return profiler;
+}
+
+bool CDatabaseProfiler::Record(const std::string& sql,
+                               std::chrono::microseconds duration,
+                               uint64_t rows)
+{
+  const std::string fingerprint = Fingerprint(sql);
+
+  CSingleLock lock(m_section);
+  Entry& entry = m_entries[fingerprint];
+  if (entry.samples.size() < SAMPLES)
+    entry.samples.push_back(duration);
+  else
+    entry.samples[entry.count % SAMPLES] = duration;
+  entry.count++;
+  entry.rows += rows;
+  entry.total += duration;
+  entry.max = std::max(entry.max, duration);
+
+  const std::chrono::milliseconds threshold = m_explainThreshold;
+  if (threshold.count() > 0 && duration >= threshold && !entry.planRequested)
+  {
+    entry.planRequested = true;
+    return true;
+  }
+  return false;
+}
+
+void CDatabaseProfiler::SetPlan(const std::string& sql, const std::string& plan)
+{
+  const std::string fingerprint = Fingerprint(sql);
+
+  CSingleLock lock(m_section);
+  auto it = m_entries.find(fingerprint);
+  if (it != m_entries.end())
+    it->second.plan = plan;
+}
+
+std::vector<CDatabaseProfiler::Statistics> CDatabaseProfiler::GetStatistics() const
+{
+  std::vector<Statistics> statistics;
+
+  CSingleLock lock(m_section);
+  statistics.reserve(m_entries.size());
+  for (const auto& it : m_entries)
+  {
+    Statistics stats;
+    stats.fingerprint = it.first;
+    stats.count = it.second.count;
+    stats.rows = it.second.rows;
+    stats.total = it.second.total;
+    stats.max = it.second.max;
+    stats.p99 = Percentile(it.second.samples, 0.99);
+    stats.plan = it.second.plan;
+    statistics.push_back(std::move(stats));
+  }
+  lock.Leave();
+
+  std::sort(statistics.begin(), statistics.end(),
+            [](const Statistics& lhs, const Statistics& rhs) { return lhs.total > rhs.total; });
+  return statistics;
+}
+
+void CDatabaseProfiler::Reset()
+{
+  CSingleLock lock(m_section);
+  m_entries.clear();
+}
+
+void CDatabaseProfiler::LogSummary(size_t maxEntries /* = 20 */) const
+{
+  const std::vector<Statistics> statistics = GetStatistics();
+  if (statistics.empty())
+    return;
+
+  CLog::Log(LOGINFO, "CDatabaseProfiler: {} distinct statements, top {} by total time:",
+            statistics.size(), std::min(maxEntries, statistics.size()));
+  for (size_t i = 0; i < statistics.size() && i < maxEntries; ++i)
+  {
+    const Statistics& stats = statistics[i];
+    CLog::Log(LOGINFO,
+              "CDatabaseProfiler:   {} calls, total {} ms, avg {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms, "
+              "{} rows: {}",
+              stats.count, stats.total.count() / 1000, stats.total.count() / 1000.0 / stats.count,
+              stats.p99.count() / 1000.0, stats.max.count() / 1000.0, stats.rows,
+              stats.fingerprint);
+    if (!stats.plan.empty())
+      CLog::Log(LOGINFO, "CDatabaseProfiler:     plan: {}", stats.plan);
+  }
+}
+
+std::string CDatabaseProfiler::Fingerprint(const std::string& sql)
+{
+  std::string fingerprint;
+  fingerprint.reserve(sql.size());
+
+  const size_t length = sql.size();
+  size_t i = 0;
+  while (i < length)
+  {
+    const char c = sql[i];
+    if (c == '\'' || c == '"')
+    { // quoted string, doubled quotes are escaped quotes
+      ++i;
+      while (i < length)
+      {
+        if (sql[i] == c)
+        {
+          if (i + 1 < length && sql[i + 1] == c)
+            i += 2;
+          else
+            break;
+        }
+        else if (sql[i] == '\\' && i + 1 < length)
+          i += 2;
+        else
+          ++i;
+      }
+      ++i;
+      fingerprint += '?';
+    }
+    else if (isdigit(static_cast<unsigned char>(c)) &&
+             (fingerprint.empty() ||
+              !(isalnum(static_cast<unsigned char>(fingerprint.back())) || fingerprint.back() == '_')))
+    { // numeric literal, but not the digits of an identifier such as c09
+      while (i < length && (isalnum(static_cast<unsigned char>(sql[i])) || sql[i] == '.'))
+        ++i;
+      fingerprint += '?';
+    }
+    else if (isspace(static_cast<unsigned char>(c)))
+    {
+      while (i < length && isspace(static_cast<unsigned char>(sql[i])))
+        ++i;
+      if (!fingerprint.empty() && fingerprint.back() != ' ')
+        fingerprint += ' ';
+    }
+    else
+    {
+      fingerprint += c;
+      ++i;
+    }
+  }
+
+  if (!fingerprint.empty() && fingerprint.back() == ' ')
+    fingerprint.pop_back();
+
+  // collapse lists of literals, e.g. IN (?, ?, ?) -> IN (?)
+  size_t pos = 0;
+  while ((pos = fingerprint.find("?,", pos)) != std::string::npos)
+  {
+    size_t end = pos + 2;
+    if (end < fingerprint.size() && fingerprint[end] == ' ')
+      end++;
+    if (end < fingerprint.size() && fingerprint[end] == '?')
+      fingerprint.erase(pos, end - pos);
+    else
+      pos = end;
+  }
+
+  return fingerprint;
+}
+
+std::chrono::microseconds CDatabaseProfiler::Percentile(
+    std::vector<std::chrono::microseconds> samples, double percentile)
+{
+  if (samples.empty())
+    return std::chrono::microseconds(0);
+
+  const size_t index = std::min(samples.size() - 1,
+                                static_cast<size_t>(percentile * samples.size()));
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  return samples[index];
+}
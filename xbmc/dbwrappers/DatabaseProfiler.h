@@ -0,0 +1,107 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ \ingroup database
+ \brief Aggregates timing statistics of the statements run by the database backends.
+
+ Statements are grouped by fingerprint, i.e. the SQL text with all literals replaced
+ by '?', so that the same query issued for different items is accounted together.
+ For statements slower than the explain threshold the backend captures the query plan
+ once per fingerprint. Profiling is disabled by default and costs a single atomic load
+ per statement when disabled.
+ */
+class CDatabaseProfiler
+{
+public:
+  struct Statistics
+  {
+    std::string fingerprint;
+    uint64_t count = 0;
+    uint64_t rows = 0;
+    std::chrono::microseconds total{0};
+    std::chrono::microseconds max{0};
+    std::chrono::microseconds p99{0};
+    std::string plan;
+  };
+
+  static CDatabaseProfiler& GetInstance();
+
+  void SetEnabled(bool enabled) { m_enabled = enabled; }
+  bool IsEnabled() const { return m_enabled; }
+
+  /*! \brief Set the duration above which the query plan of a statement is captured
+   \param threshold minimum duration, zero disables capturing query plans
+   */
+  void SetExplainThreshold(std::chrono::milliseconds threshold) { m_explainThreshold = threshold; }
+
+  /*! \brief Account a statement
+   \param sql the statement as sent to the backend
+   \param duration time taken by the statement, including fetching its results
+   \param rows number of rows returned
+   \return true if the backend should capture the query plan of this statement
+   */
+  bool Record(const std::string& sql, std::chrono::microseconds duration, uint64_t rows);
+
+  /*! \brief Store the query plan captured for a statement
+   */
+  void SetPlan(const std::string& sql, const std::string& plan);
+
+  /*! \brief Get the statistics of all fingerprints, sorted by descending total time
+   */
+  std::vector<Statistics> GetStatistics() const;
+
+  void Reset();
+
+  /*! \brief Log the statements with the highest total time
+   \param maxEntries maximum number of statements to log
+   */
+  void LogSummary(size_t maxEntries = 20) const;
+
+  /*! \brief Normalize a statement by replacing its literals with '?'
+   Lists of literals such as IN (1, 2, 3) are collapsed to a single '?'.
+   */
+  static std::string Fingerprint(const std::string& sql);
+
+private:
+  CDatabaseProfiler() = default;
+  CDatabaseProfiler(const CDatabaseProfiler&) = delete;
+  CDatabaseProfiler& operator=(const CDatabaseProfiler&) = delete;
+
+  static constexpr size_t SAMPLES = 256;
+
+  struct Entry
+  {
+    uint64_t count = 0;
+    uint64_t rows = 0;
+    std::chrono::microseconds total{0};
+    std::chrono::microseconds max{0};
+    std::vector<std::chrono::microseconds> samples; //!< ring buffer of the latest durations
+    std::string plan;
+    bool planRequested = false;
+  };
+
+  static std::chrono::microseconds Percentile(std::vector<std::chrono::microseconds> samples,
+                                              double percentile);
+
+  std::atomic<bool> m_enabled{false};
+  std::atomic<std::chrono::milliseconds> m_explainThreshold{std::chrono::milliseconds(0)};
+  mutable CCriticalSection m_section;
+  std::map<std::string, Entry> m_entries;
+};
@@ -8,6 +8,7 @@
 
 #include "mysqldataset.h"
 
+#include "DatabaseProfiler.h"
 #include "Util.h"
 #include "network/DNSNameCache.h"
 #include "network/WakeOnAccess.h"
@@ -15,6 +16,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <set>
 #include <string>
@@ -31,6 +33,63 @@
 #define MYSQL_OK          0
 #define ER_BAD_DB_ERROR   1049
 
+namespace
+{
+std::string GetQueryPlan(dbiplus::MysqlDatabase* db, const std::string& sql)
+{
+  // only explain queries: any statement run on the connection resets mysql_insert_id() and
+  // the affected rows, which callers read right after an INSERT, UPDATE or DELETE
+  if (!StringUtils::StartsWithNoCase(sql, "SELECT"))
+    return "";
+
+  std::string plan;
+  const std::string explain = "EXPLAIN " + sql;
+  if (db->query_with_reconnect(explain.c_str()) != MYSQL_OK)
+    return plan;
+
+  MYSQL_RES* res = mysql_store_result(db->getHandle());
+  if (!res)
+    return plan;
+
+  // one row per table: table, access type, key used and estimated rows
+  const unsigned int numColumns = mysql_num_fields(res);
+  MYSQL_FIELD* fields = mysql_fetch_fields(res);
+  MYSQL_ROW row;
+  while ((row = mysql_fetch_row(res)))
+  {
+    std::string detail;
+    for (unsigned int i = 0; i < numColumns; i++)
+    {
+      const std::string name = fields[i].name;
+      if (row[i] && (name == "table" || name == "type" || name == "key" || name == "rows" ||
+                     name == "Extra"))
+      {
+        if (!detail.empty())
+          detail += " ";
+        detail += name + "=" + row[i];
+      }
+    }
+    if (!plan.empty())
+      plan += "; ";
+    plan += detail;
+  }
+  mysql_free_result(res);
+  return plan;
+}
+
+void ProfileStatement(dbiplus::MysqlDatabase* db,
+                      const std::string& sql,
+                      std::chrono::steady_clock::time_point start,
+                      uint64_t rows)
+{
+  CDatabaseProfiler& profiler = CDatabaseProfiler::GetInstance();
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  if (profiler.Record(sql, duration, rows))
+    profiler.SetPlan(sql, GetQueryPlan(db, sql));
+}
+} // unnamed namespace
+
 namespace dbiplus {
 
 //************* MysqlDatabase implementation ***************
@@ -1584,12 +1643,17 @@ int MysqlDataset::exec(const std::string &sql) {
 
   CLog::Log(LOGDEBUG,"Mysql execute: %s", qry.c_str());
 
+  const bool profile = CDatabaseProfiler::GetInstance().IsEnabled();
+  const auto start = profile ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
   if (db->setErr( static_cast<MysqlDatabase*>(db)->query_with_reconnect(qry.c_str()), qry.c_str()) != MYSQL_OK)
   {
     throw DbErrors(db->getErrorMsg());
   }
   else
   {
+    if (profile)
+      ProfileStatement(static_cast<MysqlDatabase*>(db), qry, start, 0);
     //! @todo collect results and store in exec_res
     return res;
   }
@@ -1621,6 +1685,9 @@ bool MysqlDataset::query(const std::string &query) {
 
   MYSQL_RES *stmt = NULL;
 
+  const bool profile = CDatabaseProfiler::GetInstance().IsEnabled();
+  const auto start = profile ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
   if ( static_cast<MysqlDatabase*>(db)->setErr(static_cast<MysqlDatabase*>(db)->query_with_reconnect(qry.c_str()), qry.c_str()) != MYSQL_OK )
     throw DbErrors(db->getErrorMsg());
 
@@ -1696,6 +1763,8 @@ bool MysqlDataset::query(const std::string &query) {
     result.records.push_back(res);
   }
   mysql_free_result(stmt);
+  if (profile)
+    ProfileStatement(static_cast<MysqlDatabase*>(db), qry, start, result.records.size());
   active = true;
   ds_state = dsSelect;
   this->first();
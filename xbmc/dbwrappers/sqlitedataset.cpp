@@ -12,15 +12,53 @@
 
 #include "sqlitedataset.h"
 
+#include "DatabaseProfiler.h"
 #include "utils/URIUtils.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
+#include <chrono>
 #include <iostream>
 #include <map>
 #include <sstream>
 #include <string>
 
+namespace
+{
+std::string GetQueryPlan(sqlite3* handle, const std::string& sql)
+{
+  std::string plan;
+  sqlite3_stmt* stmt = nullptr;
+  const std::string explain = "EXPLAIN QUERY PLAN " + sql;
+  if (sqlite3_prepare_v2(handle, explain.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+    return plan;
+
+  while (sqlite3_step(stmt) == SQLITE_ROW)
+  {
+    const char* detail = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+    if (!detail)
+      continue;
+    if (!plan.empty())
+      plan += "; ";
+    plan += detail;
+  }
+  sqlite3_finalize(stmt);
+  return plan;
+}
+
+void ProfileStatement(sqlite3* handle,
+                      const std::string& sql,
+                      std::chrono::steady_clock::time_point start,
+                      uint64_t rows)
+{
+  CDatabaseProfiler& profiler = CDatabaseProfiler::GetInstance();
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  if (profiler.Record(sql, duration, rows))
+    profiler.SetPlan(sql, GetQueryPlan(handle, sql));
+}
+} // unnamed namespace
+
 namespace {
 #define X(VAL) std::make_pair(VAL, #VAL)
 //!@todo Remove ifdefs when sqlite version requirement has been bumped to at least 3.26.0
@@ -786,8 +824,15 @@ int SqliteDataset::exec(const std::string &sql) {
       qry = qry.substr(0, pos);
   }
 
+  const bool profile = CDatabaseProfiler::GetInstance().IsEnabled();
+  const auto start = profile ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
   if((res = db->setErr(sqlite3_exec(handle(),qry.c_str(),&callback,&exec_res,&errmsg),qry.c_str())) == SQLITE_OK)
+  {
+    if (profile)
+      ProfileStatement(handle(), qry, start, exec_res.records.size());
     return res;
+  }
   else
     {
       if (errmsg)
@@ -816,6 +861,9 @@ bool SqliteDataset::query(const std::string &query) {
 
   close();
 
+  const bool profile = CDatabaseProfiler::GetInstance().IsEnabled();
+  const auto start = profile ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
   sqlite3_stmt *stmt = NULL;
   if (db->setErr(sqlite3_prepare_v2(handle(),query.c_str(),-1,&stmt, NULL),query.c_str()) != SQLITE_OK)
     throw DbErrors("%s", db->getErrorMsg());
@@ -859,6 +907,8 @@ bool SqliteDataset::query(const std::string &query) {
   }
   if (db->setErr(sqlite3_finalize(stmt),query.c_str()) == SQLITE_OK)
   {
+    if (profile)
+      ProfileStatement(handle(), query, start, result.records.size());
     active = true;
     ds_state = dsSelect;
     this->first();
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/DatabaseProfiler.h"
+
+#include <gtest/gtest.h>
+
+TEST(TestDatabaseProfiler, FingerprintLiterals)
+{
+  EXPECT_EQ("SELECT * FROM movie WHERE idMovie=? AND c00=?",
+            CDatabaseProfiler::Fingerprint("SELECT * FROM movie WHERE idMovie=12 AND c00='It''s'"));
+  EXPECT_EQ("SELECT c09, c12 FROM episode WHERE rating > ?",
+            CDatabaseProfiler::Fingerprint("SELECT c09, c12 FROM episode WHERE rating > 7.5"));
+}
+
+TEST(TestDatabaseProfiler, FingerprintLists)
+{
+  EXPECT_EQ("DELETE FROM files WHERE idFile IN (?)",
+            CDatabaseProfiler::Fingerprint("DELETE FROM files WHERE idFile IN (1, 2,3, 'x')"));
+}
+
+TEST(TestDatabaseProfiler, FingerprintWhitespace)
+{
+  EXPECT_EQ("SELECT idPath FROM path WHERE strPath=?",
+            CDatabaseProfiler::Fingerprint("  SELECT idPath\n  FROM path\tWHERE strPath='/a b/'  "));
+}
+
+TEST(TestDatabaseProfiler, Record)
+{
+  CDatabaseProfiler& profiler = CDatabaseProfiler::GetInstance();
+  profiler.Reset();
+  profiler.SetExplainThreshold(std::chrono::milliseconds(10));
+
+  EXPECT_FALSE(profiler.Record("SELECT * FROM tag WHERE tag_id=1", std::chrono::microseconds(500), 1));
+  EXPECT_TRUE(profiler.Record("SELECT * FROM tag WHERE tag_id=2", std::chrono::microseconds(20000), 1));
+  // the plan is only requested once per statement
+  EXPECT_FALSE(profiler.Record("SELECT * FROM tag WHERE tag_id=3", std::chrono::microseconds(20000), 0));
+  profiler.SetPlan("SELECT * FROM tag WHERE tag_id=4", "SEARCH tag USING INTEGER PRIMARY KEY");
+
+  const auto statistics = profiler.GetStatistics();
+  ASSERT_EQ(1u, statistics.size());
+  EXPECT_EQ(3u, statistics[0].count);
+  EXPECT_EQ(2u, statistics[0].rows);
+  EXPECT_EQ(40500, statistics[0].total.count());
+  EXPECT_EQ(20000, statistics[0].max.count());
+  EXPECT_EQ("SEARCH tag USING INTEGER PRIMARY KEY", statistics[0].plan);
+
+  profiler.Reset();
+  profiler.SetExplainThreshold(std::chrono::milliseconds(0));
+}
@@ -8,6 +8,7 @@
 #include "FFmpegImage.h"
 #include "utils/log.h"
 #include "cores/FFmpeg.h"
+#include "cores/SwsContextCache.h"
 #include "guilib/Texture.h"
 
 #include <algorithm>
@@ -46,7 +47,6 @@ struct ThumbDataManagement
   uint8_t* intermediateBuffer = nullptr; // gets av_alloced
   AVFrame* frame_input = nullptr;
   AVFrame* frame_temporary = nullptr;
-  SwsContext* sws = nullptr;
   AVCodecContext* avOutctx = nullptr;
   AVCodec* codec = nullptr;
   ~ThumbDataManagement()
@@ -59,8 +59,6 @@ struct ThumbDataManagement
     frame_temporary = nullptr;
     avcodec_free_context(&avOutctx);
     avOutctx = nullptr;
-    sws_freeContext(sws);
-    sws = nullptr;
   }
 };
 
@@ -481,22 +479,16 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     nHeight = (unsigned int)(nWidth / ratio + 0.5f);
   }
 
-  struct SwsContext* context = sws_getContext(m_originalWidth, m_originalHeight, pixFormat,
-    nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC, NULL, NULL, NULL);
-
-  if (range == AVCOL_RANGE_JPEG)
+  SwsContext* context = CSwsContextCache::Get(m_originalWidth, m_originalHeight, pixFormat,
+    nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC, range == AVCOL_RANGE_JPEG ? 1 : -1);
+  if (!context)
   {
-    int* inv_table = nullptr;
-    int* table = nullptr;
-    int srcRange, dstRange, brightness, contrast, saturation;
-    sws_getColorspaceDetails(context, &inv_table, &srcRange, &table, &dstRange, &brightness, &contrast, &saturation);
-    srcRange = 1;
-    sws_setColorspaceDetails(context, inv_table, srcRange, table, dstRange, brightness, contrast, saturation);
+    av_frame_free(&pictureRGB);
+    return false;
   }
 
   sws_scale(context, frame->data, frame->linesize, 0, m_originalHeight,
     pictureRGB->data, pictureRGB->linesize);
-  sws_freeContext(context);
 
   if (needsCopy)
   {
@@ -637,38 +629,18 @@ bool CFFmpegImage::CreateThumbnailFromSurface(unsigned char* bufferin, unsigned
   int srcStride[] = { (int) pitch, 0, 0, 0};
 
   //input size == output size which means only pix_fmt conversion
-  tdm.sws = sws_getContext(width, height, AV_PIX_FMT_RGB32, width, height, jpg_output ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_RGBA, 0, 0, 0, 0);
-  if (!tdm.sws)
+  //jpeg gets full range yuv420p output from the full range RGB32 input
+  SwsContext* sws = CSwsContextCache::Get(width, height, AV_PIX_FMT_RGB32, width, height,
+                                          jpg_output ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_RGBA, 0,
+                                          jpg_output ? 0 : -1, jpg_output ? 1 : -1);
+  if (!sws)
   {
     CLog::Log(LOGERROR, "Could not setup scaling context for thumbnail: %s", destFile.c_str());
     CleanupLocalOutputBuffer();
     return false;
   }
 
-  // Setup jpeg range for sws
-  if (jpg_output)
-  {
-    int* inv_table = nullptr;
-    int* table = nullptr;
-    int srcRange, dstRange, brightness, contrast, saturation;
-
-    if (sws_getColorspaceDetails(tdm.sws, &inv_table, &srcRange, &table, &dstRange, &brightness, &contrast, &saturation) < 0)
-    {
-      CLog::Log(LOGERROR, "SWS_SCALE failed to get ColorSpaceDetails for thumbnail: %s", destFile.c_str());
-      CleanupLocalOutputBuffer();
-      return false;
-    }
-    dstRange = 1; // jpeg full range yuv420p output
-    srcRange = 0; // full range RGB32 input
-    if (sws_setColorspaceDetails(tdm.sws, inv_table, srcRange, table, dstRange, brightness, contrast, saturation) < 0)
-    {
-      CLog::Log(LOGERROR, "SWS_SCALE failed to set ColorSpace Details for thumbnail: %s", destFile.c_str());
-      CleanupLocalOutputBuffer();
-      return false;
-    }
-  }
-
-  if (sws_scale(tdm.sws, src, srcStride, 0, height, tdm.frame_temporary->data, tdm.frame_temporary->linesize) < 0)
+  if (sws_scale(sws, src, srcStride, 0, height, tdm.frame_temporary->data, tdm.frame_temporary->linesize) < 0)
   {
     CLog::Log(LOGERROR, "SWS_SCALE failed for thumbnail: %s", destFile.c_str());
     CleanupLocalOutputBuffer();
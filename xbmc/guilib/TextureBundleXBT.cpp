@@ -16,12 +16,19 @@
 #include "filesystem/XbtManager.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/CPUBudget.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <algorithm>
+#include <atomic>
 #include <inttypes.h>
+#include <new>
+#include <string.h>
+#include <system_error>
+#include <thread>
 
 #include <lzo/lzo1x.h>
 
@@ -33,6 +40,12 @@
 #endif
 #endif
 
+namespace
+{
+// unpacking a frame is cheap, a thread only pays off for a handful of them
+constexpr size_t MIN_FRAMES_PER_THREAD = 4;
+}
+
 CTextureBundleXBT::CTextureBundleXBT()
   : m_TimeStamp{0}
   , m_themeBundle{false}
@@ -154,15 +167,12 @@ bool CTextureBundleXBT::LoadTexture(const std::string& Filename,
 {
   std::string name = Normalize(Filename);
 
-  CXBTFFile file;
-  if (!m_XBTFReader->Get(name, file))
+  const CXBTFFile* file = m_XBTFReader->Find(name);
+  if (file == nullptr || file->GetFrames().empty())
     return false;
 
-  if (file.GetFrames().empty())
-    return false;
-
-  CXBTFFrame& frame = file.GetFrames().at(0);
-  if (!ConvertFrameToTexture(Filename, frame, ppTexture))
+  const CXBTFFrame& frame = file->GetFrames().front();
+  if (!ConvertFrameToTexture(Filename, frame, nullptr, ppTexture))
   {
     return false;
   }
@@ -182,22 +192,24 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename,
 {
   std::string name = Normalize(Filename);
 
-  CXBTFFile file;
-  if (!m_XBTFReader->Get(name, file))
+  const CXBTFFile* file = m_XBTFReader->Find(name);
+  if (file == nullptr || file->GetFrames().empty())
     return false;
 
-  if (file.GetFrames().empty())
-    return false;
+  const std::vector<CXBTFFrame>& frames = file->GetFrames();
 
-  size_t nTextures = file.GetFrames().size();
+  // unpack all frames up front, the textures have to be created on this thread
+  std::vector<std::unique_ptr<uint8_t[]>> unpacked = UnpackFrames(*m_XBTFReader, frames);
+
+  size_t nTextures = frames.size();
   *ppTextures = new CTexture*[nTextures];
   *ppDelays = new int[nTextures];
 
   for (size_t i = 0; i < nTextures; i++)
   {
-    CXBTFFrame& frame = file.GetFrames().at(i);
+    const CXBTFFrame& frame = frames[i];
 
-    if (!ConvertFrameToTexture(Filename, frame, &((*ppTextures)[i])))
+    if (!ConvertFrameToTexture(Filename, frame, unpacked[i].get(), &((*ppTextures)[i])))
     {
       return false;
     }
@@ -205,61 +217,37 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename,
     (*ppDelays)[i] = frame.GetDuration();
   }
 
-  width = file.GetFrames().at(0).GetWidth();
-  height = file.GetFrames().at(0).GetHeight();
-  nLoops = file.GetLoop();
+  width = frames.front().GetWidth();
+  height = frames.front().GetHeight();
+  nLoops = file->GetLoop();
 
   return nTextures;
 }
 
 bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name,
-                                              CXBTFFrame& frame,
+                                              const CXBTFFrame& frame,
+                                              const uint8_t* data,
                                               CTexture** ppTexture)
 {
-  // found texture - allocate the necessary buffers
-  unsigned char *buffer = new unsigned char [(size_t)frame.GetPackedSize()];
-  if (buffer == NULL)
-  {
-    CLog::Log(LOGERROR, "Out of memory loading texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetPackedSize());
-    return false;
-  }
+  // frames that aren't packed are used directly from the mapped bundle
+  if (data == nullptr && !frame.IsPacked())
+    data = m_XBTFReader->GetFrameData(frame);
 
-  // load the compressed texture
-  if (!m_XBTFReader->Load(frame, buffer))
+  std::unique_ptr<uint8_t[]> unpacked;
+  if (data == nullptr)
   {
-    CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
-    delete[] buffer;
-    return false;
-  }
-
-  // check if it's packed with lzo
-  if (frame.IsPacked())
-  { // unpack
-    unsigned char *unpacked = new unsigned char[(size_t)frame.GetUnpackedSize()];
-    if (unpacked == NULL)
-    {
-      CLog::Log(LOGERROR, "Out of memory unpacking texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetUnpackedSize());
-      delete[] buffer;
-      return false;
-    }
-    lzo_uint s = (lzo_uint)frame.GetUnpackedSize();
-    if (lzo1x_decompress_safe(buffer, (lzo_uint)frame.GetPackedSize(), unpacked, &s, NULL) != LZO_E_OK ||
-        s != frame.GetUnpackedSize())
+    unpacked.reset(UnpackFrame(*m_XBTFReader, frame));
+    if (unpacked == nullptr)
     {
-      CLog::Log(LOGERROR, "Error loading texture: %s: Decompression error", name.c_str());
-      delete[] buffer;
-      delete[] unpacked;
+      CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
       return false;
     }
-    delete[] buffer;
-    buffer = unpacked;
+    data = unpacked.get();
   }
 
   // create an xbmc texture
   *ppTexture = CTexture::CreateTexture();
-  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), buffer);
-
-  delete[] buffer;
+  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), data);
 
   return true;
 }
@@ -284,52 +272,104 @@ std::string CTextureBundleXBT::Normalize(const std::string &name)
 
 uint8_t* CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame)
 {
-  uint8_t* packedBuffer = new uint8_t[static_cast<size_t>(frame.GetPackedSize())];
-  if (packedBuffer == nullptr)
-  {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: out of memory loading frame with %" PRIu64" packed bytes", frame.GetPackedSize());
-    return nullptr;
-  }
+  const size_t packedSize = static_cast<size_t>(frame.GetPackedSize());
 
-  // load the compressed texture
-  if (!reader.Load(frame, packedBuffer))
+  // use the frame from the mapped bundle or load it from the file
+  const uint8_t* packedData = reader.GetFrameData(frame);
+  std::unique_ptr<uint8_t[]> packedBuffer;
+  if (packedData == nullptr || !frame.IsPacked())
   {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: error loading frame");
-    delete[] packedBuffer;
-    return nullptr;
-  }
+    packedBuffer.reset(new uint8_t[packedSize]);
+    if (packedData != nullptr)
+      memcpy(packedBuffer.get(), packedData, packedSize);
+    else if (!reader.Load(frame, packedBuffer.get()))
+    {
+      CLog::Log(LOGERROR, "CTextureBundleXBT: error loading frame");
+      return nullptr;
+    }
 
-  // if the frame isn't packed there's nothing else to be done
-  if (!frame.IsPacked())
-    return packedBuffer;
+    // if the frame isn't packed there's nothing else to be done
+    if (!frame.IsPacked())
+      return packedBuffer.release();
 
-  uint8_t* unpackedBuffer = new uint8_t[static_cast<size_t>(frame.GetUnpackedSize())];
-  if (unpackedBuffer == nullptr)
-  {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: out of memory loading frame with %" PRIu64" unpacked bytes", frame.GetPackedSize());
-    delete[] packedBuffer;
-    return nullptr;
+    packedData = packedBuffer.get();
   }
 
+  std::unique_ptr<uint8_t[]> unpackedBuffer(new uint8_t[static_cast<size_t>(frame.GetUnpackedSize())]);
+
   // make sure lzo is initialized
   if (lzo_init() != LZO_E_OK)
   {
     CLog::Log(LOGERROR, "CTextureBundleXBT: failed to initialize lzo");
-    delete[] packedBuffer;
-    delete[] unpackedBuffer;
     return nullptr;
   }
 
   lzo_uint size = static_cast<lzo_uint>(frame.GetUnpackedSize());
-  if (lzo1x_decompress_safe(packedBuffer, static_cast<lzo_uint>(frame.GetPackedSize()), unpackedBuffer, &size, nullptr) != LZO_E_OK || size != frame.GetUnpackedSize())
+  if (lzo1x_decompress_safe(packedData, static_cast<lzo_uint>(packedSize), unpackedBuffer.get(), &size, nullptr) != LZO_E_OK || size != frame.GetUnpackedSize())
   {
     CLog::Log(LOGERROR, "CTextureBundleXBT: failed to decompress frame with %" PRIu64" unpacked bytes to %" PRIu64" bytes", frame.GetPackedSize(), frame.GetUnpackedSize());
-    delete[] packedBuffer;
-    delete[] unpackedBuffer;
     return nullptr;
   }
 
-  delete[] packedBuffer;
+  return unpackedBuffer.release();
+}
+
+std::vector<std::unique_ptr<uint8_t[]>> CTextureBundleXBT::UnpackFrames(
+    const CXBTFReader& reader, const std::vector<CXBTFFrame>& frames)
+{
+  std::vector<std::unique_ptr<uint8_t[]>> unpacked(frames.size());
+
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < frames.size(); i++)
+  {
+    if (frames[i].IsPacked() || reader.GetFrameData(frames[i]) == nullptr)
+      pending.push_back(i);
+  }
+
+  std::atomic<size_t> next{0};
+  auto unpack = [&]() {
+    for (size_t i = next++; i < pending.size(); i = next++)
+    {
+      try
+      {
+        unpacked[pending[i]].reset(UnpackFrame(reader, frames[pending[i]]));
+      }
+      catch (const std::bad_alloc&)
+      {
+        // the frame stays empty and ConvertFrameToTexture unpacks it again
+        CLog::Log(LOGERROR, "CTextureBundleXBT: out of memory unpacking frame");
+      }
+    }
+  };
+
+  // without a mapping the frames are read from the file, which can't be shared between threads.
+  // threads are leased from the decoder budget so that unpacking doesn't compete with playback
+  int leased = 0;
+  if (reader.IsMapped() && pending.size() >= 2 * MIN_FRAMES_PER_THREAD)
+    leased = CCPUBudget::GetInstance().AcquireDecoderThreads(static_cast<int>(std::min<size_t>(
+        pending.size() / MIN_FRAMES_PER_THREAD, std::thread::hardware_concurrency())));
+  const size_t threadCount = static_cast<size_t>(std::max(leased, 1));
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < threadCount; i++)
+  {
+    try
+    {
+      threads.emplace_back(unpack);
+    }
+    catch (const std::system_error&)
+    {
+      break;
+    }
+  }
+
+  unpack();
+
+  for (auto& thread : threads)
+    thread.join();
+
+  if (leased > 0)
+    CCPUBudget::GetInstance().ReleaseDecoderThreads(leased);
 
-  return unpackedBuffer;
+  return unpacked;
 }
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <ctime>
+#include <stdint.h>
 #include <map>
 #include <memory>
 #include <string>
@@ -41,11 +42,23 @@ public:
 
   static uint8_t* UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame);
 
+  /*!
+   * \brief Unpack several frames, in parallel if the reader allows it and there are enough of them.
+   * The threads are leased from CCPUBudget.
+   * \return the unpacked frames, nullptr for frames that can be used directly from
+   * CXBTFReader::GetFrameData() or that failed to unpack
+   */
+  static std::vector<std::unique_ptr<uint8_t[]>> UnpackFrames(const CXBTFReader& reader,
+                                                              const std::vector<CXBTFFrame>& frames);
+
   void CloseBundle();
 
 private:
   bool OpenBundle();
-  bool ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CTexture** ppTexture);
+  bool ConvertFrameToTexture(const std::string& name,
+                             const CXBTFFrame& frame,
+                             const uint8_t* data,
+                             CTexture** ppTexture);
 
   time_t m_TimeStamp;
 
@@ -195,20 +195,28 @@ uint64_t CXBTFBase::GetHeaderSize() const
 
 bool CXBTFBase::Exists(const std::string& name) const
 {
-  CXBTFFile dummy;
-  return Get(name, dummy);
+  return Find(name) != nullptr;
 }
 
 bool CXBTFBase::Get(const std::string& name, CXBTFFile& file) const
 {
-  const auto& iter = m_files.find(name);
-  if (iter == m_files.end())
+  const CXBTFFile* found = Find(name);
+  if (found == nullptr)
     return false;
 
-  file = iter->second;
+  file = *found;
   return true;
 }
 
+const CXBTFFile* CXBTFBase::Find(const std::string& name) const
+{
+  const auto& iter = m_files.find(name);
+  if (iter == m_files.end())
+    return nullptr;
+
+  return &iter->second;
+}
+
 std::vector<CXBTFFile> CXBTFBase::GetFiles() const
 {
   std::vector<CXBTFFile> files;
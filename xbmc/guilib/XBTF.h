@@ -97,6 +97,13 @@ public:
 
   bool Exists(const std::string& name) const;
   bool Get(const std::string& name, CXBTFFile& file) const;
+
+  /*!
+   * \brief Look up a file without copying it.
+   * \return the file or nullptr if it doesn't exist, valid until the files are modified
+   */
+  virtual const CXBTFFile* Find(const std::string& name) const;
+
   std::vector<CXBTFFile> GetFiles() const;
   void AddFile(const CXBTFFile& file);
   void UpdateFile(const CXBTFFile& file);
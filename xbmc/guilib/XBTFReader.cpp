@@ -14,6 +14,13 @@
 #include "XBTFReader.h"
 #include "guilib/XBTF.h"
 #include "utils/EndianSwap.h"
+#include "utils/log.h"
+
+#if defined(TARGET_POSIX)
+#include "platform/posix/utils/Mmap.h"
+
+#include <system_error>
+#endif
 
 #ifdef TARGET_WINDOWS
 #include "filesystem/SpecialProtocol.h"
@@ -21,38 +28,69 @@
 #include "platform/win32/PlatformDefs.h"
 #endif
 
-static bool ReadString(FILE* file, char* str, size_t max_length)
+namespace
 {
-  if (file == nullptr || str == nullptr || max_length <= 0)
-    return false;
 
-  return (fread(str, max_length, 1, file) == 1);
+// reads the header either from the mapped bundle or from the file
+struct HeaderSource
+{
+  FILE* file = nullptr;
+  const unsigned char* data = nullptr;
+  size_t size = 0;
+  size_t position = 0;
+};
+
+bool ReadBytes(HeaderSource& source, void* buffer, size_t length)
+{
+  if (source.data != nullptr)
+  {
+    if (length > source.size - source.position)
+      return false;
+
+    memcpy(buffer, source.data + source.position, length);
+    source.position += length;
+    return true;
+  }
+
+  return source.file != nullptr && fread(buffer, length, 1, source.file) == 1;
 }
 
-static bool ReadUInt32(FILE* file, uint32_t& value)
+uint64_t GetPosition(const HeaderSource& source)
 {
-  if (file == nullptr)
+  if (source.data != nullptr)
+    return source.position;
+
+  return static_cast<uint64_t>(ftell(source.file));
+}
+
+bool ReadString(HeaderSource& source, char* str, size_t max_length)
+{
+  if (str == nullptr || max_length <= 0)
     return false;
 
-  if (fread(&value, sizeof(uint32_t), 1, file) != 1)
+  return ReadBytes(source, str, max_length);
+}
+
+bool ReadUInt32(HeaderSource& source, uint32_t& value)
+{
+  if (!ReadBytes(source, &value, sizeof(uint32_t)))
     return false;
 
   value = Endian_SwapLE32(value);
   return true;
 }
 
-static bool ReadUInt64(FILE* file, uint64_t& value)
+bool ReadUInt64(HeaderSource& source, uint64_t& value)
 {
-  if (file == nullptr)
-    return false;
-
-  if (fread(&value, sizeof(uint64_t), 1, file) != 1)
+  if (!ReadBytes(source, &value, sizeof(uint64_t)))
     return false;
 
   value = Endian_SwapLE64(value);
   return true;
 }
 
+} // unnamed namespace
+
 CXBTFReader::CXBTFReader()
   : CXBTFBase(),
     m_path()
@@ -80,9 +118,32 @@ bool CXBTFReader::Open(const std::string& path)
   if (m_file == nullptr)
     return false;
 
+  HeaderSource source;
+  source.file = m_file;
+
+#if defined(TARGET_POSIX)
+  struct stat fileStat;
+  if (fstat(fileno(m_file), &fileStat) == 0 && fileStat.st_size > 0 &&
+      static_cast<uint64_t>(fileStat.st_size) <= SIZE_MAX)
+  {
+    try
+    {
+      m_mapping.reset(new KODI::UTILS::POSIX::CMmap(
+          nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileno(m_file), 0));
+      source.data = static_cast<const unsigned char*>(m_mapping->Data());
+      source.size = m_mapping->Size();
+    }
+    catch (const std::system_error& e)
+    {
+      // fall back to reading from the file
+      CLog::Log(LOGDEBUG, "CXBTFReader: failed to map %s: %s", m_path.c_str(), e.what());
+    }
+  }
+#endif
+
   // read the magic word
   char magic[4];
-  if (!ReadString(m_file, magic, sizeof(magic)))
+  if (!ReadString(source, magic, sizeof(magic)))
     return false;
 
   if (strncmp(XBTF_MAGIC.c_str(), magic, sizeof(magic)) != 0)
@@ -90,14 +151,14 @@ bool CXBTFReader::Open(const std::string& path)
 
   // read the version
   char version[1];
-  if (!ReadString(m_file, version, sizeof(version)))
+  if (!ReadString(source, version, sizeof(version)))
     return false;
 
   if (strncmp(XBTF_VERSION.c_str(), version, sizeof(version)) != 0)
     return false;
 
   unsigned int nofFiles;
-  if (!ReadUInt32(m_file, nofFiles))
+  if (!ReadUInt32(source, nofFiles))
     return false;
 
   for (uint32_t i = 0; i < nofFiles; i++)
@@ -109,47 +170,47 @@ bool CXBTFReader::Open(const std::string& path)
     // one extra char to null terminate the string with the following memset
     char path[CXBTFFile::MaximumPathLength + 1];
     memset(path, 0, sizeof(path));
-    if (!ReadString(m_file, path, sizeof(path) - 1))
+    if (!ReadString(source, path, sizeof(path) - 1))
       return false;
     xbtfFile.SetPath(path);
 
-    if (!ReadUInt32(m_file, u32))
+    if (!ReadUInt32(source, u32))
       return false;
     xbtfFile.SetLoop(u32);
 
     unsigned int nofFrames;
-    if (!ReadUInt32(m_file, nofFrames))
+    if (!ReadUInt32(source, nofFrames))
       return false;
 
     for (uint32_t j = 0; j < nofFrames; j++)
     {
       CXBTFFrame frame;
 
-      if (!ReadUInt32(m_file, u32))
+      if (!ReadUInt32(source, u32))
         return false;
       frame.SetWidth(u32);
 
-      if (!ReadUInt32(m_file, u32))
+      if (!ReadUInt32(source, u32))
         return false;
       frame.SetHeight(u32);
 
-      if (!ReadUInt32(m_file, u32))
+      if (!ReadUInt32(source, u32))
         return false;
       frame.SetFormat(u32);
 
-      if (!ReadUInt64(m_file, u64))
+      if (!ReadUInt64(source, u64))
         return false;
       frame.SetPackedSize(u64);
 
-      if (!ReadUInt64(m_file, u64))
+      if (!ReadUInt64(source, u64))
         return false;
       frame.SetUnpackedSize(u64);
 
-      if (!ReadUInt32(m_file, u32))
+      if (!ReadUInt32(source, u32))
         return false;
       frame.SetDuration(u32);
 
-      if (!ReadUInt64(m_file, u64))
+      if (!ReadUInt64(source, u64))
         return false;
       frame.SetOffset(u64);
 
@@ -160,10 +221,14 @@ bool CXBTFReader::Open(const std::string& path)
   }
 
   // Sanity check
-  uint64_t pos = static_cast<uint64_t>(ftell(m_file));
+  uint64_t pos = GetPosition(source);
   if (pos != GetHeaderSize())
     return false;
 
+  m_index.reserve(m_files.size());
+  for (const auto& file : m_files)
+    m_index.emplace(file.first, &file.second);
+
   return true;
 }
 
@@ -172,6 +237,15 @@ bool CXBTFReader::IsOpen() const
   return m_file != nullptr;
 }
 
+bool CXBTFReader::IsMapped() const
+{
+#if defined(TARGET_POSIX)
+  return m_mapping != nullptr;
+#else
+  return false;
+#endif
+}
+
 void CXBTFReader::Close()
 {
   if (m_file != nullptr)
@@ -180,7 +254,12 @@ void CXBTFReader::Close()
     m_file = nullptr;
   }
 
+#if defined(TARGET_POSIX)
+  m_mapping.reset();
+#endif
+
   m_path.clear();
+  m_index.clear();
   m_files.clear();
 }
 
@@ -196,11 +275,27 @@ time_t CXBTFReader::GetLastModificationTimestamp() const
   return fileStat.st_mtime;
 }
 
+const CXBTFFile* CXBTFReader::Find(const std::string& name) const
+{
+  const auto& iter = m_index.find(name);
+  if (iter == m_index.end())
+    return nullptr;
+
+  return iter->second;
+}
+
 bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer) const
 {
   if (m_file == nullptr)
     return false;
 
+  const unsigned char* data = GetFrameData(frame);
+  if (data != nullptr)
+  {
+    memcpy(buffer, data, static_cast<size_t>(frame.GetPackedSize()));
+    return true;
+  }
+
 #if defined(TARGET_DARWIN) || defined(TARGET_FREEBSD)
   if (fseeko(m_file, static_cast<off_t>(frame.GetOffset()), SEEK_SET) == -1)
 #elif defined(TARGET_ANDROID)
@@ -215,3 +310,19 @@ bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer) const
 
   return true;
 }
+
+const unsigned char* CXBTFReader::GetFrameData(const CXBTFFrame& frame) const
+{
+#if defined(TARGET_POSIX)
+  if (!IsMapped())
+    return nullptr;
+
+  const uint64_t size = m_mapping->Size();
+  if (frame.GetOffset() > size || frame.GetPackedSize() > size - frame.GetOffset())
+    return nullptr;
+
+  return static_cast<const unsigned char*>(m_mapping->Data()) + frame.GetOffset();
+#else
+  return nullptr;
+#endif
+}
@@ -13,8 +13,29 @@
 #include <memory>
 #include <stdint.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#if defined(TARGET_POSIX)
+namespace KODI
+{
+namespace UTILS
+{
+namespace POSIX
+{
+class CMmap;
+}
+}
+}
+#endif
+
+/*!
+ * \brief Reader for XBT texture bundles.
+ *
+ * Where possible the bundle is mapped into memory, which allows uncompressed frames to be
+ * used without copying them (see GetFrameData()) and frames to be loaded from several
+ * threads at once. Otherwise the frames are read from the file, which isn't thread-safe.
+ */
 class CXBTFReader : public CXBTFBase
 {
 public:
@@ -23,15 +44,28 @@ public:
 
   bool Open(const std::string& path);
   bool IsOpen() const;
+  bool IsMapped() const;
   void Close();
 
   time_t GetLastModificationTimestamp() const;
 
+  const CXBTFFile* Find(const std::string& name) const override;
+
   bool Load(const CXBTFFrame& frame, unsigned char* buffer) const;
 
+  /*!
+   * \brief Get the data of a frame as stored in the bundle without copying it.
+   * \return pointer to GetPackedSize() bytes, nullptr if the bundle isn't mapped into memory
+   */
+  const unsigned char* GetFrameData(const CXBTFFrame& frame) const;
+
 private:
   std::string m_path;
   FILE* m_file = nullptr;
+#if defined(TARGET_POSIX)
+  std::unique_ptr<KODI::UTILS::POSIX::CMmap> m_mapping;
+#endif
+  std::unordered_map<std::string, const CXBTFFile*> m_index;
 };
 
 typedef std::shared_ptr<CXBTFReader> CXBTFReaderPtr;
@@ -27,13 +27,15 @@
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
+#include "video/TrickplayIndex.h"
 
 #include <cmath>
 
 using namespace KODI::GUILIB::GUIINFO;
 
 CPlayerGUIInfo::CPlayerGUIInfo()
-: m_playerShowTime(false),
+: m_trickplayIndex(new VIDEO::CTrickplayIndex),
+  m_playerShowTime(false),
   m_playerShowInfo(false)
 {
 }
@@ -121,6 +123,17 @@ std::string CPlayerGUIInfo::GetSeekTime(TIME_FORMAT format) const
   return StringUtils::SecondsToTimeString(iSeekTimeCode, format);
 }
 
+std::string CPlayerGUIInfo::GetSeekPreview() const
+{
+  double seekTime;
+  if (g_application.GetAppPlayer().GetSeekHandler().HasTimeCode())
+    seekTime = g_application.GetAppPlayer().GetSeekHandler().GetTimeCodeSeconds();
+  else
+    seekTime = g_application.GetTime() + g_application.GetAppPlayer().GetSeekHandler().GetSeekSize();
+
+  return m_trickplayIndex->GetThumb(std::llrint(seekTime * 1000));
+}
+
 void CPlayerGUIInfo::SetDisplayAfterSeek(unsigned int timeOut, int seekOffset)
 {
   if (timeOut > 0)
@@ -163,6 +176,7 @@ bool CPlayerGUIInfo::InitCurrentItem(CFileItem *item)
   {
     m_currentItem.reset();
   }
+  m_trickplayIndex->SetItem(m_currentItem.get());
   return false;
 }
 
@@ -301,6 +315,9 @@ bool CPlayerGUIInfo::GetLabel(std::string& value, const CFileItem *item, int con
     case PLAYER_CHAPTERS:
       value = GetContentRanges(info.m_info);
       return true;
+    case PLAYER_SEEKPREVIEW:
+      value = GetSeekPreview();
+      return !value.empty();
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // PLAYER_PROCESS_*
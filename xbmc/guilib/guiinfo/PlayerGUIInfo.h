@@ -18,6 +18,11 @@
 
 class CDataCacheCore;
 
+namespace VIDEO
+{
+class CTrickplayIndex;
+}
+
 namespace KODI
 {
 namespace GUILIB
@@ -48,6 +53,7 @@ public:
 
 private:
   std::unique_ptr<CFileItem> m_currentItem;
+  std::unique_ptr<VIDEO::CTrickplayIndex> m_trickplayIndex;
 
   unsigned int m_AfterSeekTimeout = 0;
   mutable int m_seekOffset = 0;
@@ -64,6 +70,7 @@ private:
   std::string GetDuration(TIME_FORMAT format) const;
   std::string GetCurrentSeekTime(TIME_FORMAT format) const;
   std::string GetSeekTime(TIME_FORMAT format) const;
+  std::string GetSeekPreview() const;
 
   std::string GetContentRanges(int iInfo) const;
   std::vector<std::pair<float, float>> GetCutList(CDataCacheCore& data, time_t duration) const;
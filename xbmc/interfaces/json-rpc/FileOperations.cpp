@@ -78,21 +78,21 @@ JSONRPC_STATUS CFileOperations::GetDirectory(const std::string &method, ITranspo
   if (!CFileUtils::RemoteAccessAllowed(strPath))
     return InvalidParams;
 
-  std::vector<std::string> regexps;
+  std::shared_ptr<const CRegExpSet> regexps;
   std::string extensions;
   if (media == "video")
   {
-    regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoExcludeFromListingRegExps;
+    regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoExcludeFromListingRegExpSet;
     extensions = CServiceBroker::GetFileExtensionProvider().GetVideoExtensions();
   }
   else if (media == "music")
   {
-    regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromListingRegExps;
+    regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromListingRegExpSet;
     extensions = CServiceBroker::GetFileExtensionProvider().GetMusicExtensions();
   }
   else if (media == "pictures")
   {
-    regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_pictureExcludeFromListingRegExps;
+    regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_pictureExcludeFromListingRegExpSet;
     extensions = CServiceBroker::GetFileExtensionProvider().GetPictureExtensions();
   }
 
@@ -109,7 +109,7 @@ JSONRPC_STATUS CFileOperations::GetDirectory(const std::string &method, ITranspo
     CFileItemList filteredFiles;
     for (unsigned int i = 0; i < (unsigned int)items.Size(); i++)
     {
-      if (CUtil::ExcludeFileOrFolder(items[i]->GetPath(), regexps))
+      if (regexps && CUtil::ExcludeFileOrFolder(items[i]->GetPath(), *regexps))
         continue;
 
       if (items[i]->IsSmb())
@@ -349,21 +349,21 @@ bool CFileOperations::FillFileItemList(const CVariant &parameterObject, CFileIte
     {
       CFileItemList items;
       std::string extensions;
-      std::vector<std::string> regexps;
+      std::shared_ptr<const CRegExpSet> regexps;
 
       if (media == "video")
       {
-        regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoExcludeFromListingRegExps;
+        regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoExcludeFromListingRegExpSet;
         extensions = CServiceBroker::GetFileExtensionProvider().GetVideoExtensions();
       }
       else if (media == "music")
       {
-        regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromListingRegExps;
+        regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromListingRegExpSet;
         extensions = CServiceBroker::GetFileExtensionProvider().GetMusicExtensions();
       }
       else if (media == "pictures")
       {
-        regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_pictureExcludeFromListingRegExps;
+        regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_pictureExcludeFromListingRegExpSet;
         extensions = CServiceBroker::GetFileExtensionProvider().GetPictureExtensions();
       }
 
@@ -378,7 +378,7 @@ bool CFileOperations::FillFileItemList(const CVariant &parameterObject, CFileIte
         CFileItemList filteredDirectories;
         for (unsigned int i = 0; i < (unsigned int)items.Size(); i++)
         {
-          if (CUtil::ExcludeFileOrFolder(items[i]->GetPath(), regexps))
+          if (regexps && CUtil::ExcludeFileOrFolder(items[i]->GetPath(), *regexps))
             continue;
 
           if (items[i]->m_bIsFolder)
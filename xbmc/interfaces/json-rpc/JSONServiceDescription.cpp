@@ -239,7 +239,9 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 
 // XBMC operations
   { "XBMC.GetInfoLabels",                           CXBMCOperations::GetInfoLabels },
-  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans }
+  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans },
+  { "XBMC.GetDatabaseProfile",                      CXBMCOperations::GetDatabaseProfile },
+  { "XBMC.GetThreads",                              CXBMCOperations::GetThreads }
 };
 
 JSONSchemaTypeDefinition::JSONSchemaTypeDefinition()
@@ -9,8 +9,10 @@
 #include "XBMCOperations.h"
 
 #include "ServiceBroker.h"
+#include "dbwrappers/DatabaseProfiler.h"
 #include "messaging/ApplicationMessenger.h"
 #include "powermanagement/PowerManager.h"
+#include "threads/Thread.h"
 #include "utils/Variant.h"
 
 using namespace JSONRPC;
@@ -85,3 +87,48 @@ JSONRPC_STATUS CXBMCOperations::GetInfoBooleans(const std::string &method, ITran
 
   return OK;
 }
+
+JSONRPC_STATUS CXBMCOperations::GetDatabaseProfile(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  CDatabaseProfiler& profiler = CDatabaseProfiler::GetInstance();
+
+  result["enabled"] = profiler.IsEnabled();
+  result["statements"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto& stats : profiler.GetStatistics())
+  {
+    CVariant statement(CVariant::VariantTypeObject);
+    statement["statement"] = stats.fingerprint;
+    statement["count"] = stats.count;
+    statement["rows"] = stats.rows;
+    statement["totaltime"] = stats.total.count() / 1000.0;
+    statement["averagetime"] = stats.total.count() / 1000.0 / stats.count;
+    statement["p99time"] = stats.p99.count() / 1000.0;
+    statement["maxtime"] = stats.max.count() / 1000.0;
+    statement["plan"] = stats.plan;
+    result["statements"].push_back(statement);
+  }
+
+  if (parameterObject["reset"].asBoolean())
+    profiler.Reset();
+
+  return OK;
+}
+
+JSONRPC_STATUS CXBMCOperations::GetThreads(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  result["threads"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto& info : CThread::GetRunningThreads())
+  {
+    CVariant thread(CVariant::VariantTypeObject);
+    thread["name"] = info.name;
+    thread["role"] = CThreadPolicy::GetRoleName(info.role);
+    thread["id"] = info.nativeId;
+    thread["priority"] = info.priority;
+    thread["cputime"] = info.cpuTime / 10000.0;
+    thread["voluntaryswitches"] = info.voluntarySwitches;
+    thread["involuntaryswitches"] = info.involuntarySwitches;
+    result["threads"].push_back(thread);
+  }
+
+  return OK;
+}
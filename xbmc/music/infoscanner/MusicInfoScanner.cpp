@@ -14,6 +14,7 @@
 #include "MusicAlbumInfo.h"
 #include "MusicInfoScraper.h"
 #include "NfoFile.h"
+#include "ScanChangeIndex.h"
 #include "ServiceBroker.h"
 #include "TextureCache.h"
 #include "Util.h"
@@ -50,9 +51,13 @@
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <utility>
 
 using namespace MUSIC_INFO;
@@ -122,6 +127,12 @@ void CMusicInfoScanner::Process()
       m_bCanInterrupt = false;
       m_needsCleanup = false;
 
+      if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bMusicLibraryUseFastHash)
+      {
+        m_changeIndex.reset(new CScanChangeIndex("special://database/MusicScanIndex.json"));
+        m_changeIndex->Load();
+      }
+
       bool commit = true;
       for (const auto& it : m_pathsToScan)
       {
@@ -144,6 +155,9 @@ void CMusicInfoScanner::Process()
         bool scancomplete = DoScan(it);
         if (scancomplete)
         {
+          if (m_changeIndex)
+            m_changeIndex->Prune(it);
+
           if (m_albumsAdded.size() > 0)
           {
             // Set local art for added album disc sets and primary album artists
@@ -190,6 +204,12 @@ void CMusicInfoScanner::Process()
 
       m_fileCountReader.StopThread();
 
+      if (m_changeIndex)
+      {
+        m_changeIndex->Save();
+        m_changeIndex.reset();
+      }
+
       m_musicDatabase.EmptyCache();
 
       tick = XbmcThreads::SystemClockMillis() - tick;
@@ -478,9 +498,9 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   m_seenPaths.insert(strDirectory);
 
   // Discard all excluded files defined by m_musicExcludeRegExps
-  const std::vector<std::string> &regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
+  const std::shared_ptr<const CRegExpSet> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExpSet;
 
-  if (CUtil::ExcludeFileOrFolder(strDirectory, regexps))
+  if (CUtil::ExcludeFileOrFolder(strDirectory, *regexps))
     return true;
 
   if (HasNoMedia(strDirectory))
@@ -488,17 +508,43 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
 
   // load subfolder
   CFileItemList items;
-  CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetMusicExtensions() + "|.jpg|.tbn|.lrc|.cdg", DIR_FLAG_DEFAULTS);
-
-  // sort and get the path hash.  Note that we don't filter .cue sheet items here as we want
-  // to detect changes in the .cue sheet as well.  The .cue sheet items only need filtering
-  // if we have a changed hash.
-  items.Sort(SortByLabel, SortOrderAscending);
   std::string hash;
-  GetPathHash(items, hash);
+  std::string dbHash;
+  CScanChangeIndex::Folder indexed;
+  bool fromIndex = false;
+  if (m_changeIndex && !(m_flags & SCAN_RESCAN) &&
+      m_musicDatabase.GetPathHash(strDirectory, dbHash) &&
+      m_changeIndex->IsUnchanged(strDirectory, indexed))
+  { // folder and files untouched since the last scan - rebuild the listing from the index
+    for (const auto& entry : indexed.entries)
+    {
+      CFileItemPtr item(new CFileItem(entry.path, entry.folder));
+      item->m_dwSize = entry.size;
+      if (entry.mtime)
+        item->m_dateTime = static_cast<time_t>(entry.mtime);
+      items.Add(item);
+    }
+    items.SetPath(strDirectory);
+    hash = dbHash;
+    fromIndex = true;
+  }
+  else
+  {
+    CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetMusicExtensions() + "|.jpg|.tbn|.lrc|.cdg", DIR_FLAG_DEFAULTS);
+
+    // sort and get the path hash.  Note that we don't filter .cue sheet items here as we want
+    // to detect changes in the .cue sheet as well.  The .cue sheet items only need filtering
+    // if we have a changed hash.
+    items.Sort(SortByLabel, SortOrderAscending);
+    GetPathHash(items, hash);
+  }
+
+  // keep the unfiltered listing for the change index
+  CFileItemList listing;
+  if (m_changeIndex)
+    listing.Assign(items);
 
   // check whether we need to rescan or not
-  std::string dbHash;
   if ((m_flags & SCAN_RESCAN) || !m_musicDatabase.GetPathHash(strDirectory, dbHash) || !StringUtils::EqualsNoCase(dbHash, hash))
   { // path has changed - rescan
     if (dbHash.empty())
@@ -522,10 +568,14 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
 
     // save information about this folder
     m_musicDatabase.SetPathHash(strDirectory, hash);
+    if (m_changeIndex)
+      UpdateChangeIndex(strDirectory, listing);
   }
   else
   { // path is the same - no need to rescan
     CLog::Log(LOGDEBUG, "%s Skipping dir '%s' due to no change", __FUNCTION__, CURL::GetRedacted(strDirectory).c_str());
+    if (m_changeIndex && !fromIndex)
+      UpdateChangeIndex(strDirectory, listing);
     m_currentItem += CountFiles(items, false);  // false for non-recursive
 
     // updated the dialog with our progress
@@ -557,33 +607,124 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   return !m_bStop;
 }
 
+namespace
+{
+void LoadTag(CFileItem& item)
+{
+  CMusicInfoTag& tag = *item.GetMusicInfoTag();
+  if (!tag.Loaded())
+  {
+    std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(item));
+    if (nullptr != pLoader)
+      pLoader->Load(item.GetPath(), tag);
+  }
+}
+
+/*! \brief State shared between the scanner thread and the tag reader jobs.
+ Jobs may start after the scanner has finished the batch on its own, so they only ever
+ touch this (reference counted) state and never the scanner itself.
+ */
+struct TagReadBatch
+{
+  explicit TagReadBatch(const std::vector<CFileItemPtr>& items) : files(items) {}
+
+  // claim and read files until none are left, skipping the remaining reads once stopped
+  void Run(const std::function<bool()>& stopped)
+  {
+    for (size_t i = next++; i < files.size(); i = next++)
+    {
+      if (!cancelled && stopped())
+        cancelled = true;
+      if (!cancelled)
+        LoadTag(*files[i]);
+      if (++finished == files.size())
+        done.Set();
+    }
+  }
+
+  const std::vector<CFileItemPtr> files;
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> finished{0};
+  std::atomic<bool> cancelled{false};
+  CEvent done{true};
+};
+}
+
+void CMusicInfoScanner::LoadTags(const std::vector<CFileItemPtr>& files)
+{
+  if (files.empty())
+    return;
+
+  const size_t threads = std::min(files.size(),
+    static_cast<size_t>(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iMusicLibraryTagReaderThreads));
+
+  std::shared_ptr<TagReadBatch> batch = std::make_shared<TagReadBatch>(files);
+
+  // a queue of its own lets the job manager throttle the readers during playback
+  if (threads > 1 && !m_tagReaders)
+  {
+    const int maxThreads = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iMusicLibraryTagReaderThreads;
+    m_tagReaders.reset(new CJobQueue(false, static_cast<unsigned int>(std::max(maxThreads - 1, 1)),
+                                     CJob::PRIORITY_NORMAL, true));
+  }
+  for (size_t i = 1; i < threads; ++i)
+    m_tagReaders->Submit([batch]() { batch->Run([]() { return false; }); });
+
+  // the scanner thread reads tags as well, so the batch completes even when all job workers are busy
+  batch->Run([this]() { return m_bStop; });
+  while (!batch->done.WaitMSec(100))
+  {
+    if (m_bStop)
+      batch->cancelled = true;
+  }
+}
+
+void CMusicInfoScanner::UpdateChangeIndex(const std::string& strDirectory, const CFileItemList& items)
+{
+  const CScanChangeIndex::Changes changes = m_changeIndex->Update(strDirectory, items);
+  if (changes.Empty())
+    return;
+
+  CLog::Log(LOGDEBUG, "%s Dir '%s' has %zu added, %zu removed and %zu modified entries", __FUNCTION__,
+            CURL::GetRedacted(strDirectory).c_str(), changes.added.size(), changes.removed.size(),
+            changes.modified.size());
+  for (const auto& path : changes.added)
+    CLog::Log(LOGDEBUG, "%s   added '%s'", __FUNCTION__, CURL::GetRedacted(path).c_str());
+  for (const auto& path : changes.removed)
+    CLog::Log(LOGDEBUG, "%s   removed '%s'", __FUNCTION__, CURL::GetRedacted(path).c_str());
+  for (const auto& path : changes.modified)
+    CLog::Log(LOGDEBUG, "%s   modified '%s'", __FUNCTION__, CURL::GetRedacted(path).c_str());
+}
+
 CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
                                                    CFileItemList& scannedItems)
 {
-  std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
+  const std::shared_ptr<const CRegExpSet> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExpSet;
 
+  std::vector<CFileItemPtr> files;
   for (int i = 0; i < items.Size(); ++i)
   {
-    if (m_bStop)
-      return INFO_CANCELLED;
-
     CFileItemPtr pItem = items[i];
 
-    if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
+    if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), *regexps))
       continue;
 
     if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics())
       continue;
 
+    files.push_back(pItem);
+  }
+
+  LoadTags(files);
+
+  for (const auto& pItem : files)
+  {
+    if (m_bStop)
+      return INFO_CANCELLED;
+
     m_currentItem++;
 
     CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
-    {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (nullptr != pLoader)
-        pLoader->Load(pItem->GetPath(), tag);
-    }
 
     if (m_handle && m_itemCount>0)
       m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
@@ -16,9 +16,13 @@
 #include "threads/Thread.h"
 #include "utils/ScraperUrl.h"
 
+#include <memory>
+
 class CAlbum;
 class CArtist;
 class CGUIDialogProgressBarHandle;
+class CJobQueue;
+class CScanChangeIndex;
 
 namespace MUSIC_INFO
 {
@@ -231,6 +235,20 @@ protected:
    \param scannedItems [in] list to populate with the scannedItems
    */
   INFO_RET ScanTags(const CFileItemList& items, CFileItemList& scannedItems);
+
+  /*! \brief Read the tags of a set of files concurrently
+   Tags are read on up to <tagreaderthreads> threads (the calling thread included), which
+   hides the per-file latency of network shares. Returns once every file has been handled
+   or the scan has been stopped; files skipped due to a stop have no loaded tag.
+   \param files [in] the files to read tags from
+   */
+  void LoadTags(const std::vector<CFileItemPtr>& files);
+
+  /*! \brief Record the listing of a scanned folder in the change index and log what changed
+   \param strDirectory [in] the scanned folder
+   \param items [in] the unfiltered listing of the folder
+   */
+  void UpdateChangeIndex(const std::string& strDirectory, const CFileItemList& items);
   int GetPathHash(const CFileItemList &items, std::string &hash);
 
   void Run() override;
@@ -255,6 +273,8 @@ protected:
   int m_scanType = 0; // 0 - load from files, 1 - albums, 2 - artists
   int m_idSourcePath;
   CMusicDatabase m_musicDatabase;
+  std::unique_ptr<CScanChangeIndex> m_changeIndex;
+  std::unique_ptr<CJobQueue> m_tagReaders; // created on first use, throttled during playback
 
   std::set<int> m_albumsAdded;
 
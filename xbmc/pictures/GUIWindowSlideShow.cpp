@@ -17,6 +17,7 @@
 #include "ServiceBroker.h"
 #include "TextureDatabase.h"
 #include "URL.h"
+#include "cores/SwsContextCache.h"
 #include "filesystem/Directory.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUILabelControl.h"
@@ -255,6 +256,7 @@ void CGUIWindowSlideShow::OnDeinitWindow(int nextWindowID)
     // and close the images.
     m_Image[0].Close();
     m_Image[1].Close();
+    CSwsContextCache::Clear();
   }
   CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPicturesInfoProvider().SetCurrentSlide(nullptr);
   m_bSlideShow = false;
@@ -12,11 +12,9 @@
 #include "filesystem/File.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
-#include "utils/XBMCTinyXML.h"
-#include "utils/XMLUtils.h"
+#include "utils/XmlPullParser.h"
 #include "utils/log.h"
 
-#include <iostream>
 #include <string>
 
 using namespace XFILE;
@@ -46,52 +44,65 @@ CPlayListWPL::CPlayListWPL(void) = default;
 CPlayListWPL::~CPlayListWPL(void) = default;
 
 
-bool CPlayListWPL::LoadData(std::istream& stream)
+bool CPlayListWPL::LoadData(const std::string& strData)
 {
-  CXBMCTinyXML xmlDoc;
+  CXmlPullParser parser(strData);
 
-  stream >> xmlDoc;
-  if (xmlDoc.Error())
+  // <smil>
+  if (!parser.NextChildElement(0))
   {
-    CLog::Log(LOGERROR, "Unable to parse B4S info Error: %s", xmlDoc.ErrorDesc());
+    if (parser.HasError())
+      CLog::Log(LOGERROR, "Unable to parse WPL info Error: %s", parser.GetErrorDesc());
     return false;
   }
 
-  TiXmlElement* pRootElement = xmlDoc.RootElement();
-  if (!pRootElement ) return false;
-
-  TiXmlElement* pHeadElement = pRootElement->FirstChildElement("head");
-  if (pHeadElement )
+  bool hasBody = false;
+  bool hasMedia = false;
+  while (parser.NextChildElement(1))
   {
-    TiXmlElement* pTitelElement = pHeadElement->FirstChildElement("title");
-    if (pTitelElement )
-      m_strPlayListName = pTitelElement->Value();
+    if (parser.GetName() == "head")
+    {
+      while (parser.NextChildElement(2))
+      {
+        if (parser.GetName() == "title" && m_strPlayListName.empty())
+          parser.ReadElementText(m_strPlayListName);
+      }
+    }
+    else if (parser.GetName() == "body" && !hasBody)
+    {
+      hasBody = true;
+      bool hasSeq = false;
+      while (parser.NextChildElement(2))
+      {
+        if (parser.GetName() != "seq" || hasSeq)
+          continue;
+
+        hasSeq = true;
+        while (parser.NextChildElement(3))
+        {
+          hasMedia = true;
+          std::string strFileName = parser.GetAttribute("src");
+          if (!strFileName.empty())
+          {
+            std::string strFileNameClean = URIUtils::SubstitutePath(strFileName);
+            CUtil::GetQualifiedFilename(m_strBasePath, strFileNameClean);
+            std::string strDescription = URIUtils::GetFileName(strFileNameClean);
+            CFileItemPtr newItem(new CFileItem(strDescription));
+            newItem->SetPath(strFileNameClean);
+            Add(newItem);
+          }
+        }
+      }
+    }
   }
 
-  TiXmlElement* pBodyElement = pRootElement->FirstChildElement("body");
-  if (!pBodyElement ) return false;
-
-  TiXmlElement* pSeqElement = pBodyElement->FirstChildElement("seq");
-  if (!pSeqElement ) return false;
-
-  TiXmlElement* pMediaElement = pSeqElement->FirstChildElement("media");
-
-  if (!pMediaElement) return false;
-  while (pMediaElement)
+  if (parser.HasError())
   {
-    std::string strFileName = XMLUtils::GetAttribute(pMediaElement, "src");
-    if (!strFileName.empty())
-    {
-      std::string strFileNameClean = URIUtils::SubstitutePath(strFileName);
-      CUtil::GetQualifiedFilename(m_strBasePath, strFileNameClean);
-      std::string strDescription = URIUtils::GetFileName(strFileNameClean);
-      CFileItemPtr newItem(new CFileItem(strDescription));
-      newItem->SetPath(strFileNameClean);
-      Add(newItem);
-    }
-    pMediaElement = pMediaElement->NextSiblingElement();
+    CLog::Log(LOGERROR, "Unable to parse WPL info Error: %s", parser.GetErrorDesc());
+    return false;
   }
-  return true;
+
+  return hasMedia;
 }
 
 void CPlayListWPL::Save(const std::string& strFileName) const
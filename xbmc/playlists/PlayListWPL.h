@@ -19,7 +19,8 @@ class CPlayListWPL :
 public:
   CPlayListWPL(void);
   ~CPlayListWPL(void) override;
-  bool LoadData(std::istream& stream) override;
+  using CPlayList::LoadData;
+  bool LoadData(const std::string& strData) override;
   void Save(const std::string& strFileName) const override;
 };
 }
@@ -10,8 +10,9 @@
 #include "PlayListXSPF.h"
 
 #include "URL.h"
+#include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
-#include "utils/XBMCTinyXML.h"
+#include "utils/XmlPullParser.h"
 #include "utils/log.h"
 
 using namespace PLAYLIST;
@@ -25,18 +26,6 @@ constexpr char const* TITLE_TAGNAME = "title";
 constexpr char const* TRACK_TAGNAME = "track";
 constexpr char const* TRACKLIST_TAGNAME = "trackList";
 
-std::string GetXMLText(const TiXmlElement* pXmlElement)
-{
-  std::string result;
-  if (pXmlElement)
-  {
-    const char* const innerText = pXmlElement->GetText();
-    if (innerText)
-      result = innerText;
-  }
-  return result;
-}
-
 }
 
 CPlayListXSPF::CPlayListXSPF(void) = default;
@@ -45,83 +34,109 @@ CPlayListXSPF::~CPlayListXSPF(void) = default;
 
 bool CPlayListXSPF::Load(const std::string& strFileName)
 {
-  CXBMCTinyXML xmlDoc;
+  CXmlPullParser parser;
+  if (!parser.LoadFile(strFileName))
+  {
+    CLog::Log(LOGERROR, "Error reading XML file %s", strFileName.c_str());
+    return false;
+  }
 
-  if (!xmlDoc.LoadFile(strFileName))
+  if (!parser.NextChildElement(0) || parser.GetName() != PLAYLIST_TAGNAME)
   {
-    CLog::Log(LOGERROR, "Error parsing XML file %s (%d, %d): %s", strFileName.c_str(), xmlDoc.ErrorRow(), xmlDoc.ErrorCol(), xmlDoc.ErrorDesc());
+    if (parser.HasError())
+      CLog::Log(LOGERROR, "Error parsing XML file %s (%d, %d): %s", strFileName.c_str(), parser.GetErrorRow(), parser.GetErrorCol(), parser.GetErrorDesc());
+    else
+      CLog::Log(LOGERROR, "Error parsing XML file %s: missing root element %s", strFileName.c_str(), PLAYLIST_TAGNAME);
     return false;
   }
 
-  TiXmlElement* pPlaylist = xmlDoc.FirstChildElement(PLAYLIST_TAGNAME);
-  if (!pPlaylist)
+  Clear();
+  URIUtils::GetParentPath(strFileName, m_strBasePath);
+
+  bool hasTracklist = false;
+  while (parser.NextChildElement(1))
   {
-    CLog::Log(LOGERROR, "Error parsing XML file %s: missing root element %s", strFileName.c_str(), PLAYLIST_TAGNAME);
+    if (parser.GetName() == TITLE_TAGNAME && m_strPlayListName.empty())
+      parser.ReadElementText(m_strPlayListName);
+    else if (parser.GetName() == TRACKLIST_TAGNAME && !hasTracklist)
+    {
+      hasTracklist = true;
+      while (parser.NextChildElement(2))
+      {
+        if (parser.GetName() == TRACK_TAGNAME)
+          LoadTrack(parser);
+      }
+    }
+  }
+
+  if (parser.HasError())
+  {
+    CLog::Log(LOGERROR, "Error parsing XML file %s (%d, %d): %s", strFileName.c_str(), parser.GetErrorRow(), parser.GetErrorCol(), parser.GetErrorDesc());
+    Clear();
     return false;
   }
 
-  TiXmlElement* pTracklist = pPlaylist->FirstChildElement(TRACKLIST_TAGNAME);
-  if (!pTracklist)
+  if (!hasTracklist)
   {
     CLog::Log(LOGERROR, "Error parsing XML file %s: missing element %s", strFileName.c_str(), TRACKLIST_TAGNAME);
+    Clear();
     return false;
   }
 
-  Clear();
-  URIUtils::GetParentPath(strFileName, m_strBasePath);
-
-  m_strPlayListName = GetXMLText(pPlaylist->FirstChildElement(TITLE_TAGNAME));
+  return true;
+}
 
-  TiXmlElement* pCurTrack = pTracklist->FirstChildElement(TRACK_TAGNAME);
-  while (pCurTrack)
+void CPlayListXSPF::LoadTrack(CXmlPullParser& parser)
+{
+  std::string location;
+  std::string label;
+  while (parser.NextChildElement(3))
   {
-    std::string location = GetXMLText(pCurTrack->FirstChildElement(LOCATION_TAGNAME));
-    if (!location.empty())
-    {
-      std::string label = GetXMLText(pCurTrack->FirstChildElement(TITLE_TAGNAME));
+    if (parser.GetName() == LOCATION_TAGNAME && location.empty())
+      parser.ReadElementText(location);
+    else if (parser.GetName() == TITLE_TAGNAME && label.empty())
+      parser.ReadElementText(label);
+  }
 
-      CFileItemPtr newItem(new CFileItem(label));
+  if (location.empty())
+    return;
 
-      CURL uri(location);
+  CFileItemPtr newItem(new CFileItem(label));
 
-      // at the time of writing CURL doesn't handle file:// URI scheme the way
-      // it's presented in this format, parse to local path instead
-      std::string localpath;
-      if (StringUtils::StartsWith(location, "file:///"))
-      {
+  CURL uri(location);
+
+  // at the time of writing CURL doesn't handle file:// URI scheme the way
+  // it's presented in this format, parse to local path instead
+  std::string localpath;
+  if (StringUtils::StartsWith(location, "file:///"))
+  {
 #ifndef TARGET_WINDOWS
-        // Linux absolute path must start with root
-        localpath = "/";
+    // Linux absolute path must start with root
+    localpath = "/";
 #endif
-        // Path starts after "file:///"
-        localpath += CURL::Decode(location.substr(8));
-      }
-      else if (uri.GetProtocol().empty())
-      {
-        localpath = URIUtils::AppendSlash(m_strBasePath) + CURL::Decode(location);
-      }
+    // Path starts after "file:///"
+    localpath += CURL::Decode(location.substr(8));
+  }
+  else if (uri.GetProtocol().empty())
+  {
+    localpath = URIUtils::AppendSlash(m_strBasePath) + CURL::Decode(location);
+  }
 
-      if (!localpath.empty())
-      {
-        // We don't use URIUtils::CanonicalizePath because m_strBasePath may be a
-        // protocol e.g. smb
+  if (!localpath.empty())
+  {
+    // We don't use URIUtils::CanonicalizePath because m_strBasePath may be a
+    // protocol e.g. smb
 #ifdef TARGET_WINDOWS
-        StringUtils::Replace(localpath, "/", "\\");
+    StringUtils::Replace(localpath, "/", "\\");
 #endif
-        localpath = URIUtils::GetRealPath(localpath);
-
-        newItem->SetPath(localpath);
-      }
-      else
-      {
-        newItem->SetURL(uri);
-      }
+    localpath = URIUtils::GetRealPath(localpath);
 
-      Add(newItem);
-    }
-
-    pCurTrack = pCurTrack->NextSiblingElement(TRACK_TAGNAME);
+    newItem->SetPath(localpath);
+  }
+  else
+  {
+    newItem->SetURL(uri);
   }
 
-  return true;
+  Add(newItem);
 }
@@ -10,6 +10,8 @@
 
 #include "PlayList.h"
 
+class CXmlPullParser;
+
 namespace PLAYLIST
 {
 class CPlayListXSPF : public CPlayList
@@ -20,5 +22,8 @@ public:
 
   // Implementation of CPlayList
   bool Load(const std::string& strFileName) override;
+
+private:
+  void LoadTrack(CXmlPullParser& parser);
 };
 }
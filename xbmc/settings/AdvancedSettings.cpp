@@ -22,7 +22,9 @@
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingDefinitions.h"
 #include "settings/lib/SettingsManager.h"
+#include "threads/Thread.h"
 #include "utils/LangCodeExpander.h"
+#include "utils/RegExp.h"
 #include "utils/StringUtils.h"
 #include "utils/SystemInfo.h"
 #include "utils/URIUtils.h"
@@ -43,6 +45,7 @@ CAdvancedSettings::CAdvancedSettings()
 {
   m_initialized = false;
   m_fullScreen = false;
+  CompileExcludeRegExps();
 }
 
 void CAdvancedSettings::OnSettingsLoaded()
@@ -115,6 +118,7 @@ void CAdvancedSettings::Initialize()
     return;
 
   m_audioApplyDrc = -1.0f;
+  m_audioDecodeAheadMemory = 8;
   m_VideoPlayerIgnoreDTSinWAV = false;
 
   //default hold time of 25 ms, this allows a 20 hertz sine to pass undistorted
@@ -155,6 +159,9 @@ void CAdvancedSettings::Initialize()
   m_videoFpsDetect = 1;
   m_maxTempo = 1.55f;
   m_videoPreferStereoStream = false;
+  m_videoTrickplayInterval = 0;
+  m_videoTrickplayWidth = 320;
+  m_videoDecoderThreads = 0;
 
   m_videoDefaultLatency = 0.0;
 
@@ -284,6 +291,8 @@ void CAdvancedSettings::Initialize()
   m_videoItemSeparator = " / ";
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
   m_bMusicLibraryUseISODates = false;
+  m_iMusicLibraryTagReaderThreads = 4;
+  m_bMusicLibraryUseFastHash = false;
 
   m_bVideoLibraryAllItemsOnBottom = false;
   m_iVideoLibraryRecentlyAddedItems = 25;
@@ -292,6 +301,7 @@ void CAdvancedSettings::Initialize()
   m_bVideoLibraryImportWatchedState = false;
   m_bVideoLibraryImportResumePoint = false;
   m_bVideoScannerIgnoreErrors = false;
+  m_iVideoScannerPrefetchThreads = 4;
   m_iVideoLibraryDateAdded = 1; // prefer mtime over ctime and current time
 
   m_videoEpisodeExtraArt = {};
@@ -403,6 +413,9 @@ void CAdvancedSettings::Initialize()
 
   m_useLocaleCollation = true;
 
+  m_databaseProfilerEnabled = false;
+  m_databaseProfilerExplainThreshold = 50;
+
   m_pictureExtensions = ".png|.jpg|.jpeg|.bmp|.gif|.ico|.tif|.tiff|.tga|.pcx|.cbz|.zip|.rss|.webp|.jp2|.apng";
   m_musicExtensions = ".nsv|.m4a|.flac|.aac|.strm|.pls|.rm|.rma|.mpa|.wav|.wma|.ogg|.mp3|.mp2|.m3u|.gdm|.imf|.m15|.sfx|.uni|.ac3|.dts|.cue|.aif|.aiff|.wpl|.xspf|.ape|.mac|.mpc|.mp+|.mpp|.shn|.zip|.wv|.dsp|.xsp|.xwav|.waa|.wvs|.wam|.gcm|.idsp|.mpdsp|.mss|.spt|.rsd|.sap|.cmc|.cmr|.dmc|.mpt|.mpd|.rmt|.tmc|.tm8|.tm2|.oga|.url|.pxml|.tta|.rss|.wtv|.mka|.tak|.opus|.dff|.dsf|.m4b|.dtshd";
   m_videoExtensions = ".m4v|.3g2|.3gp|.nsv|.tp|.ts|.ty|.strm|.pls|.rm|.rmvb|.mpd|.m3u|.m3u8|.ifo|.mov|.qt|.divx|.xvid|.bivx|.vob|.nrg|.img|.iso|.udf|.pva|.wmv|.asf|.asx|.ogm|.m2v|.avi|.bin|.dat|.mpg|.mpeg|.mp4|.mkv|.mk3d|.avc|.vp3|.svq3|.nuv|.viv|.dv|.fli|.flv|.001|.wpl|.xspf|.zip|.vdr|.dvr-ms|.xsp|.mts|.m2t|.m2ts|.evo|.ogv|.sdp|.avs|.rec|.url|.pxml|.vc1|.h264|.rcv|.rss|.mpls|.mpl|.webm|.bdmv|.bdm|.wtv|.trp|.f4v";
@@ -420,6 +433,8 @@ void CAdvancedSettings::Initialize()
   m_videoAssFixedWorks = false;
 
   m_logLevelHint = m_logLevel = LOG_LEVEL_NORMAL;
+  m_logAsync = false;
+  m_logBufferSize = 1024;
 
   m_openGlDebugging = false;
 
@@ -427,6 +442,8 @@ void CAdvancedSettings::Initialize()
 
   m_nfsTimeout = 5;
 
+  CompileExcludeRegExps();
+
   m_initialized = true;
 }
 
@@ -446,6 +463,8 @@ bool CAdvancedSettings::Load(const CProfileManager &profileManager)
   if (!m_discStubExtensions.empty())
     m_videoExtensions += "|" + m_discStubExtensions;
 
+  CompileExcludeRegExps();
+
   return true;
 }
 
@@ -554,6 +573,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
       GetCustomRegexps(pAudioExcludes, m_audioExcludeFromScanRegExps);
 
     XMLUtils::GetFloat(pElement, "applydrc", m_audioApplyDrc);
+    XMLUtils::GetInt(pElement, "decodeaheadmemory", m_audioDecodeAheadMemory, 0, 256);
     XMLUtils::GetBoolean(pElement, "VideoPlayerignoredtsinwav", m_VideoPlayerIgnoreDTSinWAV);
 
     XMLUtils::GetFloat(pElement, "limiterhold", m_limiterHold, 0.0f, 100.0f);
@@ -706,6 +726,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "fpsdetect", m_videoFpsDetect, 0, 2);
     XMLUtils::GetFloat(pElement, "maxtempo", m_maxTempo, 1.5, 2.1);
     XMLUtils::GetBoolean(pElement, "preferstereostream", m_videoPreferStereoStream);
+    XMLUtils::GetInt(pElement, "trickplayinterval", m_videoTrickplayInterval, 0, 600);
+    XMLUtils::GetInt(pElement, "trickplaywidth", m_videoTrickplayWidth, 64, 1920);
+    XMLUtils::GetInt(pElement, "decoderthreads", m_videoDecoderThreads, 0, 64);
 
     // Store global display latency settings
     TiXmlElement* pVideoLatency = pElement->FirstChildElement("latency");
@@ -757,6 +780,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
     XMLUtils::GetBoolean(pElement, "useisodates", m_bMusicLibraryUseISODates);
+    XMLUtils::GetInt(pElement, "tagreaderthreads", m_iMusicLibraryTagReaderThreads, 1, 16);
+    XMLUtils::GetBoolean(pElement, "usefasthash", m_bMusicLibraryUseFastHash);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
     if (separators)
@@ -799,6 +824,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   if (pElement)
   {
     XMLUtils::GetBoolean(pElement, "ignoreerrors", m_bVideoScannerIgnoreErrors);
+    XMLUtils::GetInt(pElement, "prefetchthreads", m_iVideoScannerPrefetchThreads, 0, 16);
   }
 
   // Backward-compatibility of ExternalPlayer config
@@ -876,6 +902,49 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     CServiceBroker::GetLogging().SetLogLevel(m_logLevel);
   }
 
+  pElement = pRootElement->FirstChildElement("logging");
+  if (pElement)
+  {
+    XMLUtils::GetBoolean(pElement, "async", m_logAsync);
+    XMLUtils::GetInt(pElement, "buffersize", m_logBufferSize, 64, 65536);
+  }
+  CServiceBroker::GetLogging().SetAsyncLogging(m_logAsync, m_logBufferSize * 1024);
+
+  pElement = pRootElement->FirstChildElement("threads");
+  if (pElement)
+  {
+    const TiXmlElement* pRole = pElement->FirstChildElement("role");
+    while (pRole)
+    {
+      const std::string name = XMLUtils::GetAttribute(pRole, "name");
+      ThreadRole role;
+      if (CThreadPolicy::GetRoleByName(name, role))
+      {
+        ThreadRolePolicy policy = CThreadPolicy::GetPolicy(role);
+        int priority;
+        if (XMLUtils::GetInt(pRole, "priority", priority, CThread::GetMinPriority(),
+                             CThread::GetMaxPriority()))
+        {
+          policy.hasPriority = true;
+          policy.priority = priority;
+        }
+        XMLUtils::GetBoolean(pRole, "realtime", policy.realtime);
+
+        std::string cpus;
+        if (XMLUtils::GetString(pRole, "cpus", cpus) &&
+            !CThreadPolicy::ParseCpuList(cpus, policy.cpus))
+          CLog::Log(LOGWARNING, "Invalid cpus \"%s\" for thread role \"%s\"", cpus.c_str(),
+                    name.c_str());
+
+        CThreadPolicy::SetPolicy(role, policy);
+      }
+      else
+        CLog::Log(LOGWARNING, "Unknown thread role \"%s\"", name.c_str());
+
+      pRole = pRole->NextSiblingElement("role");
+    }
+  }
+
   XMLUtils::GetString(pRootElement, "cddbaddress", m_cddbAddress);
   XMLUtils::GetBoolean(pRootElement, "addsourceontop", m_addSourceOnTop);
 
@@ -1185,6 +1254,13 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pDatabase, "compression", m_databaseEpg.compression);
   }
 
+  pElement = pRootElement->FirstChildElement("databaseprofiler");
+  if (pElement)
+  {
+    XMLUtils::GetBoolean(pElement, "enabled", m_databaseProfilerEnabled);
+    XMLUtils::GetInt(pElement, "explainthreshold", m_databaseProfilerExplainThreshold, 0, 60000);
+  }
+
   pElement = pRootElement->FirstChildElement("enablemultimediakeys");
   if (pElement)
   {
@@ -1230,6 +1306,7 @@ void CAdvancedSettings::Clear()
   m_audioExcludeFromScanRegExps.clear();
   m_audioExcludeFromListingRegExps.clear();
   m_pictureExcludeFromListingRegExps.clear();
+  CompileExcludeRegExps();
 
   m_pictureExtensions.clear();
   m_musicExtensions.clear();
@@ -1239,6 +1316,25 @@ void CAdvancedSettings::Clear()
   m_userAgent.clear();
 }
 
+void CAdvancedSettings::CompileExcludeRegExps()
+{
+  // the sets are replaced rather than changed, scanners may still use the previous ones
+  auto compile = [](const std::vector<std::string>& regexps)
+  {
+    auto regExpSet = std::make_shared<CRegExpSet>(true, CRegExp::autoUtf8); // case insensitive regex
+    if (!regExpSet->RegComp(regexps))
+      CLog::Log(LOGERROR, "CAdvancedSettings: Invalid exclude RegExp in list");
+    return std::shared_ptr<const CRegExpSet>(std::move(regExpSet));
+  };
+
+  m_videoExcludeFromListingRegExpSet = compile(m_videoExcludeFromListingRegExps);
+  m_moviesExcludeFromScanRegExpSet = compile(m_moviesExcludeFromScanRegExps);
+  m_tvshowExcludeFromScanRegExpSet = compile(m_tvshowExcludeFromScanRegExps);
+  m_audioExcludeFromListingRegExpSet = compile(m_audioExcludeFromListingRegExps);
+  m_audioExcludeFromScanRegExpSet = compile(m_audioExcludeFromScanRegExps);
+  m_pictureExcludeFromListingRegExpSet = compile(m_pictureExcludeFromListingRegExps);
+}
+
 void CAdvancedSettings::GetCustomTVRegexps(TiXmlElement *pRootElement, SETTINGS_TVSHOWLIST& settings)
 {
   TiXmlElement *pElement = pRootElement;
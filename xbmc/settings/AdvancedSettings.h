@@ -13,6 +13,7 @@
 #include "settings/lib/ISettingsHandler.h"
 #include "utils/SortUtils.h"
 
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -26,6 +27,7 @@
 
 class CAppParamParser;
 class CProfileManager;
+class CRegExpSet;
 class CSettingsManager;
 class CVariant;
 struct IntegerSettingOption;
@@ -159,6 +161,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_videoIgnoreSecondsAtStart;
     float m_videoIgnorePercentAtEnd;
     float m_audioApplyDrc;
+    int m_audioDecodeAheadMemory; ///< decoded PCM kept ahead of playback per song, in MB
 
     int   m_videoVDPAUScaling;
     float m_videoNonLinStretchRatio;
@@ -173,6 +176,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int  m_videoFpsDetect;
     float m_maxTempo;
     bool m_videoPreferStereoStream = false;
+    int m_videoTrickplayInterval; //!< seconds between seek preview thumbs, 0 disables seek previews
+    int m_videoTrickplayWidth;
+    int m_videoDecoderThreads; //!< threads shared by all software decoders, 0 derives it from the cpu count
 
     std::string m_videoDefaultPlayer;
     float m_videoPlayCountMinimumPercent;
@@ -184,6 +190,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_songInfoDuration;
     int m_logLevel;
     int m_logLevelHint;
+    bool m_logAsync; //!< Write the log file from a background thread, <log><async>
+    int m_logBufferSize; //!< Maximum size of the asynchronous log queue in KB
     std::string m_cddbAddress;
     bool m_addSourceOnTop; //!< True to put 'add source' buttons on top
 
@@ -204,6 +212,13 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     std::vector<std::string> m_audioExcludeFromListingRegExps;
     std::vector<std::string> m_audioExcludeFromScanRegExps;
     std::vector<std::string> m_pictureExcludeFromListingRegExps;
+    //! the exclude lists above compiled once for CUtil::ExcludeFileOrFolder, never null
+    std::shared_ptr<const CRegExpSet> m_videoExcludeFromListingRegExpSet;
+    std::shared_ptr<const CRegExpSet> m_moviesExcludeFromScanRegExpSet;
+    std::shared_ptr<const CRegExpSet> m_tvshowExcludeFromScanRegExpSet;
+    std::shared_ptr<const CRegExpSet> m_audioExcludeFromListingRegExpSet;
+    std::shared_ptr<const CRegExpSet> m_audioExcludeFromScanRegExpSet;
+    std::shared_ptr<const CRegExpSet> m_pictureExcludeFromListingRegExpSet;
     std::vector<std::string> m_videoStackRegExps;
     std::vector<std::string> m_folderStackRegExps;
     std::vector<std::string> m_trailerMatchRegExps;
@@ -240,6 +255,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bMusicLibraryCleanOnUpdate;
     bool m_bMusicLibraryArtistSortOnUpdate;
     bool m_bMusicLibraryUseISODates;
+    int m_iMusicLibraryTagReaderThreads;
+    bool m_bMusicLibraryUseFastHash;
     std::string m_strMusicLibraryAlbumFormat;
     bool m_prioritiseAPEv2tags;
     std::string m_musicItemSeparator;
@@ -261,6 +278,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     std::vector<std::string> m_videoMusicVideoExtraArt;
 
     bool m_bVideoScannerIgnoreErrors;
+    int m_iVideoScannerPrefetchThreads;
     int m_iVideoLibraryDateAdded;
 
     std::set<std::string> m_vecTokens;
@@ -327,6 +345,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     DatabaseSettings m_databaseVideo; // advanced video database setup
     DatabaseSettings m_databaseTV;    // advanced tv database setup
     DatabaseSettings m_databaseEpg;   /*!< advanced EPG database setup */
+    bool m_databaseProfilerEnabled; /*!< collect timing statistics of database statements */
+    int m_databaseProfilerExplainThreshold; /*!< capture the query plan of statements slower than this (ms), 0 disables */
 
     bool m_useLocaleCollation;
 
@@ -379,6 +399,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
   private:
     void Initialize();
     void Clear();
+    void CompileExcludeRegExps();
     void SetExtraArtwork(const TiXmlElement* arttypes, std::vector<std::string>& artworkMap);
     void MigrateOldArtSettings();
 };
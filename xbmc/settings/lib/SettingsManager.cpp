@@ -51,6 +51,18 @@ bool ParseSettingIdentifier(const std::string& settingId, std::string& categoryT
   return true;
 }
 
+namespace
+{
+
+const TiXmlElement* FindElement(
+    const std::unordered_map<std::string, const TiXmlElement*>& elements, const std::string& key)
+{
+  const auto element = elements.find(key);
+  return element != elements.end() ? element->second : nullptr;
+}
+
+} // unnamed namespace
+
 CSettingsManager::CSettingsManager() : CStaticLoggerBase("CSettingsManager")
 {
 }
@@ -776,12 +788,26 @@ bool CSettingsManager::Deserialize(const TiXmlNode *node, bool &updated, std::ma
 
   CSharedLock lock(m_settingsCritical);
 
+  // index the child elements once instead of searching them for every setting
+  SettingElements elements;
+  for (auto element = node->FirstChildElement(); element != nullptr;
+       element = element->NextSiblingElement())
+  {
+    elements.byName.emplace(element->ValueStr(), element);
+    if (element->ValueStr() == SETTING_XML_ELM_SETTING)
+    {
+      const auto id = element->Attribute(SETTING_XML_ATTR_ID);
+      if (id != nullptr)
+        elements.byId.emplace(id, element);
+    }
+  }
+
   // TODO: ideally this would be done by going through all <setting> elements
   // in node but as long as we have to support the v1- format that's not possible
   for (auto& setting : m_settings)
   {
     bool settingUpdated = false;
-    if (LoadSetting(node, setting.second.setting, settingUpdated))
+    if (LoadSetting(node, setting.second.setting, settingUpdated, &elements))
     {
       updated |= settingUpdated;
       if (loadedSettings != nullptr)
@@ -1045,7 +1071,10 @@ void CSettingsManager::OnSettingsCleared()
     settingsHandler->OnSettingsCleared();
 }
 
-bool CSettingsManager::LoadSetting(const TiXmlNode* node, const SettingPtr& setting, bool& updated)
+bool CSettingsManager::LoadSetting(const TiXmlNode* node,
+                                   const SettingPtr& setting,
+                                   bool& updated,
+                                   const SettingElements* elements /* = nullptr */)
 {
   updated = false;
 
@@ -1064,25 +1093,33 @@ bool CSettingsManager::LoadSetting(const TiXmlNode* node, const SettingPtr& sett
   std::string categoryTag, settingTag;
   if (ParseSettingIdentifier(settingId, categoryTag, settingTag))
   {
-    auto categoryNode = node;
+    const TiXmlNode* categoryNode = node;
     if (!categoryTag.empty())
-      categoryNode = node->FirstChild(categoryTag);
+      categoryNode = elements != nullptr ? FindElement(elements->byName, categoryTag)
+                                         : node->FirstChild(categoryTag);
 
-    if (categoryNode != nullptr)
+    if (categoryNode == node && elements != nullptr)
+      settingElement = FindElement(elements->byName, settingTag);
+    else if (categoryNode != nullptr)
       settingElement = categoryNode->FirstChildElement(settingTag);
   }
 
   if (settingElement == nullptr)
   {
     // check if the setting is stored using its full setting identifier (v2+)
-    settingElement = node->FirstChildElement(SETTING_XML_ELM_SETTING);
-    while (settingElement != nullptr)
+    if (elements != nullptr)
+      settingElement = FindElement(elements->byId, settingId);
+    else
     {
-      const auto id = settingElement->Attribute(SETTING_XML_ATTR_ID);
-      if (id != nullptr && settingId.compare(id) == 0)
-        break;
+      settingElement = node->FirstChildElement(SETTING_XML_ELM_SETTING);
+      while (settingElement != nullptr)
+      {
+        const auto id = settingElement->Attribute(SETTING_XML_ATTR_ID);
+        if (id != nullptr && settingId.compare(id) == 0)
+          break;
 
-      settingElement = settingElement->NextSiblingElement(SETTING_XML_ELM_SETTING);
+        settingElement = settingElement->NextSiblingElement(SETTING_XML_ELM_SETTING);
+      }
     }
   }
 
@@ -22,6 +22,7 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -475,7 +476,17 @@ private:
   bool Serialize(TiXmlNode *parent) const;
   bool Deserialize(const TiXmlNode *node, bool &updated, std::map<std::string, std::shared_ptr<CSetting>> *loadedSettings = nullptr);
 
-  bool LoadSetting(const TiXmlNode* node, const std::shared_ptr<CSetting>& setting, bool& updated);
+  // child elements of a node with setting values by name and by setting identifier
+  struct SettingElements
+  {
+    std::unordered_map<std::string, const TiXmlElement*> byName;
+    std::unordered_map<std::string, const TiXmlElement*> byId;
+  };
+
+  bool LoadSetting(const TiXmlNode* node,
+                   const std::shared_ptr<CSetting>& setting,
+                   bool& updated,
+                   const SettingElements* elements = nullptr);
   bool UpdateSetting(const TiXmlNode* node,
                      const std::shared_ptr<CSetting>& setting,
                      const CSettingUpdate& update);
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "NfoFile.h"
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+#include "video/VideoInfoTag.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const char* EPISODE1 = "<episodedetails><title>One</title><episode>1</episode></episodedetails>";
+const char* EPISODE2 = "<episodedetails><title>Two</title><episode>2</episode></episodedetails>";
+} // unnamed namespace
+
+class TestNfoFile : public testing::Test
+{
+protected:
+  ~TestNfoFile() override
+  {
+    if (m_file)
+      XBMC_DELETETEMPFILE(m_file);
+  }
+
+  void LoadNfo(const std::string& content)
+  {
+    ASSERT_NE(nullptr, m_file = XBMC_CREATETEMPFILE(".nfo"));
+    m_file->Close();
+    ASSERT_TRUE(m_file->OpenForWrite(XBMC_TEMPFILEPATH(m_file), true));
+    ASSERT_EQ(static_cast<ssize_t>(content.size()), m_file->Write(content.c_str(), content.size()));
+    m_file->Close();
+    ASSERT_EQ(0, m_nfo.Load(XBMC_TEMPFILEPATH(m_file)));
+  }
+
+  CNfoFile m_nfo;
+  XFILE::CFile* m_file = nullptr;
+};
+
+TEST_F(TestNfoFile, SingleEpisode)
+{
+  LoadNfo(EPISODE1);
+
+  CVideoInfoTag details;
+  EXPECT_TRUE(m_nfo.GetEpisodeDetails(details, 1));
+  EXPECT_EQ("One", details.m_strTitle);
+}
+
+TEST_F(TestNfoFile, SingleEpisodeNumberMismatch)
+{
+  // the only entry of an nfo is used whatever its episode number
+  LoadNfo(EPISODE2);
+
+  CVideoInfoTag details;
+  EXPECT_TRUE(m_nfo.GetEpisodeDetails(details, 1));
+  EXPECT_EQ("Two", details.m_strTitle);
+}
+
+TEST_F(TestNfoFile, SingleEpisodeWithDeclarationNumberMismatch)
+{
+  LoadNfo(std::string("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n") + EPISODE2);
+
+  CVideoInfoTag details;
+  EXPECT_TRUE(m_nfo.GetEpisodeDetails(details, 1));
+  EXPECT_EQ("Two", details.m_strTitle);
+}
+
+TEST_F(TestNfoFile, MultiEpisode)
+{
+  LoadNfo(std::string(EPISODE1) + "\n" + EPISODE2);
+
+  CVideoInfoTag details;
+  EXPECT_TRUE(m_nfo.GetEpisodeDetails(details, 2));
+  EXPECT_EQ("Two", details.m_strTitle);
+  EXPECT_EQ(2, details.m_iEpisode);
+
+  details.Reset();
+  EXPECT_TRUE(m_nfo.GetEpisodeDetails(details, 1));
+  EXPECT_EQ("One", details.m_strTitle);
+}
+
+TEST_F(TestNfoFile, MultiEpisodeNumberMismatch)
+{
+  // no fallback to one of the entries of a multi-episode nfo
+  LoadNfo(std::string(EPISODE1) + "\n" + EPISODE2);
+
+  CVideoInfoTag details;
+  EXPECT_FALSE(m_nfo.GetEpisodeDetails(details, 3));
+  EXPECT_TRUE(details.m_strTitle.empty());
+}
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "ScanChangeIndex.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+CFileItemPtr MakeItem(const std::string& path, int64_t size, time_t mtime, bool folder = false)
+{
+  CFileItemPtr item(new CFileItem(path, folder));
+  item->m_dwSize = size;
+  item->m_dateTime = mtime;
+  return item;
+}
+}
+
+TEST(TestScanChangeIndex, FromItemsSortsAndSkipsParent)
+{
+  CFileItemList items;
+  items.Add(MakeItem("/music/b.flac", 20, 1000));
+  items.Add(MakeItem("/music/a.flac", 10, 1000));
+  CFileItemPtr parent(new CFileItem("/", true));
+  parent->SetLabel("..");
+  items.Add(parent);
+
+  CScanChangeIndex::Folder folder = CScanChangeIndex::FromItems(items, 42);
+  EXPECT_EQ(42, folder.mtime);
+  ASSERT_EQ(2u, folder.entries.size());
+  EXPECT_EQ("/music/a.flac", folder.entries[0].path);
+  EXPECT_EQ(10, folder.entries[0].size);
+  EXPECT_EQ("/music/b.flac", folder.entries[1].path);
+}
+
+TEST(TestScanChangeIndex, Diff)
+{
+  CFileItemList before;
+  before.Add(MakeItem("/music/a.flac", 10, 1000));
+  before.Add(MakeItem("/music/b.flac", 20, 1000));
+  before.Add(MakeItem("/music/c.flac", 30, 1000));
+  before.Add(MakeItem("/music/sub/", 0, 1000, true));
+
+  CFileItemList after;
+  after.Add(MakeItem("/music/a.flac", 10, 1000));
+  after.Add(MakeItem("/music/b.flac", 20, 2000));
+  after.Add(MakeItem("/music/d.flac", 40, 1000));
+  after.Add(MakeItem("/music/sub/", 0, 1000, true));
+
+  CScanChangeIndex::Changes changes = CScanChangeIndex::Diff(
+      CScanChangeIndex::FromItems(before, 1), CScanChangeIndex::FromItems(after, 2));
+
+  ASSERT_EQ(1u, changes.added.size());
+  EXPECT_EQ("/music/d.flac", changes.added[0]);
+  ASSERT_EQ(1u, changes.removed.size());
+  EXPECT_EQ("/music/c.flac", changes.removed[0]);
+  ASSERT_EQ(1u, changes.modified.size());
+  EXPECT_EQ("/music/b.flac", changes.modified[0]);
+}
+
+TEST(TestScanChangeIndex, DiffUnchanged)
+{
+  CFileItemList items;
+  items.Add(MakeItem("/music/a.flac", 10, 1000));
+  items.Add(MakeItem("/music/b.flac", 20, 1000));
+
+  CScanChangeIndex::Folder folder = CScanChangeIndex::FromItems(items, 1);
+  EXPECT_TRUE(CScanChangeIndex::Diff(folder, folder).Empty());
+  EXPECT_FALSE(CScanChangeIndex::Diff(CScanChangeIndex::Folder(), folder).Empty());
+}
+
+TEST(TestScanChangeIndex, IsUnchangedDetectsFilesEditedInPlace)
+{
+  const std::string directory = "special://temp/scanchangeindex/";
+  const std::string path = directory + "a.flac";
+  ASSERT_TRUE(XFILE::CDirectory::Create(directory));
+
+  XFILE::CFile file;
+  ASSERT_TRUE(file.OpenForWrite(path, true));
+  EXPECT_EQ(1, file.Write("a", 1));
+  file.Close();
+
+  CFileItemList items;
+  ASSERT_TRUE(XFILE::CDirectory::GetDirectory(directory, items, "", XFILE::DIR_FLAG_DEFAULTS));
+  CScanChangeIndex index("");
+  index.Update(directory, items);
+
+  CScanChangeIndex::Folder folder;
+  EXPECT_TRUE(index.IsUnchanged(directory, folder));
+  EXPECT_EQ(1u, folder.entries.size());
+
+  // rewriting the file doesn't change the modification time of the folder
+  ASSERT_TRUE(file.OpenForWrite(path, true));
+  EXPECT_EQ(3, file.Write("abc", 3));
+  file.Close();
+  EXPECT_FALSE(index.IsUnchanged(directory, folder));
+
+  XFILE::CDirectory::RemoveRecursive(directory);
+}
+
+TEST(TestScanChangeIndex, PruneRemovesUnseenFolders)
+{
+  const std::string file = "special://temp/scanchangeindex.json";
+  CFileItemList items;
+  items.Add(MakeItem("/music/a/1.flac", 10, 1000));
+  {
+    CScanChangeIndex index(file);
+    index.Update("/music/a/", items);
+    index.Update("/music/b/", items);
+    index.Update("/other/", items);
+    ASSERT_TRUE(index.Save());
+  }
+
+  // a later scan of /music/ only comes across /music/a/
+  CScanChangeIndex index(file);
+  ASSERT_TRUE(index.Load());
+  index.Update("/music/a/", items);
+  index.Prune("/music/");
+
+  // a known folder has no changes for the same listing, all entries of a pruned one are new
+  EXPECT_FALSE(index.Update("/music/b/", items).Empty());
+  EXPECT_TRUE(index.Update("/other/", items).Empty());
+
+  XFILE::CFile::Delete(file);
+}
@@ -12,6 +12,34 @@
 
 #include <algorithm>
 #include <limits>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+// a pause takes from about 10 to about 140 cycles depending on the CPU, so this stays
+// within a microsecond or two even where it is slowest
+constexpr int EVENT_SPIN_COUNT = 32;
+
+int SpinCount()
+{
+  // on a single core spinning only delays the thread which is about to set the event
+  static const int spinCount = std::thread::hardware_concurrency() > 1 ? EVENT_SPIN_COUNT : 0;
+  return spinCount;
+}
+
+inline void CpuRelax()
+{
+#if defined(__SSE2__) || defined(_M_X64)
+  _mm_pause();
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+  __asm__ __volatile__("yield");
+#endif
+}
+} // namespace
 
 void CEvent::addGroup(XbmcThreads::CEventGroup* group)
 {
@@ -20,6 +48,7 @@ void CEvent::addGroup(XbmcThreads::CEventGroup* group)
     groups.reset(new std::vector<XbmcThreads::CEventGroup*>);
 
   groups->push_back(group);
+  hasGroups = true;
 }
 
 void CEvent::removeGroup(XbmcThreads::CEventGroup* group)
@@ -31,6 +60,7 @@ void CEvent::removeGroup(XbmcThreads::CEventGroup* group)
     if (groups->empty())
     {
       groups.reset();
+      hasGroups = false;
     }
   }
 }
@@ -44,12 +74,20 @@ void CEvent::Set()
   // checking the signal and calling wait() on the Wait call in the
   // CEvent class. This now perfectly matches the boost example here:
   // http://www.boost.org/doc/libs/1_41_0/doc/html/thread/synchronization.html#thread.synchronization.condvar_ref
+  bool waiters;
   {
-    CSingleLock slock(mutex);
+    std::unique_lock<std::mutex> slock(mutex);
     signaled = true;
+    waiters = numWaits > 0;
   }
 
-  condVar.notifyAll();
+  if (waiters)
+    condVar.notify_all();
+
+  // a group registers itself before it checks the events under their mutex, so
+  // either it sees the signal or we see the group
+  if (!hasGroups)
+    return;
 
   CSingleLock l(groupListMutex);
   if (groups)
@@ -59,6 +97,39 @@ void CEvent::Set()
   }
 }
 
+void CEvent::spinWait()
+{
+  const int spinCount = SpinCount();
+  for (int i = 0; i < spinCount && !signaled.load(std::memory_order_relaxed); i++)
+    CpuRelax();
+}
+
+bool CEvent::WaitMSec(unsigned int milliSeconds)
+{
+  if (milliSeconds > 0 && !signaled.load(std::memory_order_relaxed))
+    spinWait();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  numWaits++;
+  if (milliSeconds > 0)
+    condVar.wait_for(lock, std::chrono::milliseconds(milliSeconds),
+                     [this] { return signaled.load(); });
+  numWaits--;
+  return prepReturn();
+}
+
+bool CEvent::Wait()
+{
+  if (!signaled.load(std::memory_order_relaxed))
+    spinWait();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  numWaits++;
+  condVar.wait(lock, [this] { return signaled.load(); });
+  numWaits--;
+  return prepReturn();
+}
+
 namespace XbmcThreads
 {
   /**
@@ -96,7 +167,7 @@ namespace XbmcThreads
     signaled = nullptr;
     for (auto* cur : events)
     {
-      CSingleLock lock2(cur->mutex);
+      std::unique_lock<std::mutex> lock2(cur->mutex);
       if (cur->signaled)
         signaled = cur;
     }
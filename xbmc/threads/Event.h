@@ -11,8 +11,12 @@
 #include "threads/Condition.h"
 #include "threads/SingleLock.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <initializer_list>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 // forward declare the CEventGroup
@@ -30,24 +34,24 @@ namespace XbmcThreads
  * in the code that uses this behavior).
  *
  * This class manages 'spurious returns' from the condition variable.
+ *
+ * The state is guarded by a plain std::mutex and std::condition_variable, which map
+ * directly onto futexes on Linux. Wait() and a non-zero WaitMSec() spin briefly before
+ * parking so a Set arriving within a microsecond or so doesn't pay for a sleep and a
+ * wakeup.
  */
 class CEvent
 {
   bool manualReset;
-  volatile bool signaled;
+  std::atomic<bool> signaled;
   unsigned int numWaits = 0;
 
   CCriticalSection groupListMutex; // lock for the groups list
   std::unique_ptr<std::vector<XbmcThreads::CEventGroup*>> groups;
+  std::atomic<bool> hasGroups{false};
 
-  /**
-   * To satisfy the TightConditionVariable requirements and allow the
-   *  predicate being monitored to include both the signaled and interrupted
-   *  states.
-   */
-  XbmcThreads::ConditionVariable actualCv;
-  XbmcThreads::TightConditionVariable<volatile bool&> condVar;
-  CCriticalSection mutex;
+  std::condition_variable condVar;
+  std::mutex mutex;
 
   friend class XbmcThreads::CEventGroup;
 
@@ -57,40 +61,40 @@ class CEvent
   // helper for the two wait methods
   inline bool prepReturn() { bool ret = signaled; if (!manualReset && numWaits == 0) signaled = false; return ret; }
 
+  void spinWait();
+
   CEvent(const CEvent&) = delete;
   CEvent& operator=(const CEvent&) = delete;
 
 public:
   inline CEvent(bool manual = false, bool signaled_ = false) :
-    manualReset(manual), signaled(signaled_), condVar(actualCv,signaled) {}
+    manualReset(manual), signaled(signaled_) {}
 
-  inline void Reset() { CSingleLock lock(mutex); signaled = false; }
+  inline void Reset() { std::unique_lock<std::mutex> lock(mutex); signaled = false; }
   void Set();
 
   /** Returns true if Event has been triggered and not reset, false otherwise. */
-  inline bool Signaled() { CSingleLock lock(mutex); return signaled; }
+  inline bool Signaled() { std::unique_lock<std::mutex> lock(mutex); return signaled; }
 
   /**
    * This will wait up to 'milliSeconds' milliseconds for the Event
    *  to be triggered. The method will return 'true' if the Event
    *  was triggered. Otherwise it will return false.
    */
-  inline bool WaitMSec(unsigned int milliSeconds)
-  { CSingleLock lock(mutex); numWaits++; condVar.wait(mutex,milliSeconds); numWaits--; return prepReturn(); }
+  bool WaitMSec(unsigned int milliSeconds);
 
   /**
    * This will wait for the Event to be triggered. The method will return
    * 'true' if the Event was triggered. If it was either interrupted
    * it will return false. Otherwise it will return false.
    */
-  inline bool Wait()
-  { CSingleLock lock(mutex); numWaits++; condVar.wait(mutex); numWaits--; return prepReturn(); }
+  bool Wait();
 
   /**
    * This is mostly for testing. It allows a thread to make sure there are
    *  the right amount of other threads waiting.
    */
-  inline int getNumWaits() { CSingleLock lock(mutex); return numWaits; }
+  inline int getNumWaits() { std::unique_lock<std::mutex> lock(mutex); return numWaits; }
 
 };
 
@@ -18,6 +18,7 @@
 #include "threads/SystemClock.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <atomic>
 #include <inttypes.h>
 #include <iostream>
@@ -25,6 +26,22 @@
 
 static thread_local CThread* currentThread;
 
+namespace
+{
+// threads which are currently executing, for GetRunningThreads
+CCriticalSection& RunningThreadsLock()
+{
+  static CCriticalSection lock;
+  return lock;
+}
+
+std::vector<CThread*>& RunningThreads()
+{
+  static std::vector<CThread*> threads;
+  return threads;
+}
+} // unnamed namespace
+
 // This is including .cpp code so should be after the other #includes
 #include "threads/platform/ThreadImpl.cpp"
 
@@ -132,6 +149,13 @@ void CThread::Create(bool bAutoDelete)
         autodelete = pThread->m_bAutoDelete;
 
         pThread->SetThreadInfo();
+        pThread->m_nativeId = GetCurrentThreadNativeId();
+        pThread->ApplyRolePolicy();
+
+        {
+          CSingleLock lock(RunningThreadsLock());
+          RunningThreads().push_back(pThread);
+        }
 
         CLog::Log(LOGDEBUG,"Thread %s start, auto delete: %s", name.c_str(), (autodelete ? "true" : "false"));
 
@@ -139,6 +163,12 @@ void CThread::Create(bool bAutoDelete)
 
         pThread->Action();
 
+        {
+          CSingleLock lock(RunningThreadsLock());
+          auto& threads = RunningThreads();
+          threads.erase(std::remove(threads.begin(), threads.end(), pThread), threads.end());
+        }
+
         // lock during termination
         {
           CSingleLock lock(pThread->m_CriticalSection);
@@ -185,6 +215,36 @@ bool CThread::IsRunning() const
     return false;
 }
 
+void CThread::SetRole(ThreadRole role)
+{
+  m_role = role;
+
+  // otherwise it's applied by the thread itself on startup
+  if (IsRunning())
+    ApplyRolePolicy();
+}
+
+std::vector<CThread::ThreadInfo> CThread::GetRunningThreads()
+{
+  std::vector<ThreadInfo> infos;
+
+  CSingleLock lock(RunningThreadsLock());
+  for (CThread* thread : RunningThreads())
+  {
+    ThreadInfo info;
+    info.name = thread->m_ThreadName;
+    info.role = thread->m_role;
+    info.nativeId = thread->m_nativeId;
+    info.priority = thread->GetPriority();
+    info.cpuTime = thread->GetAbsoluteUsage();
+    if (!thread->GetContextSwitches(info.voluntarySwitches, info.involuntarySwitches))
+      info.voluntarySwitches = info.involuntarySwitches = 0;
+    infos.push_back(std::move(info));
+  }
+
+  return infos;
+}
+
 bool CThread::IsAutoDelete() const
 {
   return m_bAutoDelete;
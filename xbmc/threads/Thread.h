@@ -14,6 +14,7 @@
 
 #include "Event.h"
 
+#include "threads/ThreadPolicy.h"
 #include "threads/platform/ThreadImpl.h"
 
 #include <atomic>
@@ -24,6 +25,7 @@
 #include <stdint.h>
 #include <string>
 #include <thread>
+#include <vector>
 
 class IRunnable;
 
@@ -49,6 +51,29 @@ public:
     return std::this_thread::get_id();
   }
 
+  /*!
+   * \brief Set what the thread is used for, the scheduling policy of the role is applied
+   * when the thread starts or right away if it's already running.
+   */
+  void SetRole(ThreadRole role);
+  ThreadRole GetRole() const { return m_role; }
+
+  struct ThreadInfo
+  {
+    std::string name;
+    ThreadRole role;
+    uint64_t nativeId;
+    int priority;
+    int64_t cpuTime; //!< user and system time in 100ns units
+    uint64_t voluntarySwitches;
+    uint64_t involuntarySwitches;
+  };
+
+  /*!
+   * \brief Collect information about all running threads.
+   */
+  static std::vector<ThreadInfo> GetRunningThreads();
+
   // -----------------------------------------------------------------------------------
   // These are platform specific and can be found in ./platform/[platform]/ThreadImpl.cpp
   // -----------------------------------------------------------------------------------
@@ -64,6 +89,7 @@ public:
 
   float GetRelativeUsage();  // returns the relative cpu usage of this thread since last call
   int64_t GetAbsoluteUsage();
+  bool GetContextSwitches(uint64_t& voluntary, uint64_t& involuntary);
   // -----------------------------------------------------------------------------------
 
   static CThread* GetCurrentThread();
@@ -99,6 +125,7 @@ private:
   // These are platform specific and can be found in ./platform/[platform]/ThreadImpl.cpp
   // -----------------------------------------------------------------------------------
   void SetThreadInfo(); // called from the spawned thread
+  void ApplyRolePolicy();
   void TermHandler();
   void SetSignalHandlers();
   // -----------------------------------------------------------------------------------
@@ -114,6 +141,8 @@ private:
   float m_fLastUsage = 0.0f;
 
   std::string m_ThreadName;
+  std::atomic<ThreadRole> m_role{ThreadRole::UNSPECIFIED};
+  uint64_t m_nativeId = 0;
   std::thread* m_thread = nullptr;
   std::future<bool> m_future;
 
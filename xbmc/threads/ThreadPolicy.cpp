@@ -0,0 +1,205 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ThreadPolicy.h"
+
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+
+struct RoleName
+{
+  ThreadRole role;
+  const char* name;
+};
+
+constexpr RoleName RoleNames[] = {
+    {ThreadRole::UNSPECIFIED, "unspecified"},     {ThreadRole::AUDIO_SINK, "audiosink"},
+    {ThreadRole::RENDER, "render"},               {ThreadRole::DEMUX, "demux"},
+    {ThreadRole::DECODER, "decoder"},             {ThreadRole::BACKGROUND_IO, "backgroundio"},
+    {ThreadRole::BACKGROUND_CPU, "backgroundcpu"},
+};
+
+constexpr size_t RoleCount = sizeof(RoleNames) / sizeof(RoleNames[0]);
+
+// matches CPU_SETSIZE of glibc
+constexpr unsigned int MaxCpus = 1024;
+
+CCriticalSection& PolicyLock()
+{
+  static CCriticalSection lock;
+  return lock;
+}
+
+std::array<ThreadRolePolicy, RoleCount>& Policies()
+{
+  static std::array<ThreadRolePolicy, RoleCount> policies = [] {
+    std::array<ThreadRolePolicy, RoleCount> defaults;
+
+    // these match the priorities the threads used to set for themselves
+    ThreadRolePolicy& audioSink = defaults[static_cast<size_t>(ThreadRole::AUDIO_SINK)];
+    audioSink.hasPriority = true;
+    audioSink.priority = THREAD_PRIORITY_ABOVE_NORMAL;
+
+    ThreadRolePolicy& backgroundCpu = defaults[static_cast<size_t>(ThreadRole::BACKGROUND_CPU)];
+    backgroundCpu.hasPriority = true;
+    backgroundCpu.priority = CThread::GetMinPriority();
+
+    ThreadRolePolicy& backgroundIo = defaults[static_cast<size_t>(ThreadRole::BACKGROUND_IO)];
+    backgroundIo.hasPriority = true;
+    backgroundIo.priority = THREAD_PRIORITY_BELOW_NORMAL;
+
+    return defaults;
+  }();
+  return policies;
+}
+
+bool ParseNumber(const std::string& str, unsigned int& value)
+{
+  if (str.empty() || str.find_first_not_of("0123456789") != std::string::npos)
+    return false;
+
+  value = static_cast<unsigned int>(std::strtoul(str.c_str(), nullptr, 10));
+  return true;
+}
+
+std::string Trim(const std::string& str)
+{
+  const auto first = str.find_first_not_of(" \t");
+  if (first == std::string::npos)
+    return "";
+  return str.substr(first, str.find_last_not_of(" \t") - first + 1);
+}
+
+} // unnamed namespace
+
+const char* CThreadPolicy::GetRoleName(ThreadRole role)
+{
+  for (const auto& roleName : RoleNames)
+  {
+    if (roleName.role == role)
+      return roleName.name;
+  }
+  return "unspecified";
+}
+
+bool CThreadPolicy::GetRoleByName(const std::string& name, ThreadRole& role)
+{
+  for (const auto& roleName : RoleNames)
+  {
+    if (name == roleName.name)
+    {
+      role = roleName.role;
+      return true;
+    }
+  }
+  return false;
+}
+
+void CThreadPolicy::SetPolicy(ThreadRole role, const ThreadRolePolicy& policy)
+{
+  CSingleLock lock(PolicyLock());
+  Policies()[static_cast<size_t>(role)] = policy;
+}
+
+ThreadRolePolicy CThreadPolicy::GetPolicy(ThreadRole role)
+{
+  CSingleLock lock(PolicyLock());
+  return Policies()[static_cast<size_t>(role)];
+}
+
+bool CThreadPolicy::ParseCpuList(const std::string& list, std::vector<unsigned int>& cpus)
+{
+  cpus.clear();
+
+  const std::string value = Trim(list);
+  if (value == "big" || value == "little")
+  {
+    // all cores are alike (or their capacity is unknown), so both select every core
+    const std::vector<unsigned int> capacities = GetCpuCapacities();
+    if (capacities.empty())
+      return true;
+
+    const unsigned int maxCapacity = *std::max_element(capacities.begin(), capacities.end());
+    for (unsigned int cpu = 0; cpu < capacities.size(); cpu++)
+    {
+      if ((capacities[cpu] == maxCapacity) == (value == "big"))
+        cpus.push_back(cpu);
+    }
+    return !cpus.empty();
+  }
+
+  std::stringstream stream(value);
+  std::string range;
+  while (std::getline(stream, range, ','))
+  {
+    range = Trim(range);
+    const auto dash = range.find('-');
+    unsigned int first;
+    unsigned int last;
+    if (dash == std::string::npos)
+    {
+      if (!ParseNumber(range, first))
+        return false;
+      last = first;
+    }
+    else if (!ParseNumber(Trim(range.substr(0, dash)), first) ||
+             !ParseNumber(Trim(range.substr(dash + 1)), last) || last < first)
+      return false;
+
+    if (last >= MaxCpus)
+      return false;
+
+    for (unsigned int cpu = first; cpu <= last; cpu++)
+      cpus.push_back(cpu);
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return !cpus.empty();
+}
+
+std::vector<unsigned int> CThreadPolicy::GetCpuCapacities()
+{
+  std::vector<unsigned int> capacities;
+
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+  const unsigned int cpuCount = std::thread::hardware_concurrency();
+  for (unsigned int cpu = 0; cpu < cpuCount; cpu++)
+  {
+    const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    unsigned int capacity = 0;
+
+    // prefer the scheduler's capacity, fall back to the maximum frequency
+    std::ifstream file(base + "/cpu_capacity");
+    if (!(file >> capacity))
+    {
+      std::ifstream freq(base + "/cpufreq/cpuinfo_max_freq");
+      if (!(freq >> capacity))
+        return {};
+    }
+    capacities.push_back(capacity);
+  }
+
+  if (std::adjacent_find(capacities.begin(), capacities.end(), std::not_equal_to<unsigned int>()) ==
+      capacities.end())
+    capacities.clear();
+#endif
+
+  return capacities;
+}
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*!
+ * \brief What a thread is used for. Scheduling is configured per role rather than per thread
+ * so that all threads doing the same kind of work are treated alike.
+ */
+enum class ThreadRole
+{
+  UNSPECIFIED,
+  AUDIO_SINK,
+  RENDER,
+  DEMUX,
+  DECODER,
+  BACKGROUND_IO,
+  BACKGROUND_CPU,
+};
+
+/*!
+ * \brief Scheduling settings applied to every thread of a role.
+ */
+struct ThreadRolePolicy
+{
+  bool hasPriority = false;
+  int priority = 0; //!< relative priority as accepted by CThread::SetPriority
+  bool realtime = false; //!< request a real-time scheduling class if permitted
+  std::vector<unsigned int> cpus; //!< CPUs the thread may run on, empty for all
+};
+
+class CThreadPolicy
+{
+public:
+  static const char* GetRoleName(ThreadRole role);
+  static bool GetRoleByName(const std::string& name, ThreadRole& role);
+
+  static void SetPolicy(ThreadRole role, const ThreadRolePolicy& policy);
+  static ThreadRolePolicy GetPolicy(ThreadRole role);
+
+  /*!
+   * \brief Parse a list of CPUs like "0-3,6". "big" and "little" select the fastest
+   * respectively all other cores on CPUs with cores of different capacity, and all cores
+   * (an empty list) on CPUs whose cores are alike.
+   * \return false if the list is malformed or selects no CPU
+   */
+  static bool ParseCpuList(const std::string& list, std::vector<unsigned int>& cpus);
+
+private:
+  // relative capacity of each CPU, empty if unknown or all cores are alike
+  static std::vector<unsigned int> GetCpuCapacities();
+};
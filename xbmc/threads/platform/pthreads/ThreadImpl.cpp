@@ -6,7 +6,10 @@
  *  See LICENSES/README.md for more information.
  */
 
+#include <fstream>
 #include <limits.h>
+#include <sched.h>
+#include <string>
 #if defined(TARGET_ANDROID)
 #include <unistd.h>
 #else
@@ -132,6 +135,52 @@ void CThread::SetThreadInfo()
 #endif
 }
 
+void CThread::ApplyRolePolicy()
+{
+  const ThreadRole role = m_role;
+  if (role == ThreadRole::UNSPECIFIED)
+    return;
+
+  const ThreadRolePolicy policy = CThreadPolicy::GetPolicy(role);
+
+  if (policy.hasPriority)
+    SetPriority(policy.priority);
+
+  CSingleLock lock(m_CriticalSection);
+  if (!m_thread)
+    return;
+
+  if (policy.realtime)
+  {
+    // lowest real-time priority is enough to preempt all normal threads
+    sched_param param = {};
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 1;
+    const int ret = pthread_setschedparam(m_thread->native_handle(), SCHED_FIFO, &param);
+    if (ret != 0)
+      CLog::Log(LOGWARNING, "%s: unable to use real-time scheduling for thread %s (%s): %s",
+                __FUNCTION__, m_ThreadName.c_str(), CThreadPolicy::GetRoleName(role),
+                strerror(ret));
+  }
+
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+  if (!policy.cpus.empty())
+  {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (unsigned int cpu : policy.cpus)
+    {
+      if (cpu < CPU_SETSIZE)
+        CPU_SET(cpu, &cpuSet);
+    }
+
+    if (sched_setaffinity(m_lwpId, sizeof(cpuSet), &cpuSet) != 0)
+      CLog::Log(LOGWARNING, "%s: unable to set the CPU affinity of thread %s (%s): %s",
+                __FUNCTION__, m_ThreadName.c_str(), CThreadPolicy::GetRoleName(role),
+                strerror(errno));
+  }
+#endif
+}
+
 std::uintptr_t CThread::GetCurrentThreadNativeHandle()
 {
 #if defined(TARGET_DARWIN) || defined(TARGET_FREEBSD)
@@ -249,6 +298,33 @@ int64_t CThread::GetAbsoluteUsage()
   return time;
 }
 
+bool CThread::GetContextSwitches(uint64_t& voluntary, uint64_t& involuntary)
+{
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+  if (!m_lwpId)
+    return false;
+
+  std::ifstream status("/proc/self/task/" + std::to_string(m_lwpId) + "/status");
+  if (!status)
+    return false;
+
+  bool foundVoluntary = false;
+  bool foundInvoluntary = false;
+  std::string key;
+  while (status >> key)
+  {
+    if (key == "voluntary_ctxt_switches:")
+      foundVoluntary = static_cast<bool>(status >> voluntary);
+    else if (key == "nonvoluntary_ctxt_switches:")
+      foundInvoluntary = static_cast<bool>(status >> involuntary);
+  }
+
+  return foundVoluntary && foundInvoluntary;
+#else
+  return false;
+#endif
+}
+
 void term_handler(int signum)
 {
   CLog::Log(LOGERROR, "thread 0x%lx (%lu) got signal %d. calling OnException and terminating thread abnormally.", (long unsigned int) pthread_self(),
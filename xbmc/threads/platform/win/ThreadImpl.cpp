@@ -45,6 +45,37 @@ void CThread::SetThreadInfo()
   CWIN32Util::SetThreadLocalLocale(true); // avoid crashing with setlocale(), see https://connect.microsoft.com/VisualStudio/feedback/details/794122
 }
 
+void CThread::ApplyRolePolicy()
+{
+  const ThreadRole role = m_role;
+  if (role == ThreadRole::UNSPECIFIED)
+    return;
+
+  const ThreadRolePolicy policy = CThreadPolicy::GetPolicy(role);
+
+  if (policy.realtime)
+    SetPriority(THREAD_PRIORITY_TIME_CRITICAL);
+  else if (policy.hasPriority)
+    SetPriority(policy.priority);
+
+  CSingleLock lock(m_CriticalSection);
+  if (!m_thread || policy.cpus.empty())
+    return;
+
+#ifndef TARGET_WINDOWS_STORE
+  DWORD_PTR mask = 0;
+  for (unsigned int cpu : policy.cpus)
+  {
+    if (cpu < sizeof(mask) * 8)
+      mask |= static_cast<DWORD_PTR>(1) << cpu;
+  }
+
+  if (!mask || !SetThreadAffinityMask(m_lwpId, mask))
+    CLog::Log(LOGWARNING, "%s: unable to set the CPU affinity of thread %s (%s)", __FUNCTION__,
+              m_ThreadName.c_str(), CThreadPolicy::GetRoleName(role));
+#endif
+}
+
 std::uintptr_t CThread::GetCurrentThreadNativeHandle()
 {
   return reinterpret_cast<std::uintptr_t>(::GetCurrentThread());
@@ -118,6 +149,12 @@ int64_t CThread::GetAbsoluteUsage()
 #endif
 }
 
+bool CThread::GetContextSwitches(uint64_t& voluntary, uint64_t& involuntary)
+{
+  // not exposed per thread by the public Win32 API
+  return false;
+}
+
 void CThread::SetSignalHandlers()
 {
 }
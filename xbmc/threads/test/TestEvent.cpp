@@ -10,6 +10,8 @@
 #include "threads/IRunnable.h"
 #include "threads/test/TestHelpers.h"
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <stdio.h>
 
@@ -616,3 +618,66 @@ TEST(TestMassEvent, Polling)
   delete g_event;
 }
 
+
+class ping_pong : public IRunnable
+{
+  CEvent& ping;
+  CEvent& pong;
+  int rounds;
+
+public:
+  ping_pong(CEvent& ping_, CEvent& pong_, int rounds_)
+    : ping(ping_), pong(pong_), rounds(rounds_)
+  {
+  }
+
+  void Run() override
+  {
+    for (int i = 0; i < rounds; i++)
+    {
+      ping.Wait();
+      pong.Set();
+    }
+  }
+};
+
+TEST(TestEvent, WakeLatency)
+{
+  constexpr int ROUNDS = 20000;
+  CEvent ping;
+  CEvent pong;
+
+  ping_pong responder(ping, pong, ROUNDS);
+  thread responderThread(responder);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ROUNDS; i++)
+  {
+    ping.Set();
+    EXPECT_TRUE(pong.WaitMSec(10000));
+  }
+  const auto roundTrip = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start) /
+                         ROUNDS;
+
+  EXPECT_TRUE(responderThread.timed_join(MILLIS(10000)));
+  RecordProperty("RoundTripNs", static_cast<int>(roundTrip.count()));
+}
+
+TEST(TestEvent, TimedWaitAccuracy)
+{
+  // pacing loops rely on timed waits not overshooting by much
+  CEvent event;
+  std::chrono::microseconds maxOvershoot{0};
+  for (int i = 0; i < 50; i++)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(event.WaitMSec(2));
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(2));
+    maxOvershoot = std::max(maxOvershoot, elapsed - std::chrono::milliseconds(2));
+  }
+
+  RecordProperty("MaxOvershootUs", static_cast<int>(maxOvershoot.count()));
+}
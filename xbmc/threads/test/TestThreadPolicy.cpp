@@ -0,0 +1,118 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/Event.h"
+#include "threads/IRunnable.h"
+#include "threads/Thread.h"
+#include "threads/ThreadPolicy.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+class BlockingRunnable : public IRunnable
+{
+public:
+  void Run() override
+  {
+    started.Set();
+    release.Wait();
+  }
+
+  CEvent started;
+  CEvent release;
+};
+
+} // unnamed namespace
+
+TEST(TestThreadPolicy, ParseCpuList)
+{
+  std::vector<unsigned int> cpus;
+
+  EXPECT_TRUE(CThreadPolicy::ParseCpuList("0-3,6", cpus));
+  EXPECT_EQ(std::vector<unsigned int>({0, 1, 2, 3, 6}), cpus);
+
+  EXPECT_TRUE(CThreadPolicy::ParseCpuList(" 5, 1-2 ,2", cpus));
+  EXPECT_EQ(std::vector<unsigned int>({1, 2, 5}), cpus);
+
+  EXPECT_FALSE(CThreadPolicy::ParseCpuList("", cpus));
+  EXPECT_FALSE(CThreadPolicy::ParseCpuList("3-1", cpus));
+  EXPECT_FALSE(CThreadPolicy::ParseCpuList("1,x", cpus));
+  EXPECT_FALSE(CThreadPolicy::ParseCpuList("-1", cpus));
+  EXPECT_FALSE(CThreadPolicy::ParseCpuList("100000", cpus));
+
+  // selects a subset of the cores on big.LITTLE CPUs, all of them (no list) otherwise
+  for (const char* list : {"big", "little"})
+  {
+    EXPECT_TRUE(CThreadPolicy::ParseCpuList(list, cpus)) << list;
+    for (unsigned int cpu : cpus)
+      EXPECT_LT(cpu, std::thread::hardware_concurrency()) << list;
+  }
+}
+
+TEST(TestThreadPolicy, RoleNames)
+{
+  for (ThreadRole role : {ThreadRole::UNSPECIFIED, ThreadRole::AUDIO_SINK, ThreadRole::RENDER,
+                          ThreadRole::DEMUX, ThreadRole::DECODER, ThreadRole::BACKGROUND_IO,
+                          ThreadRole::BACKGROUND_CPU})
+  {
+    ThreadRole parsed = ThreadRole::UNSPECIFIED;
+    EXPECT_TRUE(CThreadPolicy::GetRoleByName(CThreadPolicy::GetRoleName(role), parsed));
+    EXPECT_EQ(role, parsed);
+  }
+
+  ThreadRole role;
+  EXPECT_FALSE(CThreadPolicy::GetRoleByName("nosuchrole", role));
+}
+
+TEST(TestThreadPolicy, SetPolicy)
+{
+  const ThreadRolePolicy original = CThreadPolicy::GetPolicy(ThreadRole::DEMUX);
+
+  ThreadRolePolicy policy;
+  policy.hasPriority = true;
+  policy.priority = THREAD_PRIORITY_ABOVE_NORMAL;
+  policy.cpus = {0};
+  CThreadPolicy::SetPolicy(ThreadRole::DEMUX, policy);
+
+  const ThreadRolePolicy stored = CThreadPolicy::GetPolicy(ThreadRole::DEMUX);
+  EXPECT_TRUE(stored.hasPriority);
+  EXPECT_EQ(THREAD_PRIORITY_ABOVE_NORMAL, stored.priority);
+  EXPECT_FALSE(stored.realtime);
+  EXPECT_EQ(std::vector<unsigned int>({0}), stored.cpus);
+
+  CThreadPolicy::SetPolicy(ThreadRole::DEMUX, original);
+}
+
+TEST(TestThreadPolicy, RunningThreads)
+{
+  BlockingRunnable runnable;
+  CThread thread(&runnable, "PolicyTestThread");
+  thread.SetRole(ThreadRole::BACKGROUND_IO);
+  thread.Create();
+  ASSERT_TRUE(runnable.started.WaitMSec(5000));
+
+  const std::vector<CThread::ThreadInfo> threads = CThread::GetRunningThreads();
+  const auto it = std::find_if(threads.begin(), threads.end(), [](const CThread::ThreadInfo& info) {
+    return info.name == "PolicyTestThread";
+  });
+  ASSERT_NE(threads.end(), it);
+  EXPECT_EQ(ThreadRole::BACKGROUND_IO, it->role);
+  EXPECT_NE(0u, it->nativeId);
+
+  runnable.release.Set();
+  thread.StopThread();
+
+  for (const auto& info : CThread::GetRunningThreads())
+    EXPECT_NE("PolicyTestThread", info.name);
+}
@@ -10,10 +10,43 @@
 
 #include "threads/Event.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace Actor;
 
+void MessageQueue::push(Message* msg)
+{
+  if (m_count == m_slots.size())
+  {
+    // grow and unwrap the ring
+    std::vector<Message*> slots(std::max<size_t>(16, m_slots.size() * 2));
+    for (size_t i = 0; i < m_count; i++)
+      slots[i] = m_slots[(m_head + i) & (m_slots.size() - 1)];
+    m_slots.swap(slots);
+    m_head = 0;
+  }
+
+  m_slots[(m_head + m_count) & (m_slots.size() - 1)] = msg;
+  m_count++;
+}
+
+void Message::SetData(const void* src, size_t size)
+{
+  if (size > sizeof(buffer))
+  {
+    if (size > heapBufferSize)
+    {
+      heapBuffer.reset(new uint8_t[size]);
+      heapBufferSize = size;
+    }
+    data = heapBuffer.get();
+  }
+  else
+    data = buffer;
+  memcpy(data, src, size);
+}
+
 void Message::Release()
 {
   bool skip;
@@ -25,15 +58,15 @@ void Message::Release()
   if (skip)
     return;
 
-  // free data buffer
-  if (data != buffer)
-    delete [] data;
+  // keep the data buffer for the next message unless it's unusually large
+  if (heapBufferSize > MSG_RETAINED_BUFFER_SIZE)
+  {
+    heapBuffer.reset();
+    heapBufferSize = 0;
+  }
 
   payloadObj.reset();
 
-  // delete event in case of sync message
-  delete event;
-
   origin.ReturnMessage(this);
 }
 
@@ -56,13 +89,7 @@ bool Message::Reply(int sig, void *data /* = NULL*/, size_t size /* = 0 */)
     msg->isOut = !isOut;
     replyMessage = msg;
     if (data)
-    {
-      if (size > sizeof(msg->buffer))
-        msg->data = new uint8_t[size];
-      else
-        msg->data = msg->buffer;
-      memcpy(msg->data, data, size);
-    }
+      msg->SetData(data, size);
   }
 
   origin.Unlock();
@@ -75,14 +102,9 @@ bool Message::Reply(int sig, void *data /* = NULL*/, size_t size /* = 0 */)
 
 Protocol::~Protocol()
 {
-  Message *msg;
   Purge();
-  while (!freeMessageQueue.empty())
-  {
-    msg = freeMessageQueue.front();
-    freeMessageQueue.pop();
+  for (Message* msg : freeMessages)
     delete msg;
-  }
 }
 
 Message *Protocol::GetMessage()
@@ -91,13 +113,14 @@ Message *Protocol::GetMessage()
 
   CSingleLock lock(criticalSection);
 
-  if (!freeMessageQueue.empty())
+  if (freeMessages.empty())
   {
-    msg = freeMessageQueue.front();
-    freeMessageQueue.pop();
+    for (size_t i = 0; i < MESSAGE_SLAB_SIZE; i++)
+      freeMessages.push_back(new Message(*this));
   }
-  else
-    msg = new Message(*this);
+
+  msg = freeMessages.back();
+  freeMessages.pop_back();
 
   msg->isSync = false;
   msg->isSyncFini = false;
@@ -114,7 +137,41 @@ void Protocol::ReturnMessage(Message *msg)
 {
   CSingleLock lock(criticalSection);
 
-  freeMessageQueue.push(msg);
+  freeMessages.push_back(msg);
+}
+
+void Protocol::QueueMessage(MessageQueue& queue, QueueStatistics& stats, Message* msg)
+{
+  msg->queueTime = std::chrono::steady_clock::now();
+
+  CSingleLock lock(criticalSection);
+  queue.push(msg);
+  stats.maxDepth = std::max(stats.maxDepth, queue.size());
+}
+
+size_t Protocol::DequeueMessages(
+    MessageQueue& queue, QueueStatistics& stats, bool defered, Message** msgs, size_t count)
+{
+  if (defered || queue.empty())
+    return 0;
+
+  const auto now = std::chrono::steady_clock::now();
+  size_t received = 0;
+  while (received < count && !queue.empty())
+  {
+    Message* msg = queue.front();
+    queue.pop();
+
+    const auto latency =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - msg->queueTime);
+    stats.totalLatency += latency;
+    stats.maxLatency = std::max(stats.maxLatency, latency);
+    stats.messages++;
+
+    msgs[received++] = msg;
+  }
+
+  return received;
 }
 
 bool Protocol::SendOutMessage(int signal,
@@ -132,17 +189,9 @@ bool Protocol::SendOutMessage(int signal,
   msg->isOut = true;
 
   if (data)
-  {
-    if (size > sizeof(msg->buffer))
-      msg->data = new uint8_t[size];
-    else
-      msg->data = msg->buffer;
-    memcpy(msg->data, data, size);
-  }
+    msg->SetData(data, size);
 
-  { CSingleLock lock(criticalSection);
-    outMessages.push(msg);
-  }
+  QueueMessage(outMessages, outStatistics, msg);
   if (containerOutEvent)
     containerOutEvent->Set();
 
@@ -162,9 +211,7 @@ bool Protocol::SendOutMessage(int signal, CPayloadWrapBase *payload, Message *ou
 
   msg->payloadObj.reset(payload);
 
-  { CSingleLock lock(criticalSection);
-    outMessages.push(msg);
-  }
+  QueueMessage(outMessages, outStatistics, msg);
   if (containerOutEvent)
     containerOutEvent->Set();
 
@@ -186,17 +233,9 @@ bool Protocol::SendInMessage(int signal,
   msg->isOut = false;
 
   if (data)
-  {
-    if (size > sizeof(msg->data))
-      msg->data = new uint8_t[size];
-    else
-      msg->data = msg->buffer;
-    memcpy(msg->data, data, size);
-  }
+    msg->SetData(data, size);
 
-  { CSingleLock lock(criticalSection);
-    inMessages.push(msg);
-  }
+  QueueMessage(inMessages, inStatistics, msg);
   if (containerInEvent)
     containerInEvent->Set();
 
@@ -216,9 +255,7 @@ bool Protocol::SendInMessage(int signal, CPayloadWrapBase *payload, Message *out
 
   msg->payloadObj.reset(payload);
 
-  { CSingleLock lock(criticalSection);
-    inMessages.push(msg);
-  }
+  QueueMessage(inMessages, inStatistics, msg);
   if (containerInEvent)
     containerInEvent->Set();
 
@@ -231,7 +268,9 @@ bool Protocol::SendOutMessageSync(
   Message *msg = GetMessage();
   msg->isOut = true;
   msg->isSync = true;
-  msg->event = new CEvent;
+  if (!msg->syncEvent)
+    msg->syncEvent = std::make_unique<CEvent>();
+  msg->event = msg->syncEvent.get();
   msg->event->Reset();
   SendOutMessage(signal, data, size, msg);
 
@@ -262,7 +301,9 @@ bool Protocol::SendOutMessageSync(int signal, Message **retMsg, int timeout, CPa
   Message *msg = GetMessage();
   msg->isOut = true;
   msg->isSync = true;
-  msg->event = new CEvent;
+  if (!msg->syncEvent)
+    msg->syncEvent = std::make_unique<CEvent>();
+  msg->event = msg->syncEvent.get();
   msg->event->Reset();
   SendOutMessage(signal, payload, msg);
 
@@ -292,80 +333,84 @@ bool Protocol::ReceiveOutMessage(Message **msg)
 {
   CSingleLock lock(criticalSection);
 
-  if (outMessages.empty() || outDefered)
-    return false;
-
-  *msg = outMessages.front();
-  outMessages.pop();
-
-  return true;
+  return DequeueMessages(outMessages, outStatistics, outDefered, msg, 1) == 1;
 }
 
 bool Protocol::ReceiveInMessage(Message **msg)
 {
   CSingleLock lock(criticalSection);
 
-  if (inMessages.empty() || inDefered)
-    return false;
+  return DequeueMessages(inMessages, inStatistics, inDefered, msg, 1) == 1;
+}
 
-  *msg = inMessages.front();
-  inMessages.pop();
+size_t Protocol::ReceiveOutMessages(Message** msgs, size_t count)
+{
+  CSingleLock lock(criticalSection);
 
-  return true;
+  return DequeueMessages(outMessages, outStatistics, outDefered, msgs, count);
 }
 
-
-void Protocol::Purge()
+size_t Protocol::ReceiveInMessages(Message** msgs, size_t count)
 {
-  Message *msg;
-
-  while (ReceiveInMessage(&msg))
-    msg->Release();
+  CSingleLock lock(criticalSection);
 
-  while (ReceiveOutMessage(&msg))
-    msg->Release();
+  return DequeueMessages(inMessages, inStatistics, inDefered, msgs, count);
 }
 
-void Protocol::PurgeIn(int signal)
+QueueStatistics Protocol::GetOutStatistics()
 {
-  Message *msg;
-  std::queue<Message*> msgs;
+  CSingleLock lock(criticalSection);
+
+  return outStatistics;
+}
 
+QueueStatistics Protocol::GetInStatistics()
+{
   CSingleLock lock(criticalSection);
 
-  while (!inMessages.empty())
+  return inStatistics;
+}
+
+void Protocol::Purge()
+{
+  Message* msgs[MESSAGE_SLAB_SIZE];
+  size_t count;
+
+  while ((count = ReceiveInMessages(msgs, MESSAGE_SLAB_SIZE)) > 0)
   {
-    msg = inMessages.front();
-    inMessages.pop();
-    if (msg->signal != signal)
-      msgs.push(msg);
+    for (size_t i = 0; i < count; i++)
+      msgs[i]->Release();
   }
-  while (!msgs.empty())
+
+  while ((count = ReceiveOutMessages(msgs, MESSAGE_SLAB_SIZE)) > 0)
   {
-    msg = msgs.front();
-    msgs.pop();
-    inMessages.push(msg);
+    for (size_t i = 0; i < count; i++)
+      msgs[i]->Release();
   }
 }
 
-void Protocol::PurgeOut(int signal)
+void Protocol::PurgeIn(int signal)
 {
-  Message *msg;
-  std::queue<Message*> msgs;
+  CSingleLock lock(criticalSection);
+
+  PurgeQueue(inMessages, signal);
+}
 
+void Protocol::PurgeOut(int signal)
+{
   CSingleLock lock(criticalSection);
 
-  while (!outMessages.empty())
+  PurgeQueue(outMessages, signal);
+}
+
+void Protocol::PurgeQueue(MessageQueue& queue, int signal)
+{
+  // rotate through the queue once, keeping the order of the remaining messages
+  for (size_t count = queue.size(); count > 0; count--)
   {
-    msg = outMessages.front();
-    outMessages.pop();
+    Message* msg = queue.front();
+    queue.pop();
     if (msg->signal != signal)
-      msgs.push(msg);
-  }
-  while (!msgs.empty())
-  {
-    msg = msgs.front();
-    msgs.pop();
-    outMessages.push(msg);
+      queue.push(msg);
   }
 }
@@ -10,11 +10,13 @@
 
 #include "threads/CriticalSection.h"
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 class CEvent;
 
@@ -46,6 +48,8 @@ class Message
   friend class Protocol;
 
   static constexpr size_t MSG_INTERNAL_BUFFER_SIZE = 32;
+  // larger data buffers are kept for reuse by the next message up to this size
+  static constexpr size_t MSG_RETAINED_BUFFER_SIZE = 4096;
 
 public:
   int signal;
@@ -67,6 +71,44 @@ public:
 private:
   explicit Message(Protocol &_origin) noexcept
     :origin(_origin) {}
+
+  void SetData(const void* src, size_t size);
+
+  std::unique_ptr<uint8_t[]> heapBuffer;
+  size_t heapBufferSize = 0;
+  std::unique_ptr<CEvent> syncEvent;
+  std::chrono::steady_clock::time_point queueTime;
+};
+
+/*!
+ * \brief FIFO of messages which keeps its storage, so queueing does not allocate once
+ * a port has seen its usual number of pending messages.
+ */
+class MessageQueue
+{
+public:
+  bool empty() const { return m_count == 0; }
+  size_t size() const { return m_count; }
+  Message* front() const { return m_slots[m_head]; }
+  void pop()
+  {
+    m_head = (m_head + 1) & (m_slots.size() - 1);
+    m_count--;
+  }
+  void push(Message* msg);
+
+private:
+  std::vector<Message*> m_slots; // size is always a power of two
+  size_t m_head = 0;
+  size_t m_count = 0;
+};
+
+struct QueueStatistics
+{
+  uint64_t messages = 0; //!< number of messages received
+  size_t maxDepth = 0; //!< highest number of pending messages
+  std::chrono::microseconds totalLatency{0}; //!< summed time between send and receive
+  std::chrono::microseconds maxLatency{0};
 };
 
 class Protocol
@@ -95,6 +137,14 @@ public:
   bool SendOutMessageSync(int signal, Message **retMsg, int timeout, CPayloadWrapBase *payload);
   bool ReceiveOutMessage(Message **msg);
   bool ReceiveInMessage(Message **msg);
+  /*!
+   * \brief Receive up to count pending messages with a single lock of the port.
+   * \return number of messages stored in msgs
+   */
+  size_t ReceiveOutMessages(Message** msgs, size_t count);
+  size_t ReceiveInMessages(Message** msgs, size_t count);
+  QueueStatistics GetOutStatistics();
+  QueueStatistics GetInStatistics();
   void Purge();
   void PurgeIn(int signal);
   void PurgeOut(int signal);
@@ -105,11 +155,24 @@ public:
   std::string portName;
 
 protected:
+  // messages are allocated in batches when the free list runs empty
+  static constexpr size_t MESSAGE_SLAB_SIZE = 16;
+
+  void QueueMessage(MessageQueue& queue, QueueStatistics& stats, Message* msg);
+  size_t DequeueMessages(MessageQueue& queue,
+                         QueueStatistics& stats,
+                         bool defered,
+                         Message** msgs,
+                         size_t count);
+  void PurgeQueue(MessageQueue& queue, int signal);
+
   CEvent *containerInEvent, *containerOutEvent;
   CCriticalSection criticalSection;
-  std::queue<Message*> outMessages;
-  std::queue<Message*> inMessages;
-  std::queue<Message*> freeMessageQueue;
+  MessageQueue outMessages;
+  MessageQueue inMessages;
+  std::vector<Message*> freeMessages;
+  QueueStatistics outStatistics;
+  QueueStatistics inStatistics;
   bool inDefered = false, outDefered = false;
 };
 
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AsyncLogFileSink.h"
+
+#include <chrono>
+#include <string>
+#include <utility>
+
+namespace
+{
+// upper bound for the time a message stays in memory before it's written
+constexpr auto FlushInterval = std::chrono::milliseconds(250);
+
+void AppendDroppedNote(spdlog::memory_buf_t& buffer, std::size_t dropped)
+{
+  const std::string note = std::to_string(dropped) + " log messages dropped\n";
+  buffer.append(note.data(), note.data() + note.size());
+}
+} // namespace
+
+CAsyncLogFileSink::CAsyncLogFileSink(const spdlog_filename_t& filename,
+                                     bool async,
+                                     std::size_t bufferSize)
+  : m_bufferSize(bufferSize)
+{
+  m_file.open(filename, false);
+  SetAsync(async, bufferSize);
+}
+
+CAsyncLogFileSink::~CAsyncLogFileSink()
+{
+  StopFlusher();
+}
+
+void CAsyncLogFileSink::SetAsync(bool async, std::size_t bufferSize)
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    m_bufferSize = bufferSize;
+    if (async == m_async)
+      return;
+
+    if (async)
+    {
+      m_async = true;
+      m_flusher = std::thread(&CAsyncLogFileSink::Process, this);
+      return;
+    }
+  }
+
+  StopFlusher();
+}
+
+void CAsyncLogFileSink::sink_it_(const spdlog::details::log_msg& msg)
+{
+  const std::size_t queuedSize = m_queued.size();
+  formatter_->format(msg, m_queued);
+
+  if (!m_async || msg.level >= spdlog::level::err)
+  {
+    // write everything logged before this message as well to keep the order
+    if (m_dropped > 0)
+    {
+      AppendDroppedNote(m_queued, m_dropped);
+      m_dropped = 0;
+    }
+
+    std::unique_lock<std::mutex> fileLock(m_fileLock);
+    m_file.write(m_queued);
+    m_queued.clear();
+    if (m_async)
+      m_file.flush();
+    return;
+  }
+
+  if (m_queued.size() > m_bufferSize)
+  {
+    m_queued.resize(queuedSize);
+    ++m_dropped;
+    ++m_droppedTotal;
+    m_wakeup.notify_one();
+  }
+  else if (m_queued.size() >= m_bufferSize / 2)
+    m_wakeup.notify_one();
+}
+
+void CAsyncLogFileSink::flush_()
+{
+  // in asynchronous mode flushing is up to the flusher thread
+  if (m_async)
+    return;
+
+  std::unique_lock<std::mutex> fileLock(m_fileLock);
+  m_file.flush();
+}
+
+void CAsyncLogFileSink::Process()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!m_stop)
+  {
+    m_wakeup.wait_for(lock, FlushInterval, [this] {
+      return m_stop || m_dropped > 0 || m_queued.size() >= m_bufferSize / 2;
+    });
+    WriteQueued(lock);
+  }
+}
+
+void CAsyncLogFileSink::WriteQueued(std::unique_lock<std::mutex>& lock)
+{
+  if (m_queued.size() == 0 && m_dropped == 0)
+    return;
+
+  std::swap(m_queued, m_writing);
+  const std::size_t dropped = m_dropped;
+  m_dropped = 0;
+
+  // take the file lock before releasing the queue so synchronous writes can't overtake us
+  std::unique_lock<std::mutex> fileLock(m_fileLock);
+  lock.unlock();
+
+  if (dropped > 0)
+    AppendDroppedNote(m_writing, dropped);
+  m_file.write(m_writing);
+  m_file.flush();
+  m_writing.clear();
+
+  fileLock.unlock();
+  lock.lock();
+}
+
+void CAsyncLogFileSink::StopFlusher()
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!m_flusher.joinable())
+      return;
+
+    m_async = false;
+    m_stop = true;
+  }
+
+  m_wakeup.notify_one();
+  m_flusher.join();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  m_stop = false;
+  WriteQueued(lock);
+}
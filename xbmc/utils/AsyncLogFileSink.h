@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/IPlatformLog.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include <spdlog/details/file_helper.h>
+#include <spdlog/sinks/base_sink.h>
+
+/*!
+ * \brief File sink which moves writing and flushing off the logging thread.
+ *
+ * In asynchronous mode formatted lines are appended to an in-memory batch which is
+ * written by a background thread, either periodically or once the batch gets large.
+ * The batch is bounded, messages which don't fit are dropped and counted instead of
+ * blocking the caller. Errors and fatal messages are written synchronously together
+ * with everything queued before them, so the log is complete up to the last error.
+ */
+class CAsyncLogFileSink : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+  CAsyncLogFileSink(const spdlog_filename_t& filename, bool async, std::size_t bufferSize);
+  ~CAsyncLogFileSink() override;
+
+  /*!
+   * \brief Switch between asynchronous and synchronous writing.
+   * \param bufferSize maximum number of bytes queued in asynchronous mode
+   */
+  void SetAsync(bool async, std::size_t bufferSize);
+
+  /*!
+   * \brief Number of messages dropped because the queue was full.
+   */
+  std::size_t GetDroppedMessages() const { return m_droppedTotal; }
+
+protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override;
+  void flush_() override;
+
+private:
+  void Process();
+  void WriteQueued(std::unique_lock<std::mutex>& lock);
+  void StopFlusher();
+
+  spdlog::details::file_helper m_file;
+  std::mutex m_fileLock;
+
+  spdlog::memory_buf_t m_queued;
+  spdlog::memory_buf_t m_writing;
+  std::size_t m_bufferSize;
+  std::size_t m_dropped = 0;
+  std::atomic<std::size_t> m_droppedTotal{0};
+
+  bool m_async = false;
+  bool m_stop = false;
+  std::condition_variable m_wakeup;
+  std::thread m_flusher;
+};
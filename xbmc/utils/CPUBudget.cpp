@@ -0,0 +1,75 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "CPUBudget.h"
+
+#include "ServiceBroker.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
+#include "utils/CPUInfo.h"
+
+#include <algorithm>
+
+CCPUBudget::CCPUBudget(int decoderThreads) : m_limit(decoderThreads)
+{
+}
+
+CCPUBudget& CCPUBudget::GetInstance()
+{
+  static CCPUBudget budget;
+  return budget;
+}
+
+int CCPUBudget::GetPreferredDecoderThreads()
+{
+  int threads = 1;
+  std::shared_ptr<CCPUInfo> cpuInfo = CServiceBroker::GetCPUInfo();
+  if (cpuInfo)
+    threads = cpuInfo->GetCPUCount() * 3 / 2;
+  return std::max(1, std::min(threads, 16));
+}
+
+int CCPUBudget::AcquireDecoderThreads(int wanted)
+{
+  CSingleLock lock(m_section);
+  const int available = GetDecoderThreadLimit() - m_inUse;
+  const int granted = std::max(1, std::min(wanted, available));
+  m_inUse += granted;
+  return granted;
+}
+
+void CCPUBudget::ReleaseDecoderThreads(int threads)
+{
+  CSingleLock lock(m_section);
+  m_inUse = std::max(0, m_inUse - threads);
+}
+
+int CCPUBudget::GetDecoderThreadsInUse() const
+{
+  CSingleLock lock(m_section);
+  return m_inUse;
+}
+
+int CCPUBudget::GetDecoderThreadLimit() const
+{
+  CSingleLock lock(m_section);
+  if (m_limit <= 0)
+  {
+    m_limit = GetPreferredDecoderThreads();
+
+    const auto settingsComponent = CServiceBroker::GetSettingsComponent();
+    if (settingsComponent && settingsComponent->GetAdvancedSettings())
+    {
+      const int configured = settingsComponent->GetAdvancedSettings()->m_videoDecoderThreads;
+      if (configured > 0)
+        m_limit = configured;
+    }
+  }
+  return m_limit;
+}
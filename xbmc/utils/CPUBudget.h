@@ -0,0 +1,53 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+/*!
+ \brief Hands out software decoder threads from a single process wide budget.
+
+ Every frame threaded decoder used to size its thread pool from the CPU count
+ alone, so two decoders (or a decoder and a thumbnail extractor) each claimed
+ the whole machine. Decoders now lease their threads here and give them back
+ when they are disposed; a decoder always gets at least one thread.
+ */
+class CCPUBudget
+{
+public:
+  /*!
+   \param decoderThreads total number of decoder threads to hand out, 0 derives
+          it from the CPU count and the <video><decoderthreads> advanced
+          setting
+   */
+  explicit CCPUBudget(int decoderThreads = 0);
+
+  static CCPUBudget& GetInstance();
+
+  /*!
+   \brief Lease up to wanted threads for a decoder.
+   \return the number of threads granted, at least 1. Must be returned with
+           ReleaseDecoderThreads().
+   */
+  int AcquireDecoderThreads(int wanted);
+  void ReleaseDecoderThreads(int threads);
+
+  int GetDecoderThreadsInUse() const;
+  int GetDecoderThreadLimit() const;
+
+  /*!
+   \brief Number of frame threads a software decoder asks for on this machine.
+   */
+  static int GetPreferredDecoderThreads();
+
+private:
+  mutable CCriticalSection m_section;
+  mutable int m_limit;
+  int m_inUse = 0;
+};
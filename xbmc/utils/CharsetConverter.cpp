@@ -18,6 +18,8 @@
 #include "utils/Utf8Utils.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 
 #include <fribidi.h>
 #include <iconv.h>
@@ -70,6 +72,235 @@
 
 #define NO_ICONV ((iconv_t)-1)
 
+#if defined(WCHAR_IS_UCS_4) || defined(WCHAR_IS_UTF16)
+  #define WCHAR_IS_UNICODE 1
+#endif
+
+namespace
+{
+/* Hand-written transcoders for conversions between Unicode encodings. They don't need iconv and
+   its locking and behave like the iconv based conversion: invalid input is skipped unless
+   failOnInvalidChar is set, truncated input at the end is dropped. */
+
+#ifdef WORDS_BIGENDIAN
+constexpr bool HOST_IS_BIG_ENDIAN = true;
+#else
+constexpr bool HOST_IS_BIG_ENDIAN = false;
+#endif
+
+// checks a block of 8 bytes at once for non-ASCII characters
+size_t AsciiPrefixLength(const char* str, size_t len)
+{
+  size_t pos = 0;
+  for (; pos + sizeof(uint64_t) <= len; pos += sizeof(uint64_t))
+  {
+    uint64_t block;
+    memcpy(&block, str + pos, sizeof(block));
+    if (block & 0x8080808080808080ULL)
+      break;
+  }
+  while (pos < len && static_cast<unsigned char>(str[pos]) < 0x80)
+    pos++;
+  return pos;
+}
+
+inline bool IsValidCodePoint(char32_t c)
+{
+  return c <= 0x10FFFF && (c < 0xD800 || c > 0xDFFF);
+}
+
+inline void AppendCodePoint(std::u32string& dst, char32_t c)
+{
+  dst.push_back(c);
+}
+
+inline void AppendCodePoint(std::string& dst, char32_t c)
+{
+  if (c < 0x80)
+    dst.push_back(static_cast<char>(c));
+  else if (c < 0x800)
+  {
+    dst.push_back(static_cast<char>(0xC0 | (c >> 6)));
+    dst.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  }
+  else if (c < 0x10000)
+  {
+    dst.push_back(static_cast<char>(0xE0 | (c >> 12)));
+    dst.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+    dst.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  }
+  else
+  {
+    dst.push_back(static_cast<char>(0xF0 | (c >> 18)));
+    dst.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+    dst.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+    dst.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  }
+}
+
+#ifdef WCHAR_IS_UNICODE
+inline void AppendCodePoint(std::wstring& dst, char32_t c)
+{
+#ifdef WCHAR_IS_UTF16
+  if (c >= 0x10000)
+  {
+    c -= 0x10000;
+    dst.push_back(static_cast<wchar_t>(0xD800 | (c >> 10)));
+    dst.push_back(static_cast<wchar_t>(0xDC00 | (c & 0x3FF)));
+    return;
+  }
+#endif
+  dst.push_back(static_cast<wchar_t>(c));
+}
+#endif
+
+template<class OUTPUT>
+bool DecodeUtf8(const std::string& src, OUTPUT& dst, bool failOnInvalidChar)
+{
+  dst.clear();
+  dst.reserve(src.length());
+
+  const char* str = src.data();
+  const size_t len = src.length();
+  size_t pos = 0;
+  while (pos < len)
+  {
+    // copy runs of ASCII characters without decoding
+    const size_t asciiLen = AsciiPrefixLength(str + pos, len - pos);
+    for (size_t end = pos + asciiLen; pos < end; pos++)
+      dst.push_back(static_cast<typename OUTPUT::value_type>(str[pos]));
+    if (pos == len)
+      break;
+
+    const unsigned char lead = static_cast<unsigned char>(str[pos]);
+    size_t seqLen = 0;
+    char32_t c = 0;
+    char32_t minValue = 0;
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+      seqLen = 2;
+      c = lead & 0x1F;
+      minValue = 0x80;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+      seqLen = 3;
+      c = lead & 0x0F;
+      minValue = 0x800;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+      seqLen = 4;
+      c = lead & 0x07;
+      minValue = 0x10000;
+    }
+
+    bool valid = seqLen != 0;
+    size_t i = 1;
+    for (; valid && i < seqLen && pos + i < len; i++)
+    {
+      const unsigned char next = static_cast<unsigned char>(str[pos + i]);
+      if ((next & 0xC0) != 0x80)
+        valid = false;
+      else
+        c = (c << 6) | (next & 0x3F);
+    }
+
+    if (valid && i < seqLen)
+    {
+      // sequence is cut off at the end of input
+      return !failOnInvalidChar;
+    }
+
+    if (!valid || c < minValue || !IsValidCodePoint(c))
+    {
+      if (failOnInvalidChar)
+        return false;
+      pos++; // skip invalid byte
+      continue;
+    }
+
+    AppendCodePoint(dst, c);
+    pos += seqLen;
+  }
+  return true;
+}
+
+template<class INPUT, class OUTPUT>
+bool DecodeUtf32(const INPUT& src, OUTPUT& dst, bool failOnInvalidChar)
+{
+  dst.clear();
+  dst.reserve(src.length());
+
+  for (const auto unit : src)
+  {
+    const char32_t c = static_cast<char32_t>(unit);
+    if (!IsValidCodePoint(c))
+    {
+      if (failOnInvalidChar)
+        return false;
+      continue;
+    }
+    AppendCodePoint(dst, c);
+  }
+  return true;
+}
+
+template<class INPUT, class OUTPUT>
+bool DecodeUtf16(const INPUT& src, bool bigEndian, OUTPUT& dst, bool failOnInvalidChar)
+{
+  dst.clear();
+  dst.reserve(src.length());
+
+  const bool swap = bigEndian != HOST_IS_BIG_ENDIAN;
+  auto unitAt = [&src, swap](size_t pos) {
+    const uint16_t unit = static_cast<uint16_t>(src[pos]);
+    return swap ? static_cast<uint16_t>((unit << 8) | (unit >> 8)) : unit;
+  };
+
+  const size_t len = src.length();
+  for (size_t pos = 0; pos < len; pos++)
+  {
+    char32_t c = unitAt(pos);
+    if (c >= 0xD800 && c <= 0xDBFF)
+    {
+      if (pos + 1 == len)
+        return !failOnInvalidChar; // pair is cut off at the end of input
+
+      const char32_t low = unitAt(pos + 1);
+      if (low >= 0xDC00 && low <= 0xDFFF)
+      {
+        c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+        pos++;
+      }
+      else if (failOnInvalidChar)
+        return false;
+      else
+        continue;
+    }
+    else if (c >= 0xDC00 && c <= 0xDFFF)
+    {
+      if (failOnInvalidChar)
+        return false;
+      continue;
+    }
+    AppendCodePoint(dst, c);
+  }
+  return true;
+}
+
+// UTF8_SOURCE may be a charset which also normalizes, only plain ASCII is safe to decode here then
+inline bool CanDecodeUtf8Source(const std::string& src)
+{
+#if defined(TARGET_DARWIN)
+  return AsciiPrefixLength(src.data(), src.length()) == src.length();
+#else
+  return true;
+#endif
+}
+
+} // unnamed namespace
+
 enum SpecialCharset
 {
   NotSpecialCharset = 0,
@@ -86,9 +317,15 @@ public:
   CConverterType(const std::string&  sourceCharset,        enum SpecialCharset targetSpecialCharset, unsigned int targetSingleCharMaxLen = 1);
   CConverterType(enum SpecialCharset sourceSpecialCharset, enum SpecialCharset targetSpecialCharset, unsigned int targetSingleCharMaxLen = 1);
   CConverterType(const CConverterType& other);
-  ~CConverterType();
 
-  iconv_t GetConverter(CSingleLock& converterLock);
+  /**
+   * Open a new iconv handle for this conversion, the caller owns it
+   */
+  iconv_t OpenConverter();
+  /**
+   * Changes with every reset, handles opened for an older generation must not be used anymore
+   */
+  unsigned int GetGeneration() const { return m_generation; }
 
   void Reset(void);
   void ReinitTo(const std::string& sourceCharset, const std::string& targetCharset, unsigned int targetSingleCharMaxLen = 1);
@@ -103,7 +340,7 @@ private:
   std::string         m_sourceCharset;
   enum SpecialCharset m_targetSpecialCharset;
   std::string         m_targetCharset;
-  iconv_t             m_iconv;
+  std::atomic<unsigned int> m_generation;
   unsigned int        m_targetSingleCharMaxLen;
 };
 
@@ -112,7 +349,7 @@ CConverterType::CConverterType(const std::string& sourceCharset, const std::stri
   m_sourceCharset(sourceCharset),
   m_targetSpecialCharset(NotSpecialCharset),
   m_targetCharset(targetCharset),
-  m_iconv(NO_ICONV),
+  m_generation(1),
   m_targetSingleCharMaxLen(targetSingleCharMaxLen)
 {
 }
@@ -122,7 +359,7 @@ CConverterType::CConverterType(enum SpecialCharset sourceSpecialCharset, const s
   m_sourceCharset(),
   m_targetSpecialCharset(NotSpecialCharset),
   m_targetCharset(targetCharset),
-  m_iconv(NO_ICONV),
+  m_generation(1),
   m_targetSingleCharMaxLen(targetSingleCharMaxLen)
 {
 }
@@ -132,7 +369,7 @@ CConverterType::CConverterType(const std::string& sourceCharset, enum SpecialCha
   m_sourceCharset(sourceCharset),
   m_targetSpecialCharset(targetSpecialCharset),
   m_targetCharset(),
-  m_iconv(NO_ICONV),
+  m_generation(1),
   m_targetSingleCharMaxLen(targetSingleCharMaxLen)
 {
 }
@@ -142,7 +379,7 @@ CConverterType::CConverterType(enum SpecialCharset sourceSpecialCharset, enum Sp
   m_sourceCharset(),
   m_targetSpecialCharset(targetSpecialCharset),
   m_targetCharset(),
-  m_iconv(NO_ICONV),
+  m_generation(1),
   m_targetSingleCharMaxLen(targetSingleCharMaxLen)
 {
 }
@@ -152,50 +389,32 @@ CConverterType::CConverterType(const CConverterType& other) : CCriticalSection()
   m_sourceCharset(other.m_sourceCharset),
   m_targetSpecialCharset(other.m_targetSpecialCharset),
   m_targetCharset(other.m_targetCharset),
-  m_iconv(NO_ICONV),
+  m_generation(1),
   m_targetSingleCharMaxLen(other.m_targetSingleCharMaxLen)
 {
 }
 
-CConverterType::~CConverterType()
+iconv_t CConverterType::OpenConverter()
 {
   CSingleLock lock(*this);
-  if (m_iconv != NO_ICONV)
-    iconv_close(m_iconv);
-  lock.Leave(); // ensure unlocking before final destruction
-}
-
-iconv_t CConverterType::GetConverter(CSingleLock& converterLock)
-{
-  // ensure that this unique instance is locked externally
-  if (&converterLock.get_underlying() != this)
-    return NO_ICONV;
-
-  if (m_iconv == NO_ICONV)
-  {
-    if (m_sourceSpecialCharset)
-      m_sourceCharset = ResolveSpecialCharset(m_sourceSpecialCharset);
-    if (m_targetSpecialCharset)
-      m_targetCharset = ResolveSpecialCharset(m_targetSpecialCharset);
+  if (m_sourceSpecialCharset && m_sourceCharset.empty())
+    m_sourceCharset = ResolveSpecialCharset(m_sourceSpecialCharset);
+  if (m_targetSpecialCharset && m_targetCharset.empty())
+    m_targetCharset = ResolveSpecialCharset(m_targetSpecialCharset);
 
-    m_iconv = iconv_open(m_targetCharset.c_str(), m_sourceCharset.c_str());
+  iconv_t converter = iconv_open(m_targetCharset.c_str(), m_sourceCharset.c_str());
 
-    if (m_iconv == NO_ICONV)
-      CLog::Log(LOGERROR, "%s: iconv_open() for \"%s\" -> \"%s\" failed, errno = %d (%s)",
-                __FUNCTION__, m_sourceCharset.c_str(), m_targetCharset.c_str(), errno, strerror(errno));
-  }
+  if (converter == NO_ICONV)
+    CLog::Log(LOGERROR, "%s: iconv_open() for \"%s\" -> \"%s\" failed, errno = %d (%s)",
+              __FUNCTION__, m_sourceCharset.c_str(), m_targetCharset.c_str(), errno, strerror(errno));
 
-  return m_iconv;
+  return converter;
 }
 
 void CConverterType::Reset(void)
 {
   CSingleLock lock(*this);
-  if (m_iconv != NO_ICONV)
-  {
-    iconv_close(m_iconv);
-    m_iconv = NO_ICONV;
-  }
+  m_generation++;
 
   if (m_sourceSpecialCharset)
     m_sourceCharset.clear();
@@ -209,11 +428,7 @@ void CConverterType::ReinitTo(const std::string& sourceCharset, const std::strin
   CSingleLock lock(*this);
   if (sourceCharset != m_sourceCharset || targetCharset != m_targetCharset)
   {
-    if (m_iconv != NO_ICONV)
-    {
-      iconv_close(m_iconv);
-      m_iconv = NO_ICONV;
-    }
+    m_generation++;
 
     m_sourceSpecialCharset = NotSpecialCharset;
     m_sourceCharset = sourceCharset;
@@ -282,6 +497,23 @@ public:
 
   static CConverterType m_stdConversion[NumberOfStdConversionTypes];
   static CCriticalSection m_critSectionFriBiDi;
+
+private:
+  /* iconv handles aren't thread safe, every thread uses its own ones instead of sharing a locked one */
+  struct SThreadConverter
+  {
+    ~SThreadConverter() { Close(); }
+    void Close()
+    {
+      if (handle != NO_ICONV)
+        iconv_close(handle);
+      handle = NO_ICONV;
+    }
+
+    iconv_t handle = NO_ICONV;
+    unsigned int generation = 0;
+  };
+  static thread_local SThreadConverter m_threadConversion[NumberOfStdConversionTypes];
 };
 
 /* single symbol sizes in chars */
@@ -309,6 +541,8 @@ CConverterType CCharsetConverter::CInnerConverter::m_stdConversion[NumberOfStdCo
 };
 
 CCriticalSection CCharsetConverter::CInnerConverter::m_critSectionFriBiDi;
+thread_local CCharsetConverter::CInnerConverter::SThreadConverter
+    CCharsetConverter::CInnerConverter::m_threadConversion[NumberOfStdConversionTypes];
 
 template<class INPUT,class OUTPUT>
 bool CCharsetConverter::CInnerConverter::stdConvert(StdConversionType convertType, const INPUT& strSource, OUTPUT& strDest, bool failOnInvalidChar /*= false*/)
@@ -321,9 +555,15 @@ bool CCharsetConverter::CInnerConverter::stdConvert(StdConversionType convertTyp
     return false;
 
   CConverterType& convType = m_stdConversion[convertType];
-  CSingleLock converterLock(convType);
+  SThreadConverter& converter = m_threadConversion[convertType];
+  if (converter.handle == NO_ICONV || converter.generation != convType.GetGeneration())
+  {
+    converter.Close();
+    converter.generation = convType.GetGeneration();
+    converter.handle = convType.OpenConverter();
+  }
 
-  return convert(convType.GetConverter(converterLock), convType.GetTargetSingleCharMaxLen(), strSource, strDest, failOnInvalidChar);
+  return convert(converter.handle, convType.GetTargetSingleCharMaxLen(), strSource, strDest, failOnInvalidChar);
 }
 
 template<class INPUT,class OUTPUT>
@@ -644,6 +884,9 @@ void CCharsetConverter::reinitCharsetsFromSettings(void)
 
 bool CCharsetConverter::utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& utf32StringDst, bool failOnBadChar /*= true*/)
 {
+  if (CanDecodeUtf8Source(utf8StringSrc))
+    return DecodeUtf8(utf8StringSrc, utf32StringDst, failOnBadChar);
+
   return CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32StringDst, failOnBadChar);
 }
 
@@ -659,17 +902,17 @@ bool CCharsetConverter::utf8ToUtf32Visual(const std::string& utf8StringSrc, std:
   if (bVisualBiDiFlip)
   {
     std::u32string converted;
-    if (!CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, converted, failOnBadChar))
+    if (!utf8ToUtf32(utf8StringSrc, converted, failOnBadChar))
       return false;
 
     return CInnerConverter::logicalToVisualBiDi(converted, utf32StringDst, forceLTRReadingOrder ? FRIBIDI_TYPE_LTR : FRIBIDI_TYPE_PDF, failOnBadChar);
   }
-  return CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32StringDst, failOnBadChar);
+  return utf8ToUtf32(utf8StringSrc, utf32StringDst, failOnBadChar);
 }
 
 bool CCharsetConverter::utf32ToUtf8(const std::u32string& utf32StringSrc, std::string& utf8StringDst, bool failOnBadChar /*= true*/)
 {
-  return CInnerConverter::stdConvert(Utf32ToUtf8, utf32StringSrc, utf8StringDst, failOnBadChar);
+  return DecodeUtf32(utf32StringSrc, utf8StringDst, failOnBadChar);
 }
 
 std::string CCharsetConverter::utf32ToUtf8(const std::u32string& utf32StringSrc, bool failOnBadChar /*= false*/)
@@ -684,9 +927,11 @@ bool CCharsetConverter::utf32ToW(const std::u32string& utf32StringSrc, std::wstr
 #ifdef WCHAR_IS_UCS_4
   wStringDst.assign((const wchar_t*)utf32StringSrc.c_str(), utf32StringSrc.length());
   return true;
-#else // !WCHAR_IS_UCS_4
+#elif defined(WCHAR_IS_UNICODE)
+  return DecodeUtf32(utf32StringSrc, wStringDst, failOnBadChar);
+#else // !WCHAR_IS_UNICODE
   return CInnerConverter::stdConvert(Utf32ToW, utf32StringSrc, wStringDst, failOnBadChar);
-#endif // !WCHAR_IS_UCS_4
+#endif // !WCHAR_IS_UNICODE
 }
 
 bool CCharsetConverter::utf32logicalToVisualBiDi(const std::u32string& logicalStringSrc,
@@ -705,8 +950,12 @@ bool CCharsetConverter::wToUtf32(const std::wstring& wStringSrc, std::u32string&
 #ifdef WCHAR_IS_UCS_4
   /* UCS-4 is almost equal to UTF-32, but UTF-32 has strict limits on possible values, while UCS-4 is usually unchecked.
    * With this "conversion" we ensure that output will be valid UTF-32 string. */
-#endif
+  return DecodeUtf32(wStringSrc, utf32StringDst, failOnBadChar);
+#elif defined(WCHAR_IS_UTF16)
+  return DecodeUtf16(wStringSrc, HOST_IS_BIG_ENDIAN, utf32StringDst, failOnBadChar);
+#else
   return CInnerConverter::stdConvert(WToUtf32, wStringSrc, utf32StringDst, failOnBadChar);
+#endif
 }
 
 // The bVisualBiDiFlip forces a flip of characters for hebrew/arabic languages, only set to false if the flipping
@@ -719,15 +968,20 @@ bool CCharsetConverter::utf8ToW(const std::string& utf8StringSrc, std::wstring&
   {
     wStringDst.clear();
     std::u32string utf32str;
-    if (!CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32str, failOnBadChar))
+    if (!utf8ToUtf32(utf8StringSrc, utf32str, failOnBadChar))
       return false;
 
     std::u32string utf32flipped;
     const bool bidiResult = CInnerConverter::logicalToVisualBiDi(utf32str, utf32flipped, forceLTRReadingOrder ? FRIBIDI_TYPE_LTR : FRIBIDI_TYPE_PDF, failOnBadChar);
 
-    return CInnerConverter::stdConvert(Utf32ToW, utf32flipped, wStringDst, failOnBadChar) && bidiResult;
+    return utf32ToW(utf32flipped, wStringDst, failOnBadChar) && bidiResult;
   }
 
+#ifdef WCHAR_IS_UNICODE
+  if (CanDecodeUtf8Source(utf8StringSrc))
+    return DecodeUtf8(utf8StringSrc, wStringDst, failOnBadChar);
+#endif
+
   return CInnerConverter::stdConvert(Utf8toW, utf8StringSrc, wStringDst, failOnBadChar);
 }
 
@@ -810,18 +1064,24 @@ bool CCharsetConverter::unknownToUTF8(const std::string& stringSrc, std::string&
 
 bool CCharsetConverter::wToUTF8(const std::wstring& wStringSrc, std::string& utf8StringDst, bool failOnBadChar /*= false*/)
 {
+#ifdef WCHAR_IS_UCS_4
+  return DecodeUtf32(wStringSrc, utf8StringDst, failOnBadChar);
+#elif defined(WCHAR_IS_UTF16)
+  return DecodeUtf16(wStringSrc, HOST_IS_BIG_ENDIAN, utf8StringDst, failOnBadChar);
+#else
   return CInnerConverter::stdConvert(WtoUtf8, wStringSrc, utf8StringDst, failOnBadChar);
+#endif
 }
 
 bool CCharsetConverter::utf16BEtoUTF8(const std::u16string& utf16StringSrc, std::string& utf8StringDst)
 {
-  return CInnerConverter::stdConvert(Utf16BEtoUtf8, utf16StringSrc, utf8StringDst);
+  return DecodeUtf16(utf16StringSrc, true, utf8StringDst, false);
 }
 
 bool CCharsetConverter::utf16LEtoUTF8(const std::u16string& utf16StringSrc,
                                       std::string& utf8StringDst)
 {
-  return CInnerConverter::stdConvert(Utf16LEtoUtf8, utf16StringSrc, utf8StringDst);
+  return DecodeUtf16(utf16StringSrc, false, utf8StringDst, false);
 }
 
 bool CCharsetConverter::ucs2ToUTF8(const std::u16string& ucs2StringSrc, std::string& utf8StringDst)
@@ -831,7 +1091,11 @@ bool CCharsetConverter::ucs2ToUTF8(const std::u16string& ucs2StringSrc, std::str
 
 bool CCharsetConverter::utf16LEtoW(const std::u16string& utf16String, std::wstring& wString)
 {
+#ifdef WCHAR_IS_UNICODE
+  return DecodeUtf16(utf16String, false, wString, false);
+#else
   return CInnerConverter::stdConvert(Utf16LEtoW, utf16String, wString);
+#endif
 }
 
 bool CCharsetConverter::utf32ToStringCharset(const std::u32string& utf32StringSrc, std::string& stringDst)
@@ -857,7 +1121,7 @@ bool CCharsetConverter::utf8logicalToVisualBiDi(const std::string& utf8StringSrc
   if (!utf8ToUtf32Visual(utf8StringSrc, utf32flipped, true, true, failOnBadString))
     return false;
 
-  return CInnerConverter::stdConvert(Utf32ToUtf8, utf32flipped, utf8StringDst, failOnBadString);
+  return utf32ToUtf8(utf32flipped, utf8StringDst, failOnBadString);
 }
 
 void CCharsetConverter::SettingOptionsCharsetsFiller(const SettingConstPtr& setting,
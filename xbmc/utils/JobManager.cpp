@@ -41,7 +41,7 @@ CJobWorker::~CJobWorker()
 
 void CJobWorker::Process()
 {
-  SetPriority( GetMinPriority() );
+  SetRole(ThreadRole::BACKGROUND_CPU);
   while (true)
   {
     // request an item from our manager (this call is blocking)
@@ -68,8 +68,8 @@ void CJobQueue::CJobPointer::CancelJob()
   m_id = 0;
 }
 
-CJobQueue::CJobQueue(bool lifo, unsigned int jobsAtOnce, CJob::PRIORITY priority)
-: m_jobsAtOnce(jobsAtOnce), m_priority(priority), m_lifo(lifo)
+CJobQueue::CJobQueue(bool lifo, unsigned int jobsAtOnce, CJob::PRIORITY priority, bool throttleWhilePaused)
+: m_jobsAtOnce(jobsAtOnce), m_priority(priority), m_lifo(lifo), m_throttleWhilePaused(throttleWhilePaused)
 {
 }
 
@@ -130,7 +130,11 @@ bool CJobQueue::AddJob(CJob *job)
 void CJobQueue::QueueNextJob()
 {
   CSingleLock lock(m_section);
-  if (m_jobQueue.size() && m_processing.size() < m_jobsAtOnce)
+
+  // while jobs are paused for playback a throttled queue runs one job at a time
+  const unsigned int jobsAtOnce =
+      m_throttleWhilePaused && CJobManager::GetInstance().IsPaused() ? 1 : m_jobsAtOnce;
+  while (m_jobQueue.size() && m_processing.size() < jobsAtOnce)
   {
     CJobPointer &job = m_jobQueue.back();
     job.m_id = CJobManager::GetInstance().AddJob(job.m_job, this, m_priority);
@@ -302,6 +306,12 @@ void CJobManager::UnPauseJobs()
   m_pauseJobs = false;
 }
 
+bool CJobManager::IsPaused() const
+{
+  CSingleLock lock(m_section);
+  return m_pauseJobs;
+}
+
 bool CJobManager::IsProcessing(const CJob::PRIORITY &priority) const
 {
   CSingleLock lock(m_section);
@@ -317,6 +327,15 @@ bool CJobManager::IsProcessing(const CJob::PRIORITY &priority) const
   return false;
 }
 
+float CJobManager::GetWorkerUsage() const
+{
+  CSingleLock lock(m_section);
+  float usage = 0.0f;
+  for (CJobWorker* worker : m_workers)
+    usage += worker->GetRelativeUsage();
+  return usage;
+}
+
 int CJobManager::IsProcessing(const std::string &type) const
 {
   int jobsMatched = 0;
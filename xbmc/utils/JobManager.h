@@ -91,9 +91,13 @@ public:
    \param lifo whether the queue should be processed last in first out or first in first out.  Defaults to false (first in first out)
    \param jobsAtOnce number of jobs at once to process.  Defaults to 1.
    \param priority priority of this queue.
+   \param throttleWhilePaused whether to process only one job at once while the job manager is paused.
+   Meant for fan-out work such as library scans that shouldn't occupy every worker during playback.
+   Defaults to false.
    \sa CJob
    */
-  CJobQueue(bool lifo = false, unsigned int jobsAtOnce = 1, CJob::PRIORITY priority = CJob::PRIORITY_LOW);
+  CJobQueue(bool lifo = false, unsigned int jobsAtOnce = 1, CJob::PRIORITY priority = CJob::PRIORITY_LOW,
+            bool throttleWhilePaused = false);
 
   /*!
    \brief CJobQueue destructor
@@ -176,6 +180,7 @@ private:
   CJob::PRIORITY m_priority;
   mutable CCriticalSection m_section;
   bool m_lifo;
+  bool m_throttleWhilePaused;
 };
 
 /*!
@@ -291,6 +296,7 @@ public:
   /*!
    \brief Suspends queueing of jobs with priority PRIORITY_LOW_PAUSABLE until unpaused
    Useful to (for ex) stop queuing thumb jobs during video start/playback.
+   Job queues created with throttleWhilePaused run one job at a time while paused, see CJobQueue.
    Does not affect currently processing jobs, use IsProcessing to see if any need to be waited on
    \sa UnPauseJobs()
    */
@@ -302,6 +308,12 @@ public:
    */
   void UnPauseJobs();
 
+  /*!
+   \brief Checks whether jobs are currently paused
+   \sa PauseJobs()
+   */
+  bool IsPaused() const;
+
   /*!
    \brief Checks to see if any jobs with specific priority are currently processing.
    \param priority to search for
@@ -309,6 +321,11 @@ public:
    */
   bool IsProcessing(const CJob::PRIORITY &priority) const;
 
+  /*!
+   \brief Relative cpu usage of all job workers since the last call, summed over workers.
+   */
+  float GetWorkerUsage() const;
+
 protected:
   friend class CJobWorker;
   friend class CJob;
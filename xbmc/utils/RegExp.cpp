@@ -9,12 +9,17 @@
 #include "RegExp.h"
 
 #include "log.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #include "utils/StringUtils.h"
 #include "utils/Utf8Utils.h"
 
 #include <algorithm>
+#include <map>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <tuple>
 
 using namespace PCRE;
 
@@ -41,6 +46,58 @@ int CRegExp::m_Utf8Supported = -1;
 int CRegExp::m_UcpSupported  = -1;
 int CRegExp::m_JitSupported  = -1;
 
+struct CRegExp::CompiledPattern
+{
+  CompiledPattern() = default;
+  CompiledPattern(const CompiledPattern&) = delete;
+  CompiledPattern& operator=(const CompiledPattern&) = delete;
+  ~CompiledPattern()
+  {
+    if (sd)
+      pcre_free_study(sd);
+    if (re)
+      pcre_free(re);
+  }
+
+  pcre* re = nullptr;
+  pcre_extra* sd = nullptr;
+};
+
+namespace
+{
+// upper bound for the number of compiled expressions kept around for reuse
+constexpr size_t MaxCachedPatterns = 256;
+
+#ifdef PCRE_HAS_JIT_CODE
+// JIT-compiled code is shared between threads, so every thread matches on its own stack
+pcre_jit_stack* GetThreadJitStack(void*)
+{
+  struct JitStack
+  {
+    ~JitStack()
+    {
+      if (stack)
+        pcre_jit_stack_free(stack);
+    }
+    pcre_jit_stack* stack = nullptr;
+    bool allocated = false;
+  };
+  static thread_local JitStack jitStack;
+
+  if (!jitStack.allocated)
+  {
+    jitStack.allocated = true;
+    jitStack.stack = pcre_jit_stack_alloc(32*1024, 512*1024);
+    if (jitStack.stack == NULL)
+      CLog::Log(LOGWARNING, "%s: can't allocate address space for JIT stack", __FUNCTION__);
+  }
+
+  // without a stack PCRE falls back to a small one on the machine stack
+  return jitStack.stack;
+}
+#endif
+} // unnamed namespace
+
 
 CRegExp::CRegExp(bool caseless /*= false*/, CRegExp::utf8Mode utf8 /*= asciiOnly*/)
 {
@@ -64,10 +121,8 @@ void CRegExp::InitValues(bool caseless /*= false*/, CRegExp::utf8Mode utf8 /*= a
   }
 
   m_offset      = 0;
-  m_jitCompiled = false;
   m_bMatched    = false;
   m_iMatchCount = 0;
-  m_jitStack    = NULL;
 
   memset(m_iOvector, 0, sizeof(m_iOvector));
 }
@@ -226,7 +281,6 @@ CRegExp::CRegExp(const CRegExp& re)
 {
   m_re = NULL;
   m_sd = NULL;
-  m_jitStack = NULL;
   m_utf8Mode = re.m_utf8Mode;
   m_iOptions = re.m_iOptions;
   *this = re;
@@ -234,27 +288,23 @@ CRegExp::CRegExp(const CRegExp& re)
 
 CRegExp& CRegExp::operator=(const CRegExp& re)
 {
-  size_t size;
+  if (this == &re)
+    return *this;
+
   Cleanup();
-  m_jitCompiled = false;
   m_pattern = re.m_pattern;
   if (re.m_re)
   {
-    if (pcre_fullinfo(re.m_re, NULL, PCRE_INFO_SIZE, &size) >= 0)
-    {
-      if ((m_re = (pcre*)malloc(size)))
-      {
-        memcpy(m_re, re.m_re, size);
-        memcpy(m_iOvector, re.m_iOvector, OVECCOUNT*sizeof(int));
-        m_offset = re.m_offset;
-        m_iMatchCount = re.m_iMatchCount;
-        m_bMatched = re.m_bMatched;
-        m_subject = re.m_subject;
-        m_iOptions = re.m_iOptions;
-      }
-      else
-        CLog::Log(LOGFATAL, "%s: Failed to allocate memory", __FUNCTION__);
-    }
+    // compiled expressions are immutable, so they are shared instead of copied
+    m_compiled = re.m_compiled;
+    m_re = re.m_re;
+    m_sd = re.m_sd;
+    memcpy(m_iOvector, re.m_iOvector, OVECCOUNT*sizeof(int));
+    m_offset = re.m_offset;
+    m_iMatchCount = re.m_iMatchCount;
+    m_bMatched = re.m_bMatched;
+    m_subject = re.m_subject;
+    m_iOptions = re.m_iOptions;
   }
   return *this;
 }
@@ -270,51 +320,102 @@ bool CRegExp::RegComp(const char *re, studyMode study /*= NoStudy*/)
     return false;
 
   m_offset           = 0;
-  m_jitCompiled      = false;
   m_bMatched         = false;
   m_iMatchCount      = 0;
-  const char *errMsg = NULL;
-  int errOffset      = 0;
   int options        = m_iOptions;
   if (m_utf8Mode == autoUtf8 && requireUtf8(re))
     options |= (IsUtf8Supported() ? PCRE_UTF8 : 0) | (AreUnicodePropertiesSupported() ? PCRE_UCP : 0);
 
   Cleanup();
 
-  m_re = pcre_compile(re, options, &errMsg, &errOffset, NULL);
-  if (!m_re)
+  m_compiled = GetCompiledPattern(re, options, study);
+  if (!m_compiled)
   {
     m_pattern.clear();
-    CLog::Log(LOGERROR, "PCRE: %s. Compilation failed at offset %d in expression '%s'",
-              errMsg, errOffset, re);
     return false;
   }
 
+  m_re = m_compiled->re;
+  m_sd = m_compiled->sd;
   m_pattern = re;
 
+  return true;
+}
+
+std::shared_ptr<const CRegExp::CompiledPattern> CRegExp::GetCompiledPattern(const char* re,
+                                                                            int options,
+                                                                            studyMode study)
+{
+  struct CachedPattern
+  {
+    std::shared_ptr<const CompiledPattern> pattern;
+    uint64_t lastUse;
+  };
+  static CCriticalSection cacheLock;
+  static std::map<std::tuple<std::string, int, int>, CachedPattern> cache;
+  static uint64_t useCounter = 0;
+
+  auto key = std::make_tuple(std::string(re), options, static_cast<int>(study));
+  {
+    CSingleLock lock(cacheLock);
+    auto it = cache.find(key);
+    if (it != cache.end())
+    {
+      it->second.lastUse = ++useCounter;
+      return it->second.pattern;
+    }
+  }
+
+  const char *errMsg = NULL;
+  int errOffset      = 0;
+
+  auto compiled = std::make_shared<CompiledPattern>();
+  compiled->re = pcre_compile(re, options, &errMsg, &errOffset, NULL);
+  if (!compiled->re)
+  {
+    CLog::Log(LOGERROR, "PCRE: %s. Compilation failed at offset %d in expression '%s'",
+              errMsg, errOffset, re);
+    return nullptr;
+  }
+
   if (study)
   {
     const bool jitCompile = (study == StudyWithJitComp) && IsJitSupported();
     const int studyOptions = jitCompile ? PCRE_STUDY_JIT_COMPILE : 0;
 
-    m_sd = pcre_study(m_re, studyOptions, &errMsg);
+    compiled->sd = pcre_study(compiled->re, studyOptions, &errMsg);
     if (errMsg != NULL)
     {
       CLog::Log(LOGWARNING, "%s: PCRE error \"%s\" while studying expression", __FUNCTION__, errMsg);
-      if (m_sd != NULL)
+      if (compiled->sd != NULL)
       {
-        pcre_free_study(m_sd);
-        m_sd = NULL;
+        pcre_free_study(compiled->sd);
+        compiled->sd = NULL;
       }
     }
+#ifdef PCRE_HAS_JIT_CODE
     else if (jitCompile)
     {
       int jitPresent = 0;
-      m_jitCompiled = (pcre_fullinfo(m_re, m_sd, PCRE_INFO_JIT, &jitPresent) == 0 && jitPresent == 1);
+      if (pcre_fullinfo(compiled->re, compiled->sd, PCRE_INFO_JIT, &jitPresent) == 0 && jitPresent == 1)
+        pcre_assign_jit_stack(compiled->sd, GetThreadJitStack, NULL);
     }
+#endif
   }
 
-  return true;
+  CSingleLock lock(cacheLock);
+  if (cache.size() >= MaxCachedPatterns)
+  {
+    // users of an evicted expression keep it alive as long as they need it
+    auto oldest = std::min_element(cache.begin(), cache.end(), [](const auto& a, const auto& b) {
+      return a.second.lastUse < b.second.lastUse;
+    });
+    cache.erase(oldest);
+  }
+  // another thread may have compiled the same expression meanwhile, either one is fine
+  cache[std::move(key)] = CachedPattern{compiled, ++useCounter};
+
+  return compiled;
 }
 
 int CRegExp::RegFind(const char *str, unsigned int startoffset /*= 0*/, int maxNumberOfCharsToTest /*= -1*/)
@@ -322,6 +423,45 @@ int CRegExp::RegFind(const char *str, unsigned int startoffset /*= 0*/, int maxN
   return PrivateRegFind(strlen(str), str, startoffset, maxNumberOfCharsToTest);
 }
 
+void CRegExp::LogMatchError(int rc, const std::string& subject, const int* ovector)
+{
+  static const int fragmentLen = 80; // length of excerpt before erroneous char for log
+  switch(rc)
+  {
+  case PCRE_ERROR_MATCHLIMIT:
+    CLog::Log(LOGERROR, "PCRE: Match limit reached");
+    break;
+
+#ifdef PCRE_ERROR_SHORTUTF8
+  case PCRE_ERROR_SHORTUTF8:
+    {
+      const size_t startPos = (subject.length() > fragmentLen) ? CUtf8Utils::RFindValidUtf8Char(subject, subject.length() - fragmentLen) : 0;
+      if (startPos != std::string::npos)
+        CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character at the end of string. Text before bad character: \"%s\"", subject.substr(startPos).c_str());
+      else
+        CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character at the end of string");
+      break;
+    }
+#endif
+  case PCRE_ERROR_BADUTF8:
+    {
+      const size_t startPos = (ovector[0] > fragmentLen) ? CUtf8Utils::RFindValidUtf8Char(subject, ovector[0] - fragmentLen) : 0;
+      if (ovector[0] >= 0 && startPos != std::string::npos)
+        CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character, error code: %d, position: %d. Text before bad char: \"%s\"", ovector[1], ovector[0], subject.substr(startPos, ovector[0] - startPos + 1).c_str());
+      else
+        CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character, error code: %d, position: %d", ovector[1], ovector[0]);
+      break;
+    }
+  case PCRE_ERROR_BADUTF8_OFFSET:
+    CLog::Log(LOGERROR, "PCRE: Offset is pointing to the middle of UTF-8 character");
+    break;
+
+  default:
+    CLog::Log(LOGERROR, "PCRE: Unknown error: %d", rc);
+    break;
+  }
+}
+
 int CRegExp::PrivateRegFind(size_t bufferLen, const char *str, unsigned int startoffset /* = 0*/, int maxNumberOfCharsToTest /*= -1*/)
 {
   m_offset      = 0;
@@ -346,63 +486,17 @@ int CRegExp::PrivateRegFind(size_t bufferLen, const char *str, unsigned int star
     return -1;
   }
 
-#ifdef PCRE_HAS_JIT_CODE
-  if (m_jitCompiled && !m_jitStack)
-  {
-    m_jitStack = pcre_jit_stack_alloc(32*1024, 512*1024);
-    if (m_jitStack == NULL)
-      CLog::Log(LOGWARNING, "%s: can't allocate address space for JIT stack", __FUNCTION__);
-
-    pcre_assign_jit_stack(m_sd, NULL, m_jitStack);
-  }
-#endif
-
   if (maxNumberOfCharsToTest >= 0)
     bufferLen = std::min<size_t>(bufferLen, startoffset + maxNumberOfCharsToTest);
 
   m_subject.assign(str + startoffset, bufferLen - startoffset);
-  int rc = pcre_exec(m_re, NULL, m_subject.c_str(), m_subject.length(), 0, 0, m_iOvector, OVECCOUNT);
+  int rc = pcre_exec(m_re, m_sd, m_subject.c_str(), m_subject.length(), 0, 0, m_iOvector, OVECCOUNT);
 
   if (rc<1)
   {
-    static const int fragmentLen = 80; // length of excerpt before erroneous char for log
-    switch(rc)
-    {
-    case PCRE_ERROR_NOMATCH:
-      return -1;
-
-    case PCRE_ERROR_MATCHLIMIT:
-      CLog::Log(LOGERROR, "PCRE: Match limit reached");
-      return -1;
-
-#ifdef PCRE_ERROR_SHORTUTF8
-    case PCRE_ERROR_SHORTUTF8:
-      {
-        const size_t startPos = (m_subject.length() > fragmentLen) ? CUtf8Utils::RFindValidUtf8Char(m_subject, m_subject.length() - fragmentLen) : 0;
-        if (startPos != std::string::npos)
-          CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character at the end of string. Text before bad character: \"%s\"", m_subject.substr(startPos).c_str());
-        else
-          CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character at the end of string");
-        return -1;
-      }
-#endif
-    case PCRE_ERROR_BADUTF8:
-      {
-        const size_t startPos = (m_iOvector[0] > fragmentLen) ? CUtf8Utils::RFindValidUtf8Char(m_subject, m_iOvector[0] - fragmentLen) : 0;
-        if (m_iOvector[0] >= 0 && startPos != std::string::npos)
-          CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character, error code: %d, position: %d. Text before bad char: \"%s\"", m_iOvector[1], m_iOvector[0], m_subject.substr(startPos, m_iOvector[0] - startPos + 1).c_str());
-        else
-          CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character, error code: %d, position: %d", m_iOvector[1], m_iOvector[0]);
-        return -1;
-      }
-    case PCRE_ERROR_BADUTF8_OFFSET:
-      CLog::Log(LOGERROR, "PCRE: Offset is pointing to the middle of UTF-8 character");
-      return -1;
-
-    default:
-      CLog::Log(LOGERROR, "PCRE: Unknown error: %d", rc);
-      return -1;
-    }
+    if (rc != PCRE_ERROR_NOMATCH)
+      LogMatchError(rc, m_subject, m_iOvector);
+    return -1;
   }
   m_offset = startoffset;
   m_bMatched = true;
@@ -547,25 +641,9 @@ void CRegExp::DumpOvector(int iLog /* = LOGDEBUG */)
 
 void CRegExp::Cleanup()
 {
-  if (m_re)
-  {
-    pcre_free(m_re);
-    m_re = NULL;
-  }
-
-  if (m_sd)
-  {
-    pcre_free_study(m_sd);
-    m_sd = NULL;
-  }
-
-#ifdef PCRE_HAS_JIT_CODE
-  if (m_jitStack)
-  {
-    pcre_jit_stack_free(m_jitStack);
-    m_jitStack = NULL;
-  }
-#endif
+  m_compiled.reset();
+  m_re = NULL;
+  m_sd = NULL;
 }
 
 inline bool CRegExp::IsValidSubNumber(int iSub) const
@@ -640,3 +718,149 @@ bool CRegExp::IsJitSupported(void)
 
   return m_JitSupported == 1;
 }
+
+CRegExpSet::CRegExpSet(bool caseless, CRegExp::utf8Mode utf8)
+  : m_caseless(caseless), m_utf8(utf8)
+{
+}
+
+bool CRegExpSet::CanCombine(const std::string& expression)
+{
+  // Back references, subroutine calls and named groups refer to groups which are renumbered
+  // or duplicated by combining, (*VERB) options and \Q...\E depend on the whole pattern.
+  static const char* const notCombinable[] = {"\\Q", "\\g", "\\k", "(?P",
+                                              "(?&",  "(?R",  "(?'",  "(*"};
+  for (const char* construct : notCombinable)
+  {
+    if (expression.find(construct) != std::string::npos)
+      return false;
+  }
+
+  for (size_t pos = 0; pos + 1 < expression.size(); pos++)
+  {
+    const char next = expression[pos + 1];
+    if (expression[pos] == '\\' && isdigit(next))
+      return false; // back reference or octal code
+    if (expression[pos] == '(' && next == '?' && pos + 2 < expression.size())
+    {
+      const char option = expression[pos + 2];
+      if (isdigit(option) || option == '+' ||
+          (option == '-' && pos + 3 < expression.size() && isdigit(expression[pos + 3])))
+        return false; // subroutine call by number
+      if (option == '<' && pos + 3 < expression.size() && expression[pos + 3] != '=' &&
+          expression[pos + 3] != '!')
+        return false; // named group
+    }
+  }
+  return true;
+}
+
+bool CRegExpSet::RegComp(const std::vector<std::string>& expressions)
+{
+  m_alternations.clear();
+  m_expressions = expressions;
+  bool result = true;
+
+  // combinable expressions and their number of groups, separately for ascii and UTF-8 mode
+  std::vector<std::pair<size_t, int>> combinable[2];
+
+  for (size_t i = 0; i < expressions.size(); i++)
+  {
+    // compiled expressions are cached, so this is cheap when combining again later
+    CRegExp regexp(m_caseless, m_utf8);
+    if (!regexp.RegComp(expressions[i]))
+    {
+      result = false;
+      continue;
+    }
+
+    const int groups = regexp.GetCaptureTotal();
+    if (!CanCombine(expressions[i]) || groups >= CRegExp::m_MaxNumOfBackrefrences)
+    {
+      Alternation alternation{CRegExp(m_caseless, m_utf8), {{0, i}}};
+      alternation.regexp.RegComp(expressions[i], CRegExp::StudyWithJitComp);
+      m_alternations.push_back(std::move(alternation));
+      continue;
+    }
+
+    const bool utf8 = m_utf8 == CRegExp::forceUtf8 ||
+                      (m_utf8 == CRegExp::autoUtf8 && CRegExp::requireUtf8(expressions[i]));
+    combinable[utf8 ? 1 : 0].emplace_back(i, groups);
+  }
+
+  for (int utf8 = 0; utf8 < 2; utf8++)
+  {
+    const CRegExp::utf8Mode mode = utf8 ? CRegExp::forceUtf8 : CRegExp::asciiOnly;
+    auto part = combinable[utf8].begin();
+    while (part != combinable[utf8].end())
+    {
+      // wrap every expression into a group, as many as fit into the match vector
+      Alternation alternation{CRegExp(m_caseless, mode), {}};
+      std::string pattern;
+      int groups = 0;
+      for (; part != combinable[utf8].end() &&
+             groups + 1 + part->second <= CRegExp::m_MaxNumOfBackrefrences;
+           ++part)
+      {
+        pattern += pattern.empty() ? "(" : "|(";
+        pattern += expressions[part->first];
+        pattern += ")";
+        alternation.expressions.emplace_back(groups + 1, part->first);
+        groups += 1 + part->second;
+      }
+
+      if (alternation.expressions.size() == 1)
+      {
+        alternation.expressions[0].first = 0;
+        alternation.regexp.RegComp(expressions[alternation.expressions[0].second],
+                                   CRegExp::StudyWithJitComp);
+        m_alternations.push_back(std::move(alternation));
+      }
+      else if (alternation.regexp.RegComp(pattern, CRegExp::StudyWithJitComp))
+        m_alternations.push_back(std::move(alternation));
+      else
+      {
+        // shouldn't happen for expressions which are valid on their own, test them one by one
+        for (const auto& expression : alternation.expressions)
+        {
+          Alternation single{CRegExp(m_caseless, mode), {{0, expression.second}}};
+          single.regexp.RegComp(expressions[expression.second], CRegExp::StudyWithJitComp);
+          m_alternations.push_back(std::move(single));
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+int CRegExpSet::RegFind(const std::string& str) const
+{
+  MatchState match;
+  for (const auto& alternation : m_alternations)
+  {
+    if (!alternation.regexp.m_re)
+      continue;
+
+    match.count = pcre_exec(alternation.regexp.m_re, alternation.regexp.m_sd, str.c_str(),
+                            str.length(), 0, 0, match.ovector, CRegExp::OVECCOUNT);
+    if (match.count < 1)
+    {
+      if (match.count != PCRE_ERROR_NOMATCH)
+        CRegExp::LogMatchError(match.count, str, match.ovector);
+      continue;
+    }
+
+    for (const auto& expression : alternation.expressions)
+    {
+      if (expression.first == 0 || match.Matched(expression.first))
+        return static_cast<int>(expression.second);
+    }
+  }
+  return -1;
+}
+
+const std::string& CRegExpSet::GetExpression(int index) const
+{
+  return m_expressions[index];
+}
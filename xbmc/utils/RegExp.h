@@ -10,6 +10,7 @@
 
 //! @todo - move to std::regex (after switching to gcc 4.9 or higher) and get rid of CRegExp
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -65,6 +66,8 @@ public:
 
   /**
    * Compile (prepare) regular expression
+   * Compiled expressions are cached and shared, compiling an expression which was compiled
+   * recently with the same options is cheap.
    * @param re          The regular expression
    * @param study (optional) Controls study of expression, useful if expression will be used
    *                         several times
@@ -134,26 +137,31 @@ public:
   static bool IsJitSupported(void);
 
 private:
+  friend class CRegExpSet;
+  struct CompiledPattern;
+
   int PrivateRegFind(size_t bufferLen, const char *str, unsigned int startoffset = 0, int maxNumberOfCharsToTest = -1);
+  static void LogMatchError(int rc, const std::string& subject, const int* ovector);
   void InitValues(bool caseless = false, CRegExp::utf8Mode utf8 = asciiOnly);
   static bool requireUtf8(const std::string& regexp);
   static int readCharXCode(const std::string& regexp, size_t& pos);
   static bool isCharClassWithUnicode(const std::string& regexp, size_t& pos);
 
+  static std::shared_ptr<const CompiledPattern> GetCompiledPattern(const char* re, int options, studyMode study);
+
   void Cleanup();
   inline bool IsValidSubNumber(int iSub) const;
 
-  PCRE::pcre* m_re;
-  PCRE::pcre_extra* m_sd;
+  std::shared_ptr<const CompiledPattern> m_compiled;
+  PCRE::pcre* m_re; // owned by m_compiled
+  PCRE::pcre_extra* m_sd; // owned by m_compiled
   static const int OVECCOUNT=(m_MaxNumOfBackrefrences + 1) * 3;
   unsigned int m_offset;
   int         m_iOvector[OVECCOUNT];
   utf8Mode    m_utf8Mode;
   int         m_iMatchCount;
   int         m_iOptions;
-  bool        m_jitCompiled;
   bool        m_bMatched;
-  PCRE::pcre_jit_stack* m_jitStack;
   std::string m_subject;
   std::string m_pattern;
   static int  m_Utf8Supported;
@@ -163,3 +171,61 @@ private:
 
 typedef std::vector<CRegExp> VECCREGEXP;
 
+/**
+ * Set of regular expressions tested against a string in a single pass.
+ *
+ * The expressions are combined into one alternation and compiled with JIT where possible,
+ * so a string is scanned once instead of once per expression. Expressions which can't be
+ * combined (like ones using back references) are tested one after the other.
+ */
+class CRegExpSet
+{
+public:
+  /**
+   * @param caseless Matching will be case insensitive if set to true
+   * @param utf8     Control UTF-8 processing
+   */
+  CRegExpSet(bool caseless, CRegExp::utf8Mode utf8);
+
+  /**
+   * Compile the expressions, invalid expressions are logged and skipped
+   * @return true if all expressions were compiled
+   */
+  bool RegComp(const std::vector<std::string>& expressions);
+
+  /**
+   * Test the expressions against a string, can be called from several threads at once
+   * @return index of an expression matching the string, -1 if none matches. If several
+   *         expressions match, it's unspecified which of them is returned.
+   */
+  int RegFind(const std::string& str) const;
+
+  /**
+   * @return the expression at an index returned by RegFind
+   */
+  const std::string& GetExpression(int index) const;
+
+private:
+  static bool CanCombine(const std::string& expression);
+
+  struct Alternation
+  {
+    CRegExp regexp;
+    std::vector<std::pair<int, size_t>> expressions; // capture group and index of each expression
+  };
+
+  // state of a single match, kept by the caller as the alternations are shared between threads
+  struct MatchState
+  {
+    int ovector[CRegExp::OVECCOUNT];
+    int count = 0;
+
+    bool Matched(int group) const { return group < count && ovector[group * 2] >= 0; }
+  };
+
+  bool m_caseless;
+  CRegExp::utf8Mode m_utf8;
+  std::vector<std::string> m_expressions;
+  std::vector<Alternation> m_alternations;
+};
+
@@ -458,130 +458,76 @@ std::string ByBPM(SortAttribute attributes, const SortItem& values)
                              ByLabel(attributes, values));
 }
 
-bool preliminarySort(const SortItem &left, const SortItem &right, bool handleFolder, bool &result, std::wstring &labelLeft, std::wstring &labelRight)
-{
-  // make sure both items have the necessary data to do the sorting
-  SortItem::const_iterator itLeftSort, itRightSort;
-  if ((itLeftSort = left.find(FieldSort)) == left.end())
-  {
-    result = false;
-    return true;
-  }
-  if ((itRightSort = right.find(FieldSort)) == right.end())
-  {
-    result = true;
-    return true;
-  }
-
-  // look at special sorting behaviour
-  SortItem::const_iterator itLeft, itRight;
-  SortSpecial leftSortSpecial = SortSpecialNone;
-  SortSpecial rightSortSpecial = SortSpecialNone;
-  if ((itLeft = left.find(FieldSortSpecial)) != left.end() && itLeft->second.asInteger() <= (int64_t)SortSpecialOnBottom)
-    leftSortSpecial = (SortSpecial)itLeft->second.asInteger();
-  if ((itRight = right.find(FieldSortSpecial)) != right.end() && itRight->second.asInteger() <= (int64_t)SortSpecialOnBottom)
-    rightSortSpecial = (SortSpecial)itRight->second.asInteger();
-
-  // one has a special sort
-  if (leftSortSpecial != rightSortSpecial)
-  {
-    // left should be sorted on top
-    // or right should be sorted on bottom
-    // => left is sorted above right
-    if (leftSortSpecial == SortSpecialOnTop ||
-        rightSortSpecial == SortSpecialOnBottom)
-    {
-      result = true;
-      return true;
-    }
-
-    // otherwise right is sorted above left
-    result = false;
-    return true;
-  }
-  // both have either sort on top or sort on bottom -> leave as-is
-  else if (leftSortSpecial != SortSpecialNone && leftSortSpecial == rightSortSpecial)
-  {
-    result = false;
-    return true;
-  }
-
-  if (handleFolder)
-  {
-    itLeft = left.find(FieldFolder);
-    itRight = right.find(FieldFolder);
-    if (itLeft != left.end() && itRight != right.end() &&
-        itLeft->second.asBoolean() != itRight->second.asBoolean())
-    {
-      result = itLeft->second.asBoolean();
-      return true;
-    }
-  }
-
-  labelLeft = itLeftSort->second.asWideString();
-  labelRight = itRightSort->second.asWideString();
-
-  return false;
-}
-
-bool SorterAscending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
-
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
-}
+// What the sorting needs to know about an item, collected once per item instead of on every
+// comparison
+struct SortEntry
+{
+  std::string key; // collation key of FieldSort
+  SortSpecial special;
+  int folder; // FieldFolder, -1 if unknown
+  size_t index; // position of the item before sorting
+};
 
-bool SorterDescending(const SortItem &left, const SortItem &right)
+SortEntry GetSortEntry(const SortItem &item, size_t index)
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
+  SortEntry entry;
+  entry.index = index;
+  entry.key = StringUtils::AlphaNumericSortKey(item.at(FieldSort).asWideString().c_str());
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
-}
+  SortItem::const_iterator it;
+  entry.special = SortSpecialNone;
+  if ((it = item.find(FieldSortSpecial)) != item.end() && it->second.asInteger() <= (int64_t)SortSpecialOnBottom)
+    entry.special = (SortSpecial)it->second.asInteger();
 
-bool SorterIgnoreFoldersAscending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
+  entry.folder = -1;
+  if ((it = item.find(FieldFolder)) != item.end())
+    entry.folder = it->second.asBoolean() ? 1 : 0;
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
+  return entry;
 }
 
-bool SorterIgnoreFoldersDescending(const SortItem &left, const SortItem &right)
+class SortEntryLess
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
+public:
+  SortEntryLess(bool descending, bool handleFolder)
+    : m_descending(descending), m_handleFolder(handleFolder)
+  {
+  }
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
-}
+  bool operator()(const SortEntry &left, const SortEntry &right) const
+  {
+    // one has a special sort
+    if (left.special != right.special)
+    {
+      // left should be sorted on top
+      // or right should be sorted on bottom
+      // => left is sorted above right
+      return left.special == SortSpecialOnTop || right.special == SortSpecialOnBottom;
+    }
+    // both have either sort on top or sort on bottom -> leave as-is
+    else if (left.special != SortSpecialNone)
+      return false;
 
-bool SorterIndirectAscending(const SortItemPtr &left, const SortItemPtr &right)
-{
-  return SorterAscending(*left, *right);
-}
+    if (m_handleFolder && left.folder >= 0 && right.folder >= 0 && left.folder != right.folder)
+      return left.folder == 1;
 
-bool SorterIndirectDescending(const SortItemPtr &left, const SortItemPtr &right)
-{
-  return SorterDescending(*left, *right);
-}
+    const int result = left.key.compare(right.key);
+    return m_descending ? result > 0 : result < 0;
+  }
 
-bool SorterIndirectIgnoreFoldersAscending(const SortItemPtr &left, const SortItemPtr &right)
-{
-  return SorterIgnoreFoldersAscending(*left, *right);
-}
+private:
+  bool m_descending;
+  bool m_handleFolder;
+};
 
-bool SorterIndirectIgnoreFoldersDescending(const SortItemPtr &left, const SortItemPtr &right)
+template<typename Items>
+void ApplySortOrder(Items &items, const std::vector<SortEntry> &entries)
 {
-  return SorterIgnoreFoldersDescending(*left, *right);
+  Items sorted;
+  sorted.reserve(items.size());
+  for (const SortEntry &entry : entries)
+    sorted.push_back(std::move(items[entry.index]));
+  items.swap(sorted);
 }
 
 // clang-format off
@@ -940,6 +886,9 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
     {
       Fields sortingFields = GetFieldsForSorting(sortBy);
 
+      std::vector<SortEntry> entries;
+      entries.reserve(items.size());
+
       // Prepare the string used for sorting and store it under FieldSort
       for (DatabaseResults::iterator item = items.begin(); item != items.end(); ++item)
       {
@@ -953,10 +902,14 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
         std::wstring sortLabel;
         g_charsetConverter.utf8ToW(preparator(attributes, *item), sortLabel, false);
         item->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        entries.push_back(GetSortEntry(*item, entries.size()));
       }
 
       // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorter(sortOrder, attributes));
+      std::stable_sort(entries.begin(), entries.end(),
+                       SortEntryLess(sortOrder == SortOrderDescending,
+                                     !(attributes & SortAttributeIgnoreFolders)));
+      ApplySortOrder(items, entries);
     }
   }
 
@@ -979,6 +932,9 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
     {
       Fields sortingFields = GetFieldsForSorting(sortBy);
 
+      std::vector<SortEntry> entries;
+      entries.reserve(items.size());
+
       // Prepare the string used for sorting and store it under FieldSort
       for (SortItems::iterator item = items.begin(); item != items.end(); ++item)
       {
@@ -992,10 +948,14 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
         std::wstring sortLabel;
         g_charsetConverter.utf8ToW(preparator(attributes, **item), sortLabel, false);
         (*item)->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        entries.push_back(GetSortEntry(**item, entries.size()));
       }
 
       // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorterIndirect(sortOrder, attributes));
+      std::stable_sort(entries.begin(), entries.end(),
+                       SortEntryLess(sortOrder == SortOrderDescending,
+                                     !(attributes & SortAttributeIgnoreFolders)));
+      ApplySortOrder(items, entries);
     }
   }
 
@@ -1048,22 +1008,6 @@ const SortUtils::SortPreparator& SortUtils::getPreparator(SortBy sortBy)
   return m_preparators[SortByNone];
 }
 
-SortUtils::Sorter SortUtils::getSorter(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrderDescending ? SorterIgnoreFoldersDescending : SorterIgnoreFoldersAscending;
-
-  return sortOrder == SortOrderDescending ? SorterDescending : SorterAscending;
-}
-
-SortUtils::SorterIndirect SortUtils::getSorterIndirect(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrderDescending ? SorterIndirectIgnoreFoldersDescending : SorterIndirectIgnoreFoldersAscending;
-
-  return sortOrder == SortOrderDescending ? SorterIndirectDescending : SorterIndirectAscending;
-}
-
 const Fields& SortUtils::GetFieldsForSorting(SortBy sortBy)
 {
   std::map<SortBy, Fields>::const_iterator it = m_sortingFields.find(sortBy);
@@ -46,6 +46,12 @@
 #include <fstrcmp.h>
 #include <memory.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 // don't move or std functions end up in PCRE namespace
 // clang-format off
 #include "utils/RegExp.h"
@@ -336,9 +342,55 @@ wchar_t toupperUnicode(const wchar_t& c)
   return c;
 }
 
+// Strings are UTF-8, so only ascii letters change case. Unlike ::tolower() this doesn't depend
+// on the C locale and can't touch the bytes of multi-byte sequences.
+static inline char tolowerAscii(char c)
+{
+  return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+// flips the case of all chars in the range [first, last], which must be ascii letters
+static void FlipAsciiCase(std::string& str, char first, char last)
+{
+  char* data = &str[0];
+  const size_t size = str.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  // signed compares, so bytes of multi-byte sequences are never in range
+  const __m128i lower = _mm_set1_epi8(first - 1);
+  const __m128i upper = _mm_set1_epi8(last + 1);
+  const __m128i flip = _mm_set1_epi8(0x20);
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i inRange =
+        _mm_and_si128(_mm_cmpgt_epi8(chars, lower), _mm_cmplt_epi8(chars, upper));
+    chars = _mm_xor_si128(chars, _mm_and_si128(inRange, flip));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), chars);
+  }
+#elif defined(__ARM_NEON)
+  const uint8x16_t lower = vdupq_n_u8(first);
+  const uint8x16_t upper = vdupq_n_u8(last);
+  const uint8x16_t flip = vdupq_n_u8(0x20);
+  for (; i + 16 <= size; i += 16)
+  {
+    uint8_t* block = reinterpret_cast<uint8_t*>(data + i);
+    uint8x16_t chars = vld1q_u8(block);
+    const uint8x16_t inRange = vandq_u8(vcgeq_u8(chars, lower), vcleq_u8(chars, upper));
+    chars = veorq_u8(chars, vandq_u8(inRange, flip));
+    vst1q_u8(block, chars);
+  }
+#endif
+  for (; i < size; ++i)
+  {
+    if (data[i] >= first && data[i] <= last)
+      data[i] ^= 0x20;
+  }
+}
+
 void StringUtils::ToUpper(std::string &str)
 {
-  std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+  FlipAsciiCase(str, 'a', 'z');
 }
 
 void StringUtils::ToUpper(std::wstring &str)
@@ -348,7 +400,7 @@ void StringUtils::ToUpper(std::wstring &str)
 
 void StringUtils::ToLower(std::string &str)
 {
-  transform(str.begin(), str.end(), str.begin(), ::tolower);
+  FlipAsciiCase(str, 'A', 'Z');
 }
 
 void StringUtils::ToLower(std::wstring &str)
@@ -402,7 +454,7 @@ bool StringUtils::EqualsNoCase(const char *s1, const char *s2)
   {
     const char c1 = *s1++; // const local variable should help compiler to optimize
     c2 = *s2++;
-    if (c1 != c2 && ::tolower(c1) != ::tolower(c2)) // This includes the possibility that one of the characters is the null-terminator, which implies a string mismatch.
+    if (c1 != c2 && tolowerAscii(c1) != tolowerAscii(c2)) // This includes the possibility that one of the characters is the null-terminator, which implies a string mismatch.
       return false;
   } while (c2 != '\0'); // At this point, we know c1 == c2, so there's no need to test them both.
   return true;
@@ -422,8 +474,8 @@ int StringUtils::CompareNoCase(const char* s1, const char* s2, size_t n /* = 0 *
     const char c1 = *s1++; // const local variable should help compiler to optimize
     c2 = *s2++;
     index++;
-    if (c1 != c2 && ::tolower(c1) != ::tolower(c2)) // This includes the possibility that one of the characters is the null-terminator, which implies a string mismatch.
-      return ::tolower(c1) - ::tolower(c2);
+    if (c1 != c2 && tolowerAscii(c1) != tolowerAscii(c2)) // This includes the possibility that one of the characters is the null-terminator, which implies a string mismatch.
+      return tolowerAscii(c1) - tolowerAscii(c2);
   } while (c2 != '\0' &&
            index != n); // At this point, we know c1 == c2, so there's no need to test them both.
   return 0;
@@ -1139,6 +1191,121 @@ int64_t StringUtils::AlphaNumericCompare(const wchar_t* left, const wchar_t* rig
   return 0; // files are the same
 }
 
+namespace
+{
+// Element tags of the keys built by AlphaNumericSortKey(), in collation order. Every tag is
+// followed by a fixed number of bytes, so no element is a prefix of a different one and keys
+// compare element by element.
+enum SortKeyTag : unsigned char
+{
+  SORTKEY_SYMBOL = 1, // ascii punctuation and symbols, 1 byte
+  SORTKEY_CONTROL = 2, // control chars which sort before digits, 1 byte
+  SORTKEY_NUMBER = 3, // run of up to 15 digits, 7 bytes big endian value
+  SORTKEY_CHAR = 4, // folded char below 0x100, 1 byte
+  SORTKEY_WIDECHAR = 5, // folded char from 0x100, 2 bytes
+  SORTKEY_LOCALE = 2, // with locale collation any char or number, see AppendLocaleWeight()
+};
+
+bool IsSortSymbol(wchar_t c)
+{
+  return (c >= 32 && c < L'0') || (c > L'9' && c < L'A') || (c > L'Z' && c < L'a') ||
+         (c > L'z' && c < 128);
+}
+
+const wchar_t* ParseSortNumber(const wchar_t* str, int64_t& number)
+{
+  // same as AlphaNumericCompare(), only up to 15 digits
+  const wchar_t* end = str + 15;
+  number = 0;
+  while (str < end && *str >= L'0' && *str <= L'9')
+    number = number * 10 + (*str++ - L'0');
+  return str;
+}
+
+void AppendSortNumber(std::string& key, int64_t number)
+{
+  for (int shift = 48; shift >= 0; shift -= 8)
+    key.push_back(static_cast<char>((number >> shift) & 0xFF));
+}
+
+// Appends the locale's transformed representation of the char followed by a terminator below
+// any transformed value, which keeps the order of std::collate::compare() for single chars.
+void AppendLocaleWeight(std::string& key, const std::collate<wchar_t>& coll, wchar_t c)
+{
+  key.push_back(static_cast<char>(SORTKEY_LOCALE));
+  const std::wstring weight = coll.transform(&c, &c + 1);
+  for (wchar_t w : weight)
+  {
+    const uint32_t value = static_cast<uint32_t>(w);
+    key.push_back(static_cast<char>(value >> 24));
+    key.push_back(static_cast<char>((value >> 16) & 0xFF));
+    key.push_back(static_cast<char>((value >> 8) & 0xFF));
+    key.push_back(static_cast<char>(value & 0xFF));
+  }
+  key.append(4, '\0');
+}
+} // unnamed namespace
+
+std::string StringUtils::AlphaNumericSortKey(const wchar_t* str)
+{
+  const bool useLocale = g_langInfo.UseLocaleCollation();
+  const std::collate<wchar_t>* coll = nullptr;
+  if (useLocale)
+    coll = &std::use_facet<std::collate<wchar_t>>(g_langInfo.GetSystemLocale());
+
+  std::string key;
+  key.reserve(wcslen(str) * 2);
+  while (*str != 0)
+  {
+    wchar_t c = *str;
+    if (c >= L'0' && c <= L'9')
+    {
+      // AlphaNumericCompare() compares a number with a char by its first digit. Digits sort
+      // between control chars and letters, so all numbers can share the place of '0'.
+      int64_t number;
+      str = ParseSortNumber(str, number);
+      if (useLocale)
+        AppendLocaleWeight(key, *coll, L'0');
+      key.push_back(static_cast<char>(SORTKEY_NUMBER));
+      AppendSortNumber(key, number);
+      continue;
+    }
+
+    str++;
+    if (IsSortSymbol(c))
+    {
+      key.push_back(static_cast<char>(SORTKEY_SYMBOL));
+      key.push_back(static_cast<char>(c));
+      continue;
+    }
+
+    if (!useLocale && c > 128)
+      c = GetCollationWeight(c);
+    if (c >= L'A' && c <= L'Z')
+      c += L'a' - L'A';
+
+    if (useLocale)
+      AppendLocaleWeight(key, *coll, c);
+    else if (c < L'0')
+    {
+      key.push_back(static_cast<char>(SORTKEY_CONTROL));
+      key.push_back(static_cast<char>(c));
+    }
+    else if (c < 0x100)
+    {
+      key.push_back(static_cast<char>(SORTKEY_CHAR));
+      key.push_back(static_cast<char>(c));
+    }
+    else
+    {
+      key.push_back(static_cast<char>(SORTKEY_WIDECHAR));
+      key.push_back(static_cast<char>((c >> 8) & 0xFF));
+      key.push_back(static_cast<char>(c & 0xFF));
+    }
+  }
+  return key;
+}
+
 /*
   Convert the UTF8 character to which z points into a 31-bit Unicode point.
   Return how many bytes (0 to 3) of UTF8 data encode the character.
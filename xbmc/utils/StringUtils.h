@@ -247,6 +247,17 @@ public:
                                              size_t iMaxStrings = 0);
   static int FindNumber(const std::string& strInput, const std::string &strFind);
   static int64_t AlphaNumericCompare(const wchar_t *left, const wchar_t *right);
+  /*! \brief Build a binary collation key for AlphaNumericCompare()
+
+   Comparing two keys with std::string::compare() orders them the same way AlphaNumericCompare()
+   orders the strings they were built from, so a sort only pays for folding case, accents and
+   parsing numbers once per string instead of once per comparison.
+   Keys depend on the collation in use (see CLangInfo::UseLocaleCollation()) and must not be
+   stored or compared across a change of it.
+   \param str the string to build the key for
+   \return the collation key, which may contain NUL bytes
+   */
+  static std::string AlphaNumericSortKey(const wchar_t* str);
   static int AlphaNumericCollation(int nKey1, const void* pKey1, int nKey2, const void* pKey2);
   static long TimeStringToSeconds(const std::string &timeString);
   static void RemoveCRLF(std::string& strLine);
@@ -144,7 +144,7 @@ CVariant::CVariant(VariantType type)
       m_data.dvalue = 0.0;
       break;
     case VariantTypeString:
-      m_data.string = new std::string();
+      setString("", 0);
       break;
     case VariantTypeWideString:
       m_data.wstring = new std::wstring();
@@ -208,25 +208,25 @@ CVariant::CVariant(bool boolean)
 CVariant::CVariant(const char *str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  setString(str, strlen(str));
 }
 
 CVariant::CVariant(const char *str, unsigned int length)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str, length);
+  setString(str, length);
 }
 
 CVariant::CVariant(const std::string &str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  setString(str.c_str(), str.length());
 }
 
 CVariant::CVariant(std::string &&str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(std::move(str));
+  setString(std::move(str));
 }
 
 CVariant::CVariant(const wchar_t *str)
@@ -262,6 +262,15 @@ CVariant::CVariant(const std::vector<std::string> &strArray)
     m_data.array->push_back(CVariant(item));
 }
 
+CVariant::CVariant(std::vector<std::string> &&strArray)
+{
+  m_type = VariantTypeArray;
+  m_data.array = new VariantArray;
+  m_data.array->reserve(strArray.size());
+  for (auto& item : strArray)
+    m_data.array->emplace_back(std::move(item));
+}
+
 CVariant::CVariant(const std::map<std::string, std::string> &strMap)
 {
   m_type = VariantTypeObject;
@@ -276,6 +285,12 @@ CVariant::CVariant(const std::map<std::string, CVariant> &variantMap)
   m_data.map = new VariantMap(variantMap.begin(), variantMap.end());
 }
 
+CVariant::CVariant(std::map<std::string, CVariant> &&variantMap)
+{
+  m_type = VariantTypeObject;
+  m_data.map = new VariantMap(std::move(variantMap));
+}
+
 CVariant::CVariant(const CVariant &variant)
 {
   m_type = VariantTypeNull;
@@ -301,8 +316,10 @@ void CVariant::cleanup()
   switch (m_type)
   {
   case VariantTypeString:
-    delete m_data.string;
+    if (!m_smallString)
+      delete m_data.string;
     m_data.string = nullptr;
+    m_smallString = false;
     break;
 
   case VariantTypeWideString:
@@ -325,6 +342,43 @@ void CVariant::cleanup()
   m_type = VariantTypeNull;
 }
 
+void CVariant::setString(const char *str, size_t length)
+{
+  if (length <= SMALL_STRING_CAPACITY)
+  {
+    memcpy(m_data.smallString.data, str, length);
+    m_data.smallString.data[length] = '\0';
+    m_data.smallString.length = static_cast<uint8_t>(length);
+    m_smallString = true;
+  }
+  else
+  {
+    m_data.string = new std::string(str, length);
+    m_smallString = false;
+  }
+}
+
+void CVariant::setString(std::string &&str)
+{
+  if (str.length() <= SMALL_STRING_CAPACITY)
+    setString(str.c_str(), str.length());
+  else
+  {
+    m_data.string = new std::string(std::move(str));
+    m_smallString = false;
+  }
+}
+
+const char *CVariant::stringData() const
+{
+  return m_smallString ? m_data.smallString.data : m_data.string->c_str();
+}
+
+size_t CVariant::stringLength() const
+{
+  return m_smallString ? m_data.smallString.length : m_data.string->length();
+}
+
 bool CVariant::isInteger() const
 {
   return isSignedInteger() || isUnsignedInteger();
@@ -391,7 +445,7 @@ int64_t CVariant::asInteger(int64_t fallback) const
     case VariantTypeDouble:
       return (int64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2int64(*m_data.string, fallback);
+      return str2int64(std::string(stringData(), stringLength()), fallback);
     case VariantTypeWideString:
       return str2int64(*m_data.wstring, fallback);
     default:
@@ -417,7 +471,7 @@ uint64_t CVariant::asUnsignedInteger(uint64_t fallback) const
     case VariantTypeDouble:
       return (uint64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2uint64(*m_data.string, fallback);
+      return str2uint64(std::string(stringData(), stringLength()), fallback);
     case VariantTypeWideString:
       return str2uint64(*m_data.wstring, fallback);
     default:
@@ -443,7 +497,7 @@ double CVariant::asDouble(double fallback) const
     case VariantTypeUnsignedInteger:
       return (double)m_data.unsignedinteger;
     case VariantTypeString:
-      return str2double(*m_data.string, fallback);
+      return str2double(std::string(stringData(), stringLength()), fallback);
     case VariantTypeWideString:
       return str2double(*m_data.wstring, fallback);
     default:
@@ -464,7 +518,7 @@ float CVariant::asFloat(float fallback) const
     case VariantTypeUnsignedInteger:
       return (float)m_data.unsignedinteger;
     case VariantTypeString:
-      return (float)str2double(*m_data.string, fallback);
+      return (float)str2double(std::string(stringData(), stringLength()), fallback);
     case VariantTypeWideString:
       return (float)str2double(*m_data.wstring, fallback);
     default:
@@ -487,9 +541,13 @@ bool CVariant::asBoolean(bool fallback) const
     case VariantTypeDouble:
       return (m_data.dvalue != 0);
     case VariantTypeString:
-      if (m_data.string->empty() || m_data.string->compare("0") == 0 || m_data.string->compare("false") == 0)
+    {
+      const size_t length = stringLength();
+      if (length == 0 || (length == 1 && stringData()[0] == '0') ||
+          (length == 5 && memcmp(stringData(), "false", 5) == 0))
         return false;
       return true;
+    }
     case VariantTypeWideString:
       if (m_data.wstring->empty() || m_data.wstring->compare(L"0") == 0 || m_data.wstring->compare(L"false") == 0)
         return false;
@@ -506,7 +564,7 @@ std::string CVariant::asString(const std::string &fallback /* = "" */) const
   switch (m_type)
   {
     case VariantTypeString:
-      return *m_data.string;
+      return std::string(stringData(), stringLength());
     case VariantTypeBoolean:
       return m_data.boolean ? "true" : "false";
     case VariantTypeInteger:
@@ -557,6 +615,20 @@ CVariant &CVariant::operator[](const std::string &key)
     return ConstNullVariant;
 }
 
+CVariant &CVariant::operator[](std::string &&key)
+{
+  if (m_type == VariantTypeNull)
+  {
+    m_type = VariantTypeObject;
+    m_data.map = new VariantMap;
+  }
+
+  if (m_type == VariantTypeObject)
+    return (*m_data.map)[std::move(key)];
+  else
+    return ConstNullVariant;
+}
+
 const CVariant &CVariant::operator[](const std::string &key) const
 {
   VariantMap::const_iterator it;
@@ -606,7 +678,13 @@ CVariant &CVariant::operator=(const CVariant &rhs)
     m_data.dvalue = rhs.m_data.dvalue;
     break;
   case VariantTypeString:
-    m_data.string = new std::string(*rhs.m_data.string);
+    if (rhs.m_smallString)
+    {
+      m_data.smallString = rhs.m_data.smallString;
+      m_smallString = true;
+    }
+    else
+      m_data.string = new std::string(*rhs.m_data.string);
     break;
   case VariantTypeWideString:
     m_data.wstring = new std::wstring(*rhs.m_data.wstring);
@@ -634,6 +712,7 @@ CVariant& CVariant::operator=(CVariant&& rhs) noexcept
     cleanup();
 
   m_type = rhs.m_type;
+  m_smallString = rhs.m_smallString;
   m_data = rhs.m_data;
 
   //Should be enough to just set m_type here
@@ -648,6 +727,7 @@ CVariant& CVariant::operator=(CVariant&& rhs) noexcept
     rhs.m_data.map = nullptr;
 
   rhs.m_type = VariantTypeNull;
+  rhs.m_smallString = false;
 
   return *this;
 }
@@ -667,7 +747,8 @@ bool CVariant::operator==(const CVariant &rhs) const
     case VariantTypeDouble:
       return m_data.dvalue == rhs.m_data.dvalue;
     case VariantTypeString:
-      return *m_data.string == *rhs.m_data.string;
+      return stringLength() == rhs.stringLength() &&
+             memcmp(stringData(), rhs.stringData(), stringLength()) == 0;
     case VariantTypeWideString:
       return *m_data.wstring == *rhs.m_data.wstring;
     case VariantTypeArray:
@@ -730,7 +811,7 @@ void CVariant::append(CVariant&& variant)
 const char *CVariant::c_str() const
 {
   if (m_type == VariantTypeString)
-    return m_data.string->c_str();
+    return stringData();
   else
     return NULL;
 }
@@ -738,12 +819,15 @@ const char *CVariant::c_str() const
 void CVariant::swap(CVariant &rhs)
 {
   VariantType  temp_type = m_type;
+  bool         temp_small = m_smallString;
   VariantUnion temp_data = m_data;
 
   m_type = rhs.m_type;
+  m_smallString = rhs.m_smallString;
   m_data = rhs.m_data;
 
   rhs.m_type = temp_type;
+  rhs.m_smallString = temp_small;
   rhs.m_data = temp_data;
 }
 
@@ -818,7 +902,7 @@ unsigned int CVariant::size() const
   else if (m_type == VariantTypeArray)
     return m_data.array->size();
   else if (m_type == VariantTypeString)
-    return m_data.string->size();
+    return stringLength();
   else if (m_type == VariantTypeWideString)
     return m_data.wstring->size();
   else
@@ -832,7 +916,7 @@ bool CVariant::empty() const
   else if (m_type == VariantTypeArray)
     return m_data.array->empty();
   else if (m_type == VariantTypeString)
-    return m_data.string->empty();
+    return stringLength() == 0;
   else if (m_type == VariantTypeWideString)
     return m_data.wstring->empty();
   else if (m_type == VariantTypeNull)
@@ -848,7 +932,11 @@ void CVariant::clear()
   else if (m_type == VariantTypeArray)
     m_data.array->clear();
   else if (m_type == VariantTypeString)
-    m_data.string->clear();
+  {
+    cleanup();
+    m_type = VariantTypeString;
+    setString("", 0);
+  }
   else if (m_type == VariantTypeWideString)
     m_data.wstring->clear();
 }
@@ -61,8 +61,10 @@ public:
   CVariant(const std::wstring &str);
   CVariant(std::wstring &&str);
   CVariant(const std::vector<std::string> &strArray);
+  CVariant(std::vector<std::string> &&strArray);
   CVariant(const std::map<std::string, std::string> &strMap);
   CVariant(const std::map<std::string, CVariant> &variantMap);
+  CVariant(std::map<std::string, CVariant> &&variantMap);
   CVariant(const CVariant &variant);
   CVariant(CVariant&& rhs) noexcept;
   ~CVariant();
@@ -93,6 +95,7 @@ public:
   float asFloat(float fallback = 0.0f) const;
 
   CVariant &operator[](const std::string &key);
+  CVariant &operator[](std::string &&key);
   const CVariant &operator[](const std::string &key) const;
   CVariant &operator[](unsigned int position);
   const CVariant &operator[](unsigned int position) const;
@@ -145,12 +148,27 @@ public:
 
 private:
   void cleanup();
+  void setString(const char *str, size_t length);
+  void setString(std::string &&str);
+  const char *stringData() const;
+  size_t stringLength() const;
+
+  // strings up to this length are stored inside the variant without allocating
+  static constexpr size_t SMALL_STRING_CAPACITY = 22;
+
+  struct SmallString
+  {
+    char data[SMALL_STRING_CAPACITY + 1];
+    uint8_t length;
+  };
+
   union VariantUnion
   {
     int64_t integer;
     uint64_t unsignedinteger;
     bool boolean;
     double dvalue;
+    SmallString smallString;
     std::string *string;
     std::wstring *wstring;
     VariantArray *array;
@@ -158,6 +176,7 @@ private:
   };
 
   VariantType m_type;
+  bool m_smallString = false; // string is stored in m_data.smallString
   VariantUnion m_data;
 
   static VariantArray EMPTY_ARRAY;
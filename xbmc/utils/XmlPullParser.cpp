@@ -0,0 +1,539 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XmlPullParser.h"
+
+#include "filesystem/File.h"
+#include "utils/CharsetConverter.h"
+#include "utils/CharsetDetection.h"
+
+#include <algorithm>
+#include <stdint.h>
+#include <utility>
+
+namespace
+{
+
+// length of the longest character reference "&#x10FFFF;"
+constexpr size_t MaxEntityLength = 10;
+
+bool IsWhitespace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool IsNameEnd(char c)
+{
+  return IsWhitespace(c) || c == '/' || c == '>' || c == '=';
+}
+
+void AppendUtf8(uint32_t codepoint, std::string& str)
+{
+  if (codepoint < 0x80)
+    str += static_cast<char>(codepoint);
+  else if (codepoint < 0x800)
+  {
+    str += static_cast<char>(0xC0 | (codepoint >> 6));
+    str += static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+  else if (codepoint < 0x10000)
+  {
+    str += static_cast<char>(0xE0 | (codepoint >> 12));
+    str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    str += static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+  else
+  {
+    str += static_cast<char>(0xF0 | (codepoint >> 18));
+    str += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+    str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    str += static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+}
+
+// decode the character reference between "&#" and ";"
+bool AppendCharacterReference(const char* ref, const char* end, std::string& decoded)
+{
+  int base = 10;
+  if (ref < end && *ref == 'x')
+  {
+    base = 16;
+    ref++;
+  }
+  if (ref == end)
+    return false;
+
+  uint32_t codepoint = 0;
+  for (; ref < end; ref++)
+  {
+    int digit;
+    if (*ref >= '0' && *ref <= '9')
+      digit = *ref - '0';
+    else if (base == 16 && *ref >= 'a' && *ref <= 'f')
+      digit = *ref - 'a' + 10;
+    else if (base == 16 && *ref >= 'A' && *ref <= 'F')
+      digit = *ref - 'A' + 10;
+    else
+      return false;
+
+    codepoint = codepoint * base + digit;
+    if (codepoint > 0x10FFFF)
+      return false;
+  }
+  if (codepoint == 0)
+    return false;
+
+  AppendUtf8(codepoint, decoded);
+  return true;
+}
+
+} // unnamed namespace
+
+CXmlPullParser::CXmlPullParser(const char* data, size_t size)
+{
+  Reset(data, size);
+}
+
+CXmlPullParser::CXmlPullParser(const std::string& data) : CXmlPullParser(data.c_str(), data.size())
+{
+}
+
+bool CXmlPullParser::LoadFile(const std::string& filename)
+{
+  XFILE::CFile file;
+  XFILE::auto_buffer buffer;
+  if (file.LoadFile(filename, buffer) <= 0)
+  {
+    m_buffer.clear();
+    Reset(m_buffer.c_str(), 0);
+    return false;
+  }
+
+  m_buffer.assign(buffer.get(), buffer.size());
+  buffer.clear(); // free memory early
+
+  std::string encoding;
+  if (CCharsetDetection::DetectXmlEncoding(m_buffer, encoding) && encoding != "UTF-8")
+  {
+    std::string converted;
+    if (g_charsetConverter.ToUtf8(encoding, m_buffer, converted, true) && !converted.empty())
+      m_buffer = std::move(converted);
+  }
+
+  Reset(m_buffer.c_str(), m_buffer.size());
+  return true;
+}
+
+void CXmlPullParser::Reset(const char* data, size_t size)
+{
+  m_data = data;
+  m_size = size;
+  m_pos = 0;
+  m_token = Token::StartDocument;
+  m_name = StringRef();
+  m_text = StringRef();
+  m_attributes = StringRef();
+  m_cdata = false;
+  m_depth = 0;
+  m_emptyElement = false;
+  m_pendingEnd = false;
+  m_tokenStart = 0;
+  m_tokenEnd = 0;
+  m_openElements.clear();
+  m_error = "";
+  m_errorOffset = 0;
+
+  // skip the UTF-8 byte order mark
+  if (StartsWith(0, "\xEF\xBB\xBF"))
+    m_pos = 3;
+}
+
+CXmlPullParser::Token CXmlPullParser::Next()
+{
+  if (m_token == Token::EndDocument || m_token == Token::Error)
+    return m_token;
+
+  if (m_pendingEnd)
+  {
+    // an empty element tag is its own end, name and offsets stay the same
+    m_pendingEnd = false;
+    m_openElements.pop_back();
+    return m_token = Token::EndElement;
+  }
+  m_emptyElement = false;
+
+  while (m_pos < m_size)
+  {
+    const size_t start = m_pos;
+
+    if (m_data[start] != '<')
+    {
+      const void* next = memchr(m_data + start, '<', m_size - start);
+      m_pos = next ? static_cast<const char*>(next) - m_data : m_size;
+      if (std::all_of(m_data + start, m_data + m_pos, IsWhitespace))
+        continue;
+
+      m_text = StringRef(m_data + start, m_pos - start);
+      m_cdata = false;
+      m_depth = static_cast<int>(m_openElements.size());
+      m_tokenStart = start;
+      m_tokenEnd = m_pos;
+      return m_token = Token::Text;
+    }
+
+    if (StartsWith(start, "<!--"))
+    {
+      const size_t end = Find(start + 4, "-->");
+      if (end == std::string::npos)
+        return SetError("unterminated comment", start);
+      m_pos = end + 3;
+      continue;
+    }
+
+    if (StartsWith(start, "<![CDATA["))
+    {
+      const size_t end = Find(start + 9, "]]>");
+      if (end == std::string::npos)
+        return SetError("unterminated CDATA section", start);
+      m_pos = end + 3;
+
+      m_text = StringRef(m_data + start + 9, end - start - 9);
+      m_cdata = true;
+      m_depth = static_cast<int>(m_openElements.size());
+      m_tokenStart = start;
+      m_tokenEnd = m_pos;
+      return m_token = Token::Text;
+    }
+
+    if (StartsWith(start, "<?"))
+    {
+      const size_t end = Find(start + 2, "?>");
+      if (end == std::string::npos)
+        return SetError("unterminated processing instruction", start);
+      m_pos = end + 2;
+      continue;
+    }
+
+    if (StartsWith(start, "<!"))
+    {
+      // document type declaration, the internal subset may contain '>'
+      int brackets = 0;
+      size_t pos = start + 2;
+      for (; pos < m_size; pos++)
+      {
+        if (m_data[pos] == '[')
+          brackets++;
+        else if (m_data[pos] == ']')
+          brackets--;
+        else if (m_data[pos] == '>' && brackets <= 0)
+          break;
+      }
+      if (pos >= m_size)
+        return SetError("unterminated document type declaration", start);
+      m_pos = pos + 1;
+      continue;
+    }
+
+    if (StartsWith(start, "</"))
+    {
+      size_t pos = start + 2;
+      while (pos < m_size && !IsNameEnd(m_data[pos]))
+        pos++;
+      const StringRef name(m_data + start + 2, pos - start - 2);
+      while (pos < m_size && IsWhitespace(m_data[pos]))
+        pos++;
+      if (pos >= m_size || m_data[pos] != '>')
+        return SetError("malformed end tag", start);
+      if (m_openElements.empty() || !(m_openElements.back() == name))
+        return SetError("end tag doesn't match start tag", start);
+
+      m_name = name;
+      m_depth = static_cast<int>(m_openElements.size());
+      m_openElements.pop_back();
+      m_tokenStart = start;
+      m_tokenEnd = m_pos = pos + 1;
+      return m_token = Token::EndElement;
+    }
+
+    size_t pos = start + 1;
+    while (pos < m_size && !IsNameEnd(m_data[pos]))
+      pos++;
+    if (pos == start + 1)
+      return SetError("malformed start tag", start);
+    m_name = StringRef(m_data + start + 1, pos - start - 1);
+
+    // find the end of the tag, attribute values may contain '>'
+    const size_t attributes = pos;
+    char quote = 0;
+    for (; pos < m_size; pos++)
+    {
+      const char c = m_data[pos];
+      if (quote != 0)
+      {
+        if (c == quote)
+          quote = 0;
+      }
+      else if (c == '"' || c == '\'')
+        quote = c;
+      else if (c == '>')
+        break;
+    }
+    if (pos >= m_size)
+      return SetError("unterminated start tag", start);
+
+    m_emptyElement = m_data[pos - 1] == '/' && pos - 1 >= attributes;
+    m_attributes = StringRef(m_data + attributes, pos - (m_emptyElement ? 1 : 0) - attributes);
+    m_pendingEnd = m_emptyElement;
+    m_openElements.push_back(m_name);
+    m_depth = static_cast<int>(m_openElements.size());
+    m_tokenStart = start;
+    m_tokenEnd = m_pos = pos + 1;
+    return m_token = Token::StartElement;
+  }
+
+  if (!m_openElements.empty())
+    return SetError("unexpected end of document", m_size);
+
+  m_depth = 0;
+  m_tokenStart = m_tokenEnd = m_size;
+  return m_token = Token::EndDocument;
+}
+
+bool CXmlPullParser::NextChildElement(int depth)
+{
+  while (true)
+  {
+    switch (Next())
+    {
+      case Token::StartElement:
+        if (m_depth == depth + 1)
+          return true;
+        break;
+      case Token::EndElement:
+        if (m_depth == depth)
+          return false;
+        break;
+      case Token::Text:
+        break;
+      default:
+        return false;
+    }
+  }
+}
+
+bool CXmlPullParser::SkipElement()
+{
+  if (m_token != Token::StartElement)
+    return !HasError();
+
+  const int depth = m_depth;
+  while (true)
+  {
+    switch (Next())
+    {
+      case Token::EndElement:
+        if (m_depth == depth)
+          return true;
+        break;
+      case Token::StartElement:
+      case Token::Text:
+        break;
+      default:
+        return false;
+    }
+  }
+}
+
+bool CXmlPullParser::ReadElementText(std::string& text)
+{
+  text.clear();
+  if (m_token != Token::StartElement)
+    return false;
+
+  const int depth = m_depth;
+  while (true)
+  {
+    switch (Next())
+    {
+      case Token::Text:
+        if (m_depth != depth)
+          break;
+        if (m_cdata)
+          text.append(m_text.data(), m_text.size());
+        else
+          DecodeEntities(m_text, text);
+        break;
+      case Token::EndElement:
+        if (m_depth == depth)
+          return true;
+        break;
+      case Token::StartElement:
+        break;
+      default:
+        return false;
+    }
+  }
+}
+
+bool CXmlPullParser::GetAttribute(const char* name, std::string& value) const
+{
+  if (m_token != Token::StartElement)
+    return false;
+
+  const char* pos = m_attributes.data();
+  const char* const end = pos + m_attributes.size();
+  while (pos < end)
+  {
+    while (pos < end && IsWhitespace(*pos))
+      pos++;
+    if (pos == end)
+      break;
+
+    const char* const attributeStart = pos;
+    while (pos < end && !IsNameEnd(*pos))
+      pos++;
+    const StringRef attribute(attributeStart, pos - attributeStart);
+
+    while (pos < end && IsWhitespace(*pos))
+      pos++;
+    if (attribute.empty() || pos == end || *pos != '=')
+      return false; // malformed attribute
+    pos++;
+    while (pos < end && IsWhitespace(*pos))
+      pos++;
+    if (pos == end || (*pos != '"' && *pos != '\''))
+      return false;
+
+    const char quote = *pos++;
+    const char* const valueStart = pos;
+    pos = static_cast<const char*>(memchr(pos, quote, end - pos));
+    if (pos == nullptr)
+      return false;
+
+    if (attribute == name)
+    {
+      value.clear();
+      DecodeEntities(StringRef(valueStart, pos - valueStart), value);
+      return true;
+    }
+    pos++;
+  }
+  return false;
+}
+
+std::string CXmlPullParser::GetAttribute(const char* name) const
+{
+  std::string value;
+  GetAttribute(name, value);
+  return value;
+}
+
+std::string CXmlPullParser::GetText() const
+{
+  if (m_token != Token::Text)
+    return "";
+  if (m_cdata)
+    return m_text.ToString();
+
+  std::string text;
+  DecodeEntities(m_text, text);
+  return text;
+}
+
+int CXmlPullParser::GetErrorRow() const
+{
+  if (!HasError())
+    return 0;
+  return 1 + static_cast<int>(std::count(m_data, m_data + m_errorOffset, '\n'));
+}
+
+int CXmlPullParser::GetErrorCol() const
+{
+  if (!HasError())
+    return 0;
+  size_t lineStart = m_errorOffset;
+  while (lineStart > 0 && m_data[lineStart - 1] != '\n')
+    lineStart--;
+  return 1 + static_cast<int>(m_errorOffset - lineStart);
+}
+
+void CXmlPullParser::DecodeEntities(const StringRef& text, std::string& decoded)
+{
+  const char* pos = text.data();
+  const char* const end = pos + text.size();
+  while (pos < end)
+  {
+    const char* const amp = static_cast<const char*>(memchr(pos, '&', end - pos));
+    if (amp == nullptr)
+    {
+      decoded.append(pos, end - pos);
+      return;
+    }
+    decoded.append(pos, amp - pos);
+    pos = amp + 1;
+
+    const char* const semicolon = static_cast<const char*>(
+        memchr(pos, ';', std::min(static_cast<size_t>(end - pos), MaxEntityLength)));
+    if (semicolon != nullptr)
+    {
+      const StringRef entity(pos, semicolon - pos);
+      bool known = true;
+      if (entity == "amp")
+        decoded += '&';
+      else if (entity == "lt")
+        decoded += '<';
+      else if (entity == "gt")
+        decoded += '>';
+      else if (entity == "quot")
+        decoded += '"';
+      else if (entity == "apos")
+        decoded += '\'';
+      else
+        known = *pos == '#' && AppendCharacterReference(pos + 1, semicolon, decoded);
+
+      if (known)
+      {
+        pos = semicolon + 1;
+        continue;
+      }
+    }
+
+    // unknown entities and stray ampersands are kept
+    decoded += '&';
+  }
+}
+
+CXmlPullParser::Token CXmlPullParser::SetError(const char* error, size_t offset)
+{
+  m_error = error;
+  m_errorOffset = offset;
+  m_pendingEnd = false;
+  m_tokenStart = m_tokenEnd = offset;
+  return m_token = Token::Error;
+}
+
+bool CXmlPullParser::StartsWith(size_t pos, const char* str) const
+{
+  const size_t length = strlen(str);
+  return m_size - pos >= length && memcmp(m_data + pos, str, length) == 0;
+}
+
+size_t CXmlPullParser::Find(size_t pos, const char* str) const
+{
+  const size_t length = strlen(str);
+  for (; pos + length <= m_size; pos++)
+  {
+    const void* next = memchr(m_data + pos, str[0], m_size - pos);
+    if (next == nullptr)
+      break;
+    pos = static_cast<const char*>(next) - m_data;
+    if (pos + length <= m_size && memcmp(m_data + pos, str, length) == 0)
+      return pos;
+  }
+  return std::string::npos;
+}
@@ -0,0 +1,207 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Forward-only XML reader working directly on a buffer without building a DOM.
+ *
+ * Names and raw text are returned as references into the buffer, which has to outlive the
+ * parser unless the document was loaded with LoadFile(). Elements, attributes, text, CDATA
+ * sections and the predefined and numeric character references are supported, comments,
+ * processing instructions and the document type declaration are skipped. Like
+ * CXBMCTinyXML, text consisting of whitespace only is dropped and unknown entities are
+ * kept as they are.
+ *
+ * Use CXBMCTinyXML if a document has to be modified or accessed in random order.
+ *
+ * Typical use:
+ * \code
+ * CXmlPullParser parser(data, size);
+ * while (parser.NextChildElement(0)) // root elements
+ * {
+ *   const int depth = parser.GetDepth();
+ *   while (parser.NextChildElement(depth))
+ *   {
+ *     if (parser.GetName() == "title")
+ *       parser.ReadElementText(title);
+ *   }
+ * }
+ * \endcode
+ */
+class CXmlPullParser
+{
+public:
+  enum class Token
+  {
+    StartDocument,
+    StartElement,
+    EndElement,
+    Text,
+    EndDocument,
+    Error,
+  };
+
+  /*!
+   * \brief Reference to a part of the parsed buffer.
+   */
+  class StringRef
+  {
+  public:
+    StringRef() = default;
+    StringRef(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    std::string ToString() const { return std::string(m_data, m_size); }
+
+    bool operator==(const char* str) const
+    {
+      return std::strncmp(m_data, str, m_size) == 0 && str[m_size] == '\0';
+    }
+    bool operator!=(const char* str) const { return !(*this == str); }
+    bool operator==(const StringRef& other) const
+    {
+      return m_size == other.m_size && std::memcmp(m_data, other.m_data, m_size) == 0;
+    }
+
+  private:
+    const char* m_data = "";
+    size_t m_size = 0;
+  };
+
+  CXmlPullParser() = default;
+  CXmlPullParser(const char* data, size_t size);
+  explicit CXmlPullParser(const std::string& data);
+  explicit CXmlPullParser(std::string&& data) = delete; // the buffer has to outlive the parser
+
+  CXmlPullParser(const CXmlPullParser&) = delete;
+  CXmlPullParser& operator=(const CXmlPullParser&) = delete;
+
+  /*!
+   * \brief Read a file into a buffer owned by the parser and restart parsing. Documents in
+   * other encodings than UTF-8 are converted.
+   * \return false if the file couldn't be read
+   */
+  bool LoadFile(const std::string& filename);
+
+  /*!
+   * \brief Advance to the next token.
+   */
+  Token Next();
+
+  /*!
+   * \brief Advance to the next child element of the element at the given depth, skipping text
+   * and deeper elements. Pass 0 to iterate the root elements.
+   * \return false once the end of the parent element, the end of the document or an error is
+   * reached
+   */
+  bool NextChildElement(int depth);
+
+  /*!
+   * \brief Skip the contents of the current element, which afterwards is at its end element.
+   * \return false on an error
+   */
+  bool SkipElement();
+
+  /*!
+   * \brief Read the text of the current element, which afterwards is at its end element.
+   * Text in child elements is ignored.
+   * \return false on an error
+   */
+  bool ReadElementText(std::string& text);
+
+  Token GetToken() const { return m_token; }
+
+  /*!
+   * \brief Name of the current element, for start and end elements.
+   */
+  const StringRef& GetName() const { return m_name; }
+
+  /*!
+   * \brief Depth of the current element, 1 for root elements. For text it's the depth of the
+   * surrounding element.
+   */
+  int GetDepth() const { return m_depth; }
+
+  /*!
+   * \brief Whether the current start element is an empty element tag like \<tag/\>. Its end
+   * element is still reported.
+   */
+  bool IsEmptyElement() const { return m_emptyElement; }
+
+  /*!
+   * \brief Get an attribute of the current start element with entities decoded.
+   * \return false if the attribute doesn't exist
+   */
+  bool GetAttribute(const char* name, std::string& value) const;
+  std::string GetAttribute(const char* name) const;
+
+  /*!
+   * \brief Text of the current text token as in the document, CDATA sections without markup.
+   */
+  const StringRef& GetRawText() const { return m_text; }
+
+  /*!
+   * \brief Text of the current text token with entities decoded.
+   */
+  std::string GetText() const;
+
+  /*!
+   * \brief Offset of the current token in the buffer.
+   */
+  size_t GetOffset() const { return m_tokenStart; }
+
+  /*!
+   * \brief Offset just behind the current token in the buffer.
+   */
+  size_t GetEndOffset() const { return m_tokenEnd; }
+
+  bool HasError() const { return m_token == Token::Error; }
+  const char* GetErrorDesc() const { return m_error; }
+  int GetErrorRow() const;
+  int GetErrorCol() const;
+
+  /*!
+   * \brief Append text with entities decoded.
+   */
+  static void DecodeEntities(const StringRef& text, std::string& decoded);
+
+private:
+  void Reset(const char* data, size_t size);
+  Token SetError(const char* error, size_t offset);
+  bool StartsWith(size_t pos, const char* str) const;
+  size_t Find(size_t pos, const char* str) const;
+
+  const char* m_data = "";
+  size_t m_size = 0;
+  size_t m_pos = 0;
+  std::string m_buffer;
+
+  Token m_token = Token::StartDocument;
+  StringRef m_name;
+  StringRef m_text;
+  StringRef m_attributes;
+  bool m_cdata = false;
+  int m_depth = 0;
+  bool m_emptyElement = false;
+  bool m_pendingEnd = false;
+  size_t m_tokenStart = 0;
+  size_t m_tokenEnd = 0;
+
+  std::vector<StringRef> m_openElements;
+
+  const char* m_error = "";
+  size_t m_errorOffset = 0;
+};
@@ -26,23 +26,26 @@
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingsManager.h"
+#include "utils/AsyncLogFileSink.h"
 #include "utils/URIUtils.h"
 
 #include <cstring>
 #include <set>
 
-#include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/dist_sink.h>
 
 static constexpr unsigned char Utf8Bom[3] = {0xEF, 0xBB, 0xBF};
 static const std::string LogFileExtension = ".log";
 static const std::string LogPattern = "%Y-%m-%d %T.%e T:%-5t %7l <%n>: %v";
+static constexpr std::size_t DefaultAsyncLogBufferSize = 1024 * 1024;
 
 CLog::CLog()
   : m_platform(IPlatformLog::CreatePlatformLog()),
     m_sinks(std::make_shared<spdlog::sinks::dist_sink_mt>()),
     m_defaultLogger(CreateLogger("general")),
     m_logLevel(LOG_LEVEL_DEBUG),
+    m_asyncLogging(false),
+    m_asyncLogBufferSize(DefaultAsyncLogBufferSize),
     m_componentLogEnabled(false),
     m_componentLogLevels(0)
 {
@@ -120,8 +123,8 @@ void CLog::Initialize(const std::string& path)
   }
 
   // create the file sink
-  m_fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(
-      m_platform->GetLogFilename(filePath), false);
+  m_fileSink = std::make_shared<CAsyncLogFileSink>(m_platform->GetLogFilename(filePath),
+                                                   m_asyncLogging, m_asyncLogBufferSize);
   m_fileSink->set_pattern(LogPattern);
 
   // add it to the existing sinks
@@ -146,11 +149,20 @@ void CLog::Uninitialize()
   // flush the file sink
   m_fileSink->flush();
 
-  // remove and destroy the file sink
+  // remove and destroy the file sink, this writes out anything still queued
   m_sinks->remove_sink(m_fileSink);
   m_fileSink.reset();
 }
 
+void CLog::SetAsyncLogging(bool enabled, std::size_t bufferSize)
+{
+  m_asyncLogging = enabled;
+  m_asyncLogBufferSize = bufferSize;
+
+  if (m_fileSink != nullptr)
+    m_fileSink->SetAsync(enabled, bufferSize);
+}
+
 void CLog::SetLogLevel(int level)
 {
   if (level < LOG_LEVEL_NONE || level > LOG_LEVEL_MAX)
@@ -19,6 +19,7 @@
 #include "utils/StringUtils.h"
 #include "utils/logtypes.h"
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -28,14 +29,13 @@ namespace spdlog
 {
 namespace sinks
 {
-template<typename Mutex>
-class basic_file_sink;
-
 template<typename Mutex>
 class dist_sink;
 } // namespace sinks
 } // namespace spdlog
 
+class CAsyncLogFileSink;
+
 class CLog : public ISettingsHandler, public ISettingCallback
 {
 public:
@@ -53,6 +53,11 @@ public:
 
   void SetLogLevel(int level);
   int GetLogLevel() { return m_logLevel; }
+  /*!
+   * \brief Write the log file from a background thread instead of the logging thread (off by default).
+   * \param bufferSize maximum number of bytes kept in memory before messages are dropped
+   */
+  void SetAsyncLogging(bool enabled, std::size_t bufferSize);
   bool IsLogLevelLogged(int loglevel);
 
   bool CanLogComponent(uint32_t component) const;
@@ -156,6 +161,9 @@ private:
                                                   const char* format,
                                                   Args&&... args)
   {
+    if (!GetInstance().m_defaultLogger->should_log(level))
+      return;
+
     GetInstance().FormatAndLogInternal(
         level, StringUtils::Format("{0:s}: {1:s}", functionName, format).c_str(),
         std::forward<Args>(args)...);
@@ -167,6 +175,9 @@ private:
                                                   const wchar_t* format,
                                                   Args&&... args)
   {
+    if (!GetInstance().m_defaultLogger->should_log(level))
+      return;
+
     GetInstance().FormatAndLogInternal(
         level, StringUtils::Format(L"{0:s}: {1:s}", functionName, format).c_str(),
         std::forward<Args>(args)...);
@@ -177,6 +188,10 @@ private:
                                    const Char* format,
                                    Args&&... args)
   {
+    // don't pay for formatting messages which are filtered out anyway
+    if (!m_defaultLogger->should_log(level))
+      return;
+
     // TODO: for now we manually format the messages to support both python- and printf-style formatting.
     //       this can be removed once all log messages have been adjusted to python-style formatting
     auto logString = StringUtils::Format(format, std::forward<Args>(args)...);
@@ -195,10 +210,13 @@ private:
   std::shared_ptr<spdlog::sinks::dist_sink<std::mutex>> m_sinks;
   Logger m_defaultLogger;
 
-  std::shared_ptr<spdlog::sinks::basic_file_sink<std::mutex>> m_fileSink;
+  std::shared_ptr<CAsyncLogFileSink> m_fileSink;
 
   int m_logLevel;
 
+  bool m_asyncLogging;
+  std::size_t m_asyncLogBufferSize;
+
   bool m_componentLogEnabled;
   uint32_t m_componentLogLevels;
 };
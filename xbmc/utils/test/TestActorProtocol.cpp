@@ -0,0 +1,182 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/Event.h"
+#include "utils/ActorProtocol.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace Actor;
+
+namespace
+{
+enum Signals
+{
+  PING = 1,
+  PONG,
+  DATA,
+};
+} // namespace
+
+TEST(TestActorProtocol, SendAndReceive)
+{
+  CEvent inEvent, outEvent;
+  Protocol port("test", &inEvent, &outEvent);
+  Message* msg;
+
+  EXPECT_FALSE(port.ReceiveOutMessage(&msg));
+
+  const int value = 42;
+  EXPECT_TRUE(port.SendOutMessage(PING, &value, sizeof(value)));
+  EXPECT_TRUE(outEvent.Signaled());
+  ASSERT_TRUE(port.ReceiveOutMessage(&msg));
+  EXPECT_EQ(PING, msg->signal);
+  EXPECT_TRUE(msg->isOut);
+  EXPECT_EQ(value, *reinterpret_cast<int*>(msg->data));
+  msg->Release();
+
+  // data which does not fit into the internal buffer
+  char large[256];
+  for (size_t i = 0; i < sizeof(large); i++)
+    large[i] = static_cast<char>(i);
+  EXPECT_TRUE(port.SendInMessage(DATA, large, sizeof(large)));
+  EXPECT_TRUE(inEvent.Signaled());
+  ASSERT_TRUE(port.ReceiveInMessage(&msg));
+  EXPECT_FALSE(msg->isOut);
+  EXPECT_EQ(0, memcmp(large, msg->data, sizeof(large)));
+  msg->Release();
+}
+
+TEST(TestActorProtocol, OrderDeferAndPurge)
+{
+  Protocol port("test");
+  Message* msg;
+
+  // enough messages to grow the queue several times
+  for (int i = 0; i < 100; i++)
+    port.SendOutMessage(i % 2 ? PING : DATA, &i, sizeof(i));
+
+  port.DeferOut(true);
+  EXPECT_FALSE(port.ReceiveOutMessage(&msg));
+  port.DeferOut(false);
+
+  port.PurgeOut(PING);
+  for (int i = 0; i < 100; i += 2)
+  {
+    ASSERT_TRUE(port.ReceiveOutMessage(&msg));
+    EXPECT_EQ(DATA, msg->signal);
+    EXPECT_EQ(i, *reinterpret_cast<int*>(msg->data));
+    msg->Release();
+  }
+  EXPECT_FALSE(port.ReceiveOutMessage(&msg));
+}
+
+TEST(TestActorProtocol, BatchedReceive)
+{
+  Protocol port("test");
+  for (int i = 0; i < 10; i++)
+    port.SendInMessage(DATA, &i, sizeof(i));
+
+  Message* msgs[4];
+  int expected = 0;
+  size_t count;
+  while ((count = port.ReceiveInMessages(msgs, 4)) > 0)
+  {
+    EXPECT_LE(count, 4u);
+    for (size_t i = 0; i < count; i++)
+    {
+      EXPECT_EQ(expected++, *reinterpret_cast<int*>(msgs[i]->data));
+      msgs[i]->Release();
+    }
+  }
+  EXPECT_EQ(10, expected);
+
+  const QueueStatistics stats = port.GetInStatistics();
+  EXPECT_EQ(10u, stats.messages);
+  EXPECT_EQ(10u, stats.maxDepth);
+  EXPECT_LE(stats.maxLatency, stats.totalLatency);
+}
+
+TEST(TestActorProtocol, SyncMessage)
+{
+  CEvent outEvent;
+  Protocol port("test", nullptr, &outEvent);
+  bool stop = false;
+
+  std::thread actor([&] {
+    while (!stop)
+    {
+      Message* msg;
+      if (port.ReceiveOutMessage(&msg))
+      {
+        if (msg->signal == PING)
+        {
+          int value = *reinterpret_cast<int*>(msg->data) + 1;
+          msg->Reply(PONG, &value, sizeof(value));
+        }
+        else
+          stop = true;
+        msg->Release();
+      }
+      else
+        outEvent.WaitMSec(100);
+    }
+  });
+
+  // the same messages and events are reused for every round trip
+  for (int i = 0; i < 1000; i++)
+  {
+    Message* reply;
+    ASSERT_TRUE(port.SendOutMessageSync(PING, &reply, 1000, &i, sizeof(i)));
+    EXPECT_EQ(PONG, reply->signal);
+    EXPECT_EQ(i + 1, *reinterpret_cast<int*>(reply->data));
+    reply->Release();
+  }
+
+  port.SendOutMessage(DATA);
+  actor.join();
+}
+
+TEST(TestActorProtocol, Statistics)
+{
+  Protocol port("test");
+  Message* msg;
+
+  for (int i = 0; i < 3; i++)
+    port.SendOutMessage(DATA, &i, sizeof(i));
+  ASSERT_TRUE(port.ReceiveOutMessage(&msg));
+  msg->Release();
+  for (int i = 3; i < 5; i++)
+    port.SendOutMessage(DATA, &i, sizeof(i));
+
+  // the remaining messages wait at least this long in the queue
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  while (port.ReceiveOutMessage(&msg))
+    msg->Release();
+
+  // purged messages were never received
+  port.SendOutMessage(PING);
+  port.PurgeOut(PING);
+
+  const QueueStatistics out = port.GetOutStatistics();
+  EXPECT_EQ(5u, out.messages);
+  EXPECT_EQ(4u, out.maxDepth);
+  EXPECT_GE(out.maxLatency, std::chrono::milliseconds(20));
+  EXPECT_GE(out.totalLatency, 4 * std::chrono::milliseconds(20));
+  EXPECT_LE(out.maxLatency, out.totalLatency);
+
+  // the directions are counted separately
+  const QueueStatistics in = port.GetInStatistics();
+  EXPECT_EQ(0u, in.messages);
+  EXPECT_EQ(0u, in.maxDepth);
+  EXPECT_EQ(0, in.totalLatency.count());
+}
@@ -0,0 +1,41 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/CPUBudget.h"
+
+#include <gtest/gtest.h>
+
+TEST(TestCPUBudget, GrantsUpToLimit)
+{
+  CCPUBudget budget(6);
+  EXPECT_EQ(6, budget.GetDecoderThreadLimit());
+  EXPECT_EQ(4, budget.AcquireDecoderThreads(4));
+  EXPECT_EQ(2, budget.AcquireDecoderThreads(4));
+  EXPECT_EQ(6, budget.GetDecoderThreadsInUse());
+}
+
+TEST(TestCPUBudget, AlwaysGrantsOneThread)
+{
+  CCPUBudget budget(2);
+  EXPECT_EQ(2, budget.AcquireDecoderThreads(8));
+  EXPECT_EQ(1, budget.AcquireDecoderThreads(8));
+  EXPECT_EQ(1, budget.AcquireDecoderThreads(0));
+  EXPECT_EQ(4, budget.GetDecoderThreadsInUse());
+}
+
+TEST(TestCPUBudget, Release)
+{
+  CCPUBudget budget(4);
+  int first = budget.AcquireDecoderThreads(4);
+  EXPECT_EQ(1, budget.AcquireDecoderThreads(4));
+  budget.ReleaseDecoderThreads(first);
+  EXPECT_EQ(1, budget.GetDecoderThreadsInUse());
+  EXPECT_EQ(3, budget.AcquireDecoderThreads(4));
+  budget.ReleaseDecoderThreads(10);
+  EXPECT_EQ(0, budget.GetDecoderThreadsInUse());
+}
@@ -12,6 +12,9 @@
 #include "utils/CharsetConverter.h"
 #include "utils/Utf8Utils.h"
 
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #if 0
@@ -257,6 +260,124 @@ TEST_F(TestCharsetConverter, wToUTF8)
   EXPECT_STREQ(refstra1.c_str(), varstra1.c_str());
 }
 
+TEST_F(TestCharsetConverter, utf8ToUtf32)
+{
+  std::u32string varstr32;
+  EXPECT_TRUE(g_charsetConverter.utf8ToUtf32(u8"a\u00e9\u20ac\U0001F42D", varstr32));
+  EXPECT_EQ(U"a\u00e9\u20ac\U0001F42D", varstr32);
+
+  // invalid bytes are skipped unless failing is requested
+  EXPECT_FALSE(g_charsetConverter.utf8ToUtf32("a\xff" "b\xc0\xaf" "c", varstr32, true));
+  EXPECT_TRUE(g_charsetConverter.utf8ToUtf32("a\xff" "b\xc0\xaf" "c", varstr32, false));
+  EXPECT_EQ(U"abc", varstr32);
+
+  // a sequence cut off at the end is dropped
+  EXPECT_TRUE(g_charsetConverter.utf8ToUtf32("ab\xe2\x82", varstr32, false));
+  EXPECT_EQ(U"ab", varstr32);
+}
+
+TEST_F(TestCharsetConverter, utf32ToUtf8)
+{
+  std::string varstr;
+  EXPECT_TRUE(g_charsetConverter.utf32ToUtf8(U"a\u00e9\u20ac\U0001F42D", varstr));
+  EXPECT_EQ(u8"a\u00e9\u20ac\U0001F42D", varstr);
+
+  std::u32string invalid = U"ab";
+  invalid.insert(1, 1, static_cast<char32_t>(0xD800));
+  EXPECT_FALSE(g_charsetConverter.utf32ToUtf8(invalid, varstr, true));
+  EXPECT_TRUE(g_charsetConverter.utf32ToUtf8(invalid, varstr, false));
+  EXPECT_EQ("ab", varstr);
+}
+
+TEST_F(TestCharsetConverter, utf16toUTF8)
+{
+  // "x", EURO SIGN and MOUSE FACE as surrogate pair
+  std::u16string little = {u'x', 0x20AC, 0xD83D, 0xDC2D};
+  std::u16string big;
+  for (char16_t unit : little)
+    big.push_back(static_cast<char16_t>((unit << 8) | (unit >> 8)));
+#ifdef WORDS_BIGENDIAN
+  std::swap(little, big);
+#endif
+
+  std::string varstr;
+  EXPECT_TRUE(g_charsetConverter.utf16LEtoUTF8(little, varstr));
+  EXPECT_EQ(u8"x\u20ac\U0001F42D", varstr);
+  EXPECT_TRUE(g_charsetConverter.utf16BEtoUTF8(big, varstr));
+  EXPECT_EQ(u8"x\u20ac\U0001F42D", varstr);
+}
+
+namespace
+{
+struct ConversionResults
+{
+  std::wstring w;
+  std::string fromW;
+  std::u32string utf32;
+  std::string fromUtf32;
+  std::u16string utf16;
+  std::string latin1;
+  std::string fromLatin1;
+
+  bool operator==(const ConversionResults& other) const
+  {
+    return w == other.w && fromW == other.fromW && utf32 == other.utf32 &&
+           fromUtf32 == other.fromUtf32 && utf16 == other.utf16 && latin1 == other.latin1 &&
+           fromLatin1 == other.fromLatin1;
+  }
+};
+
+// runs the built-in transcoders as well as iconv based conversions
+ConversionResults Convert(const std::string& utf8)
+{
+  ConversionResults results;
+  g_charsetConverter.utf8ToW(utf8, results.w, false);
+  g_charsetConverter.wToUTF8(results.w, results.fromW);
+  g_charsetConverter.utf8ToUtf32(utf8, results.utf32, false);
+  g_charsetConverter.utf32ToUtf8(results.utf32, results.fromUtf32);
+  g_charsetConverter.utf8To("UTF-16LE", utf8, results.utf16);
+  g_charsetConverter.utf8To("ISO-8859-1", utf8, results.latin1);
+  g_charsetConverter.ToUtf8("ISO-8859-1", results.latin1, results.fromLatin1);
+  return results;
+}
+} // namespace
+
+TEST_F(TestCharsetConverter, ConcurrentConversions)
+{
+  // GUI text layout converts strings from several threads, which must not disturb each other
+  const std::vector<std::string> inputs = {
+      "Some typical list item label 1080p",
+      u8"ｔｅｓｔ＿ｕｔｆ８ｌａｂｅｌ \u00e9\u20ac",
+      u8"caf\u00e9 cr\u00e8me br\u00fbl\u00e9e",
+      u8"x\u20ac\U0001F42D",
+      "invalid \xff\xfe bytes",
+      "",
+  };
+
+  std::vector<ConversionResults> expected;
+  for (const std::string& input : inputs)
+    expected.push_back(Convert(input));
+
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4, 0);
+  for (int& mismatched : mismatches)
+  {
+    threads.emplace_back([&inputs, &expected, &mismatched]() {
+      for (int i = 0; i < 500; i++)
+      {
+        const std::size_t n = static_cast<std::size_t>(i) % inputs.size();
+        if (!(Convert(inputs[n]) == expected[n]))
+          mismatched++;
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  for (int mismatched : mismatches)
+    EXPECT_EQ(0, mismatched);
+}
+
 //TEST_F(TestCharsetConverter, utf16BEtoUTF8)
 //{
 //  refstr16_1.assign(refutf16BE);
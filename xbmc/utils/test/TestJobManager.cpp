@@ -47,6 +47,15 @@ public:
   }
 };
 
+// CJobQueue finds its jobs by comparing them
+class QueuedDummyJob : public DummyJob
+{
+public:
+  explicit QueuedDummyJob(Flags* flags) : DummyJob(flags) {}
+
+  bool operator==(const CJob* job) const override { return this == job; }
+};
+
 class ReallyDumbJob : public CJob
 {
   Flags* m_flags;
@@ -204,6 +213,82 @@ TEST_F(TestJobManager, PauseLowPriorityJob)
   job->FinishAndStopBlocking();
 }
 
+TEST_F(TestJobManager, LowPriorityJobsRunWhilePaused)
+{
+  Flags* first = new Flags();
+  Flags* second = new Flags();
+
+  CJobManager::GetInstance().PauseJobs();
+  CJobManager::GetInstance().AddJob(new DummyJob(first), NULL, CJob::PRIORITY_LOW);
+  ASSERT_TRUE(poll([first]() -> bool { return first->started; }));
+
+  // other low priority jobs aren't held back by a running one
+  CJobManager::GetInstance().AddJob(new DummyJob(second), NULL, CJob::PRIORITY_LOW);
+  EXPECT_TRUE(poll([second]() -> bool { return second->started; }));
+
+  first->lingerAtWork = false;
+  second->lingerAtWork = false;
+  ASSERT_TRUE(poll([first, second]() -> bool { return first->finished && second->finished; }));
+
+  CJobManager::GetInstance().UnPauseJobs();
+  delete first;
+  delete second;
+}
+
+TEST_F(TestJobManager, ThrottleJobQueueWhilePaused)
+{
+  Flags* first = new Flags();
+  Flags* second = new Flags();
+
+  {
+    CJobQueue queue(false, 2, CJob::PRIORITY_NORMAL, true);
+    CJobManager::GetInstance().PauseJobs();
+    queue.AddJob(new QueuedDummyJob(first));
+    ASSERT_TRUE(poll([first]() -> bool { return first->started; }));
+
+    // a second job of the same queue has to wait for the first one
+    queue.AddJob(new QueuedDummyJob(second));
+    KODI::TIME::Sleep(100);
+    EXPECT_FALSE(second->started);
+
+    first->lingerAtWork = false;
+    ASSERT_TRUE(poll([second]() -> bool { return second->started; }));
+    second->lingerAtWork = false;
+    ASSERT_TRUE(poll([second]() -> bool { return second->finished; }));
+
+    CJobManager::GetInstance().UnPauseJobs();
+  }
+
+  delete first;
+  delete second;
+}
+
+TEST_F(TestJobManager, DontThrottleJobQueueWhilePausedByDefault)
+{
+  Flags* first = new Flags();
+  Flags* second = new Flags();
+
+  {
+    CJobQueue queue(false, 2, CJob::PRIORITY_NORMAL);
+    CJobManager::GetInstance().PauseJobs();
+    queue.AddJob(new QueuedDummyJob(first));
+    ASSERT_TRUE(poll([first]() -> bool { return first->started; }));
+
+    // the second job runs alongside the first one
+    queue.AddJob(new QueuedDummyJob(second));
+    EXPECT_TRUE(poll([second]() -> bool { return second->started; }));
+
+    first->lingerAtWork = false;
+    second->lingerAtWork = false;
+    ASSERT_TRUE(poll([first, second]() -> bool { return first->finished && second->finished; }));
+
+    CJobManager::GetInstance().UnPauseJobs();
+  }
+
+  delete first;
+  delete second;
+}
+
 TEST_F(TestJobManager, IsProcessing)
 {
   JobControlPackage package;
@@ -17,6 +17,11 @@
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 TEST(TestRegExp, RegFind)
@@ -123,6 +128,128 @@ TEST(TestRegExp, operatorEqual)
   EXPECT_STREQ("string", match.c_str());
 }
 
+TEST(TestRegExp, SharedPattern)
+{
+  CRegExp regex, regex2;
+
+  // both use the cached compiled pattern, matching state stays separate
+  EXPECT_TRUE(regex.RegComp("^(Test)\\s*(.*)\\.", CRegExp::StudyWithJitComp));
+  EXPECT_TRUE(regex2.RegComp("^(Test)\\s*(.*)\\.", CRegExp::StudyWithJitComp));
+  EXPECT_EQ(0, regex.RegFind("Test string."));
+  EXPECT_EQ(-1, regex2.RegFind("No match."));
+  EXPECT_STREQ("string", regex.GetMatch(2).c_str());
+
+  CRegExp copy(regex);
+  EXPECT_TRUE(copy.IsCompiled());
+  EXPECT_EQ(0, copy.RegFind("Test other."));
+  EXPECT_STREQ("other", copy.GetMatch(2).c_str());
+  EXPECT_STREQ("string", regex.GetMatch(2).c_str());
+
+  const CRegExp& self = regex;
+  regex = self;
+  EXPECT_TRUE(regex.IsCompiled());
+  EXPECT_EQ(0, regex.RegFind("Test again."));
+}
+
+TEST(TestRegExp, RegExpSet)
+{
+  const std::vector<std::string> expressions = {
+      "-trailer",          "[-._ \\/]sample[-._ ]",   "(a)(b)\\2",
+      "(?<year>19|20)\\d\\d", "[!-._ \\\\/]extrafanart[-._ \\\\/]", "[[",
+  };
+  CRegExpSet set(true, CRegExp::autoUtf8);
+
+  // the invalid expression is skipped, the others are still usable
+  EXPECT_FALSE(set.RegComp(expressions));
+  EXPECT_EQ(0, set.RegFind("movie-TRAILER.mkv"));
+  EXPECT_EQ(1, set.RegFind("/movies/movie.sample.mkv"));
+  EXPECT_EQ(2, set.RegFind("xabbx"));
+  EXPECT_EQ(-1, set.RegFind("xabax"));
+  EXPECT_EQ(3, set.RegFind("movie 2019.mkv"));
+  EXPECT_EQ(4, set.RegFind("/movies/extrafanart/fanart.jpg"));
+  EXPECT_EQ(-1, set.RegFind("/movies/movie.mkv"));
+  EXPECT_EQ("[-._ \\/]sample[-._ ]", set.GetExpression(1));
+
+  EXPECT_TRUE(set.RegComp({}));
+  EXPECT_EQ(-1, set.RegFind("movie-trailer.mkv"));
+}
+
+TEST(TestRegExp, RegExpSetMatchesLikeSingleExpressions)
+{
+  // the default video exclude expressions
+  const std::vector<std::string> expressions = {
+      "-trailer", "[!-._ \\\\/]sample[-._ ]", "\\.\\$trash\\$",
+      "/\\.actors/", "[\\\\/]\\.actors[\\\\/]", "[!-._ \\\\/]extrafanart[-._ \\\\/]",
+      "[!-._ \\\\/]extrathumbs[-._ \\\\/]", "/tmp/", "[\\\\/]\\.@__thumb[\\\\/]"};
+  const std::vector<std::string> files = {
+      "smb://server/share/movies/Movie (2010).mkv",
+      "smb://server/share/movies/Movie-TRAILER.mkv",
+      "/movies/Movie/movie.sample.mkv",
+      "/movies/.$trash$/Movie.mkv",
+      "/movies/Movie/.actors/Actor.jpg",
+      "C:\\movies\\Movie\\.actors\\Actor.jpg",
+      "/movies/Movie/extrafanart/fanart1.jpg",
+      "/movies/Movie/extrathumbs/thumb1.jpg",
+      "/tmp/Movie.mkv",
+      "/share/Movie/.@__thumb/Movie.jpg",
+      "/movies/Samples and Trailers (2010).mkv",
+      u8"/movies/Am\u00e9lie (2001)/Am\u00e9lie.mkv",
+  };
+
+  CRegExpSet set(true, CRegExp::autoUtf8);
+  ASSERT_TRUE(set.RegComp(expressions));
+
+  for (const std::string& file : files)
+  {
+    bool matches = false;
+    for (const std::string& expression : expressions)
+    {
+      CRegExp regexp(true, CRegExp::autoUtf8);
+      ASSERT_TRUE(regexp.RegComp(expression));
+      matches = matches || regexp.RegFind(file) >= 0;
+    }
+
+    const int index = set.RegFind(file);
+    EXPECT_EQ(matches, index >= 0) << file;
+    if (index >= 0)
+    {
+      // the reported expression is one which matches
+      CRegExp regexp(true, CRegExp::autoUtf8);
+      ASSERT_TRUE(regexp.RegComp(set.GetExpression(index)));
+      EXPECT_GE(regexp.RegFind(file), 0) << file;
+    }
+  }
+}
+
+TEST(TestRegExp, RegExpSetConcurrentRegFind)
+{
+  const std::vector<std::string> expressions = {"-trailer", "(a)(b)\\2",
+                                                "[!-._ \\\\/]sample[-._ ]"};
+  const std::vector<std::pair<std::string, int>> files = {
+      {"movie-trailer.mkv", 0}, {"xabbx", 1}, {"/movie.sample.mkv", 2}, {"movie.mkv", -1}};
+  CRegExpSet set(true, CRegExp::autoUtf8);
+  ASSERT_TRUE(set.RegComp(expressions));
+
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4, 0);
+  for (int& mismatched : mismatches)
+  {
+    threads.emplace_back([&set, &files, &mismatched]() {
+      for (int i = 0; i < 1000; i++)
+      {
+        const auto& file = files[static_cast<size_t>(i) % files.size()];
+        if (set.RegFind(file.first) != file.second)
+          mismatched++;
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  for (int mismatched : mismatches)
+    EXPECT_EQ(0, mismatched);
+}
+
 class TestRegExpLog : public testing::Test
 {
 protected:
@@ -9,6 +9,8 @@
 #include "utils/SortUtils.h"
 #include "utils/Variant.h"
 
+#include <cstring>
+
 #include <gtest/gtest.h>
 
 TEST(TestSortUtils, Sort_SortBy)
@@ -103,6 +105,34 @@ TEST(TestSortUtils, Sort_SortDescription)
   EXPECT_STREQ("R Artist", (*items.at(6))[FieldArtist].asString().c_str());
 }
 
+TEST(TestSortUtils, Sort_NaturalOrder)
+{
+  SortItems items;
+  for (const char* label : {"track 10", "Track 2", "track 1", "Folder", "track 02"})
+  {
+    SortItemPtr item(new SortItem());
+    (*item)[FieldLabel] = label;
+    (*item)[FieldFolder] = strcmp(label, "Folder") == 0;
+    items.push_back(item);
+  }
+
+  SortUtils::Sort(SortByLabel, SortOrderAscending, SortAttributeNone, items);
+
+  EXPECT_STREQ("Folder", (*items.at(0))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("track 1", (*items.at(1))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("Track 2", (*items.at(2))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("track 02", (*items.at(3))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("track 10", (*items.at(4))[FieldLabel].asString().c_str());
+
+  SortUtils::Sort(SortByLabel, SortOrderDescending, SortAttributeIgnoreFolders, items);
+
+  EXPECT_STREQ("track 10", (*items.at(0))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("Track 2", (*items.at(1))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("track 02", (*items.at(2))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("track 1", (*items.at(3))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("Folder", (*items.at(4))[FieldLabel].asString().c_str());
+}
+
 TEST(TestSortUtils, GetFieldsForSorting)
 {
   Fields fields;
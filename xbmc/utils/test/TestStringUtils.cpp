@@ -95,6 +95,16 @@ TEST(TestStringUtils, ToLower)
   EXPECT_STREQ(refstr.c_str(), varstr.c_str());
 }
 
+TEST(TestStringUtils, ToUpperToLowerAscii)
+{
+  // long enough for the vectorized path, multi-byte sequences are left alone
+  std::string varstr = "K\xc3\x84se Und Brot, GR\xc3\x9c\xc3\x9f GOTT! abcXYZ[@`{";
+  StringUtils::ToLower(varstr);
+  EXPECT_EQ("k\xc3\x84se und brot, gr\xc3\x9c\xc3\x9f gott! abcxyz[@`{", varstr);
+  StringUtils::ToUpper(varstr);
+  EXPECT_EQ("K\xc3\x84SE UND BROT, GR\xc3\x9c\xc3\x9f GOTT! ABCXYZ[@`{", varstr);
+}
+
 TEST(TestStringUtils, ToCapitalize)
 {
   std::string refstr = "Test";
@@ -356,6 +366,32 @@ TEST(TestStringUtils, AlphaNumericCompare)
   EXPECT_LT(var, ref);
 }
 
+TEST(TestStringUtils, AlphaNumericSortKey)
+{
+  const std::vector<std::wstring> strings = {
+      L"",         L"a",          L"A",        L"ab",        L"b",          L"track 2",
+      L"track 10", L"Track 010",  L"track 1a", L"123abc",    L"abc123",     L"!abc",
+      L"~",        L"\u00e9t\u00e9", L"ete",      L"\u00c9t\u00e9 2", L"\u0416\u0436", L"1234567890123456",
+      L"12345678901234567", L"a.b",   L"a b",      L"a\tb"};
+
+  for (const auto& left : strings)
+  {
+    const std::string leftKey = StringUtils::AlphaNumericSortKey(left.c_str());
+    for (const auto& right : strings)
+    {
+      const std::string rightKey = StringUtils::AlphaNumericSortKey(right.c_str());
+      const int64_t expected = StringUtils::AlphaNumericCompare(left.c_str(), right.c_str());
+      const int actual = leftKey.compare(rightKey);
+      EXPECT_EQ(expected < 0, actual < 0);
+      EXPECT_EQ(expected > 0, actual > 0);
+    }
+  }
+
+  // natural order of numbers
+  EXPECT_LT(StringUtils::AlphaNumericSortKey(L"track 9"),
+            StringUtils::AlphaNumericSortKey(L"track 10"));
+}
+
 TEST(TestStringUtils, TimeStringToSeconds)
 {
   EXPECT_EQ(77455, StringUtils::TimeStringToSeconds("21:30:55"));
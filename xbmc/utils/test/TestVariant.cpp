@@ -8,6 +8,11 @@
 
 #include "utils/Variant.h"
 
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 TEST(TestVariant, VariantTypeInteger)
@@ -332,3 +337,126 @@ TEST(TestVariant, isMember)
   EXPECT_TRUE(a.isMember("key1"));
   EXPECT_FALSE(a.isMember("key2"));
 }
+
+TEST(TestVariant, ShortAndLongStrings)
+{
+  const std::string shortStr(22, 's');
+  const std::string longStr(23, 'l');
+  CVariant a(shortStr), b(longStr);
+
+  EXPECT_EQ(shortStr, a.asString());
+  EXPECT_EQ(longStr, b.asString());
+  EXPECT_STREQ(shortStr.c_str(), a.c_str());
+  EXPECT_STREQ(longStr.c_str(), b.c_str());
+  EXPECT_EQ(22u, a.size());
+  EXPECT_EQ(23u, b.size());
+
+  CVariant c(a), d(b);
+  EXPECT_TRUE(c == a);
+  EXPECT_TRUE(d == b);
+  EXPECT_FALSE(a == b);
+
+  c.swap(d);
+  EXPECT_EQ(longStr, c.asString());
+  EXPECT_EQ(shortStr, d.asString());
+
+  CVariant e(std::move(c));
+  EXPECT_EQ(longStr, e.asString());
+  e = std::move(d);
+  EXPECT_EQ(shortStr, e.asString());
+
+  const char embedded[] = "a\0b";
+  CVariant f(embedded, sizeof(embedded) - 1);
+  EXPECT_EQ(std::string(embedded, 3), f.asString());
+
+  EXPECT_FALSE(CVariant("false").asBoolean(true));
+  EXPECT_FALSE(CVariant("0").asBoolean(true));
+  EXPECT_TRUE(CVariant("0a").asBoolean(false));
+  EXPECT_EQ(42, CVariant("42").asInteger());
+
+  b.clear();
+  EXPECT_TRUE(b.isString());
+  EXPECT_TRUE(b.empty());
+}
+
+TEST(TestVariant, MoveConstruction)
+{
+  std::vector<std::string> strings = {"short", std::string(40, 'x')};
+  CVariant a(std::move(strings));
+  EXPECT_TRUE(a.isArray());
+  EXPECT_EQ(std::string(40, 'x'), a[1].asString());
+
+  std::map<std::string, CVariant> map;
+  map["key"] = "value";
+  CVariant b(std::move(map));
+  EXPECT_EQ("value", b["key"].asString());
+
+  std::string key = "moved";
+  b[std::move(key)] = 1;
+  EXPECT_TRUE(b.isMember("moved"));
+}
+
+TEST(TestVariant, SmallStringBoundary)
+{
+  // 22 characters are the most stored inline, 23 need an allocation
+  for (size_t length = 20; length <= 25; length++)
+  {
+    const std::string str(length, static_cast<char>('a' + length - 20));
+    CVariant a(str);
+    EXPECT_EQ(str, a.asString()) << length;
+    EXPECT_EQ(length, a.size()) << length;
+    EXPECT_EQ(length, std::strlen(a.c_str())) << length;
+
+    // growing and shrinking across the boundary in place
+    CVariant b(std::string(length, 'x'));
+    b = str + "yz";
+    EXPECT_EQ(str + "yz", b.asString()) << length;
+    b = str;
+    EXPECT_EQ(str, b.asString()) << length;
+    b = CVariant(std::string(2, 'z'));
+    EXPECT_EQ("zz", b.asString()) << length;
+  }
+}
+
+TEST(TestVariant, CopiedAndMovedFromSmallStrings)
+{
+  const std::string str(22, 's');
+  CVariant original(str);
+
+  CVariant copy(original);
+  CVariant assigned;
+  assigned = original;
+  EXPECT_EQ(str, copy.asString());
+  EXPECT_EQ(str, assigned.asString());
+  EXPECT_NE(original.c_str(), copy.c_str());
+
+  // the copies are independent of the original
+  original = "changed";
+  EXPECT_EQ(str, copy.asString());
+  EXPECT_EQ(str, assigned.asString());
+
+  CVariant moved(std::move(copy));
+  EXPECT_EQ(str, moved.asString());
+  EXPECT_TRUE(copy.isNull());
+
+  CVariant moveAssigned(std::string(40, 'l'));
+  moveAssigned = std::move(moved);
+  EXPECT_EQ(str, moveAssigned.asString());
+  EXPECT_TRUE(moved.isNull());
+
+  // moved from variants can be reused and destroyed
+  copy = "reused";
+  moved = std::string(30, 'r');
+  EXPECT_EQ("reused", copy.asString());
+  EXPECT_EQ(std::string(30, 'r'), moved.asString());
+
+  // small strings inside containers survive the container being copied and moved
+  CVariant array(CVariant::VariantTypeArray);
+  array.push_back(str);
+  array.push_back(std::string(23, 'l'));
+  CVariant arrayCopy(array);
+  CVariant arrayMoved(std::move(array));
+  EXPECT_EQ(str, arrayCopy[0].asString());
+  EXPECT_EQ(str, arrayMoved[0].asString());
+  EXPECT_EQ(std::string(23, 'l'), arrayMoved[1].asString());
+}
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/XmlPullParser.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(TestXmlPullParser, Tokens)
+{
+  const std::string data = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                           "<!DOCTYPE movie [<!ENTITY x \"y\">]>\n"
+                           "<movie id=\"1\">\n"
+                           "  <!-- comment <ignored> -->\n"
+                           "  <title>Title</title>\n"
+                           "  <empty/>\n"
+                           "</movie>\n";
+  CXmlPullParser parser(data);
+
+  ASSERT_EQ(CXmlPullParser::Token::StartElement, parser.Next());
+  EXPECT_TRUE(parser.GetName() == "movie");
+  EXPECT_EQ(1, parser.GetDepth());
+  EXPECT_EQ(data.find("<movie"), parser.GetOffset());
+
+  ASSERT_EQ(CXmlPullParser::Token::StartElement, parser.Next());
+  EXPECT_TRUE(parser.GetName() == "title");
+  EXPECT_EQ(2, parser.GetDepth());
+
+  ASSERT_EQ(CXmlPullParser::Token::Text, parser.Next());
+  EXPECT_EQ("Title", parser.GetText());
+  EXPECT_EQ(2, parser.GetDepth());
+
+  ASSERT_EQ(CXmlPullParser::Token::EndElement, parser.Next());
+  EXPECT_TRUE(parser.GetName() == "title");
+
+  ASSERT_EQ(CXmlPullParser::Token::StartElement, parser.Next());
+  EXPECT_TRUE(parser.GetName() == "empty");
+  EXPECT_TRUE(parser.IsEmptyElement());
+  ASSERT_EQ(CXmlPullParser::Token::EndElement, parser.Next());
+  EXPECT_TRUE(parser.GetName() == "empty");
+  EXPECT_EQ(2, parser.GetDepth());
+
+  ASSERT_EQ(CXmlPullParser::Token::EndElement, parser.Next());
+  EXPECT_TRUE(parser.GetName() == "movie");
+  EXPECT_EQ(data.rfind('\n'), parser.GetEndOffset());
+
+  EXPECT_EQ(CXmlPullParser::Token::EndDocument, parser.Next());
+  EXPECT_EQ(CXmlPullParser::Token::EndDocument, parser.Next());
+  EXPECT_FALSE(parser.HasError());
+}
+
+TEST(TestXmlPullParser, TextAndAttributes)
+{
+  const std::string data =
+      "<track a='x &gt; y' b = \"&#65;&#x42;&#146;\" c=\"1>2\">"
+      "R&amp;B &unknown; & more<![CDATA[ <raw> &amp; ]]></track>";
+  CXmlPullParser parser(data);
+
+  ASSERT_TRUE(parser.NextChildElement(0));
+  EXPECT_EQ("x > y", parser.GetAttribute("a"));
+  EXPECT_EQ("AB\xC2\x92", parser.GetAttribute("b"));
+  EXPECT_EQ("1>2", parser.GetAttribute("c"));
+  std::string value;
+  EXPECT_FALSE(parser.GetAttribute("d", value));
+
+  std::string text;
+  EXPECT_TRUE(parser.ReadElementText(text));
+  EXPECT_EQ("R&B &unknown; & more <raw> &amp; ", text);
+  EXPECT_EQ(CXmlPullParser::Token::EndElement, parser.GetToken());
+}
+
+TEST(TestXmlPullParser, NextChildElement)
+{
+  const std::string data = "<playlist><title>Name</title><trackList>"
+                           "<track><location>a.mp3</location><extension><title>x</title>"
+                           "</extension></track>"
+                           "<track><title>b</title><location>b.mp3</location></track>"
+                           "<track/></trackList></playlist>";
+  CXmlPullParser parser(data);
+
+  std::string title;
+  std::vector<std::string> locations;
+  unsigned int tracks = 0;
+  ASSERT_TRUE(parser.NextChildElement(0));
+  while (parser.NextChildElement(1))
+  {
+    if (parser.GetName() == "title")
+      parser.ReadElementText(title);
+    else if (parser.GetName() == "trackList")
+    {
+      while (parser.NextChildElement(2))
+      {
+        tracks++;
+        while (parser.NextChildElement(3))
+        {
+          std::string location;
+          if (parser.GetName() == "location" && parser.ReadElementText(location))
+            locations.push_back(location);
+        }
+      }
+    }
+  }
+
+  EXPECT_FALSE(parser.NextChildElement(0));
+  EXPECT_FALSE(parser.HasError());
+  EXPECT_EQ("Name", title);
+  EXPECT_EQ(3u, tracks);
+  EXPECT_EQ(std::vector<std::string>({"a.mp3", "b.mp3"}), locations);
+}
+
+TEST(TestXmlPullParser, SkipElement)
+{
+  const std::string data = "<episodedetails><episode>1</episode></episodedetails>\n"
+                           "<episodedetails><episode>2</episode></episodedetails>\n"
+                           "http://example.com/show";
+  CXmlPullParser parser(data);
+
+  ASSERT_TRUE(parser.NextChildElement(0));
+  EXPECT_TRUE(parser.SkipElement());
+  EXPECT_EQ(data.find('\n'), parser.GetEndOffset());
+
+  ASSERT_TRUE(parser.NextChildElement(0));
+  EXPECT_EQ(data.find('\n') + 1, parser.GetOffset());
+  EXPECT_TRUE(parser.SkipElement());
+
+  EXPECT_EQ(CXmlPullParser::Token::Text, parser.Next());
+  EXPECT_EQ(0, parser.GetDepth());
+  EXPECT_FALSE(parser.NextChildElement(0));
+  EXPECT_FALSE(parser.HasError());
+}
+
+TEST(TestXmlPullParser, Errors)
+{
+  const std::string mismatchData = "<a>\n  <b></a>";
+  CXmlPullParser mismatch(mismatchData);
+  EXPECT_TRUE(mismatch.NextChildElement(0));
+  EXPECT_FALSE(mismatch.SkipElement());
+  EXPECT_TRUE(mismatch.HasError());
+  EXPECT_EQ(2, mismatch.GetErrorRow());
+  EXPECT_EQ(6, mismatch.GetErrorCol());
+
+  const std::string unterminatedData = "<a><b>text</b>";
+  CXmlPullParser unterminated(unterminatedData);
+  EXPECT_TRUE(unterminated.NextChildElement(0));
+  EXPECT_FALSE(unterminated.SkipElement());
+  EXPECT_TRUE(unterminated.HasError());
+
+  const std::string commentData = "<a><!-- </a>";
+  CXmlPullParser comment(commentData);
+  EXPECT_TRUE(comment.NextChildElement(0));
+  EXPECT_FALSE(comment.SkipElement());
+  EXPECT_TRUE(comment.HasError());
+}
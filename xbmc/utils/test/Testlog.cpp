@@ -11,13 +11,21 @@
 #include "filesystem/File.h"
 #include "filesystem/SpecialProtocol.h"
 #include "test/TestUtils.h"
+#include "utils/AsyncLogFileSink.h"
 #include "utils/RegExp.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <memory>
 #include <stdlib.h>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
+#include <spdlog/logger.h>
 
 class Testlog : public testing::Test
 {
@@ -94,3 +102,101 @@ TEST_F(Testlog, SetLogLevel)
   CServiceBroker::GetLogging().Uninitialize();
   EXPECT_TRUE(XFILE::CFile::Delete(logfile));
 }
+
+namespace
+{
+std::string ReadLogFile(const std::string& path)
+{
+  std::ifstream stream(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+std::size_t CountLines(const std::string& content, const std::string& pattern)
+{
+  std::size_t count = 0;
+  for (auto pos = content.find(pattern); pos != std::string::npos;
+       pos = content.find(pattern, pos + 1))
+    count++;
+  return count;
+}
+} // namespace
+
+TEST_F(Testlog, AsyncFileSinkKeepsAllMessages)
+{
+  const std::string logfile = CSpecialProtocol::TranslatePath("special://temp/asynclog.log");
+  {
+    auto sink = std::make_shared<CAsyncLogFileSink>(logfile, true, 1024 * 1024);
+    sink->set_pattern("%v");
+    spdlog::logger logger("async", sink);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+      threads.emplace_back([&logger] {
+        for (int i = 0; i < 1000; i++)
+          logger.info("message {}", i);
+      });
+    for (auto& thread : threads)
+      thread.join();
+
+    logger.error("error message");
+
+    // errors are written synchronously along with everything queued before them
+    const std::string content = ReadLogFile(logfile);
+    EXPECT_EQ(4000u, CountLines(content, "message "));
+    EXPECT_EQ(0u, sink->GetDroppedMessages());
+  }
+
+  EXPECT_TRUE(XFILE::CFile::Delete(logfile));
+}
+
+TEST_F(Testlog, AsyncFileSinkDropsWhenFull)
+{
+  const std::string logfile = CSpecialProtocol::TranslatePath("special://temp/asynclog.log");
+  std::size_t dropped;
+  {
+    auto sink = std::make_shared<CAsyncLogFileSink>(logfile, true, 1024);
+    sink->set_pattern("%v");
+    spdlog::logger logger("async", sink);
+
+    for (int i = 0; i < 10000; i++)
+      logger.info("message {}", i);
+
+    dropped = sink->GetDroppedMessages();
+  }
+
+  // destroying the sink writes out the queue together with the number of dropped messages
+  const std::string content = ReadLogFile(logfile);
+  EXPECT_EQ(10000u, CountLines(content, "message ") + dropped);
+  if (dropped > 0)
+    EXPECT_NE(std::string::npos, content.find("log messages dropped"));
+
+  EXPECT_TRUE(XFILE::CFile::Delete(logfile));
+}
+
+TEST_F(Testlog, AsyncFileSinkLatency)
+{
+  const std::string logfile = CSpecialProtocol::TranslatePath("special://temp/asynclog.log");
+  long long elapsed[2];
+  for (int async = 0; async < 2; async++)
+  {
+    auto sink = std::make_shared<CAsyncLogFileSink>(logfile, async != 0, 16 * 1024 * 1024);
+    sink->set_pattern("%Y-%m-%d %T.%e T:%-5t %7l <%n>: %v");
+    spdlog::logger logger("async", sink);
+    logger.set_level(spdlog::level::debug);
+    logger.flush_on(spdlog::level::debug);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20000; i++)
+      logger.debug("debug message {} with some payload to format", i);
+    elapsed[async] = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+  }
+
+  RecordProperty("SyncMicroseconds", static_cast<int>(elapsed[0]));
+  RecordProperty("AsyncMicroseconds", static_cast<int>(elapsed[1]));
+
+  const std::string content = ReadLogFile(logfile);
+  EXPECT_EQ(40000u, CountLines(content, "debug message "));
+  EXPECT_TRUE(XFILE::CFile::Delete(logfile));
+}
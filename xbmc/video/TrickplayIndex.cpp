@@ -0,0 +1,290 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TrickplayIndex.h"
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "TextureCache.h"
+#include "URL.h"
+#include "cores/VideoPlayer/DVDFileInfo.h"
+#include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/JobManager.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "utils/auto_buffer.h"
+#include "utils/log.h"
+#include "video/VideoThumbLoader.h"
+
+#include <algorithm>
+
+using namespace VIDEO;
+using namespace XFILE;
+
+namespace
+{
+constexpr int INDEX_VERSION = 1;
+constexpr unsigned int MAX_THUMBS = 1000;
+
+std::string GetThumbUrl(const std::string& path, size_t i)
+{
+  return StringUtils::Format("trickplay://%s/%u", path.c_str(), static_cast<unsigned int>(i));
+}
+
+std::string GetIndexUrl(const std::string& path)
+{
+  return "trickplay://" + path;
+}
+
+class CTrickplayIndexJob : public CJob
+{
+public:
+  CTrickplayIndexJob(const std::string& path, unsigned int interval, unsigned int width)
+    : m_path(path), m_interval(interval), m_width(width)
+  {
+  }
+
+  const char* GetType() const override { return "trickplayindex"; }
+
+  bool operator==(const CJob* job) const override
+  {
+    if (strcmp(job->GetType(), GetType()) != 0)
+      return false;
+    const CTrickplayIndexJob* other = dynamic_cast<const CTrickplayIndexJob*>(job);
+    return other && other->m_path == m_path;
+  }
+
+  bool DoWork() override
+  {
+    int duration = 0;
+    if (!CDVDFileInfo::GetFileDuration(m_path, duration) || duration <= 0)
+      return false;
+
+    // long files get a wider interval rather than an unbounded number of thumbs
+    unsigned int interval = std::max(m_interval, static_cast<unsigned int>(duration) / MAX_THUMBS);
+
+    std::vector<int64_t> positions;
+    for (int64_t pos = 0; pos < duration; pos += interval)
+      positions.push_back(pos);
+
+    m_details.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i)
+      m_details[i].file = CTextureCache::GetCacheFile(GetThumbUrl(m_path, i)) + ".jpg";
+
+    unsigned int nTime = XbmcThreads::SystemClockMillis();
+    CFileItem item(m_path, false);
+    int extracted = CDVDFileInfo::ExtractThumbs(item, positions, m_details,
+      [this, &positions](unsigned int processed)
+      {
+        while (m_thumbs.size() < processed)
+        {
+          const size_t i = m_thumbs.size();
+          m_thumbs.push_back({positions[i], CacheThumb(i) ? m_details[i].file : ""});
+        }
+        return !ShouldCancel(processed, positions.size());
+      }, m_width);
+
+    if (m_thumbs.size() < positions.size())
+      return false; // cancelled, don't store a partial index
+
+    m_thumbs.erase(std::remove_if(m_thumbs.begin(), m_thumbs.end(),
+                                  [](const CTrickplayIndex::Thumb& thumb) { return thumb.file.empty(); }),
+                   m_thumbs.end());
+    if (CTrickplayIndex::Save(CTrickplayIndex::GetIndexFile(m_path), m_thumbs))
+    {
+      CTextureDetails details;
+      details.file = CTextureCache::GetCacheFile(GetIndexUrl(m_path)) + ".json";
+      CTextureCache::GetInstance().AddCachedTexture(GetIndexUrl(m_path), details);
+    }
+
+    CLog::Log(LOGDEBUG, "CTrickplayIndexJob: extracted %d seek previews in %u ms for %s", extracted,
+              XbmcThreads::SystemClockMillis() - nTime, CURL::GetRedacted(m_path).c_str());
+    return extracted > 0;
+  }
+
+  /*! \brief The thumbs processed so far, failed ones have an empty file
+   Only to be accessed from the job's callbacks.
+   */
+  const std::vector<CTrickplayIndex::Thumb>& GetThumbs() const { return m_thumbs; }
+
+private:
+  /*! \brief Register an extracted thumb with the texture database so the texture cache
+   cleanup takes care of it, or remove the placeholder left for a failed one.
+   */
+  bool CacheThumb(size_t i)
+  {
+    const CTextureDetails& details = m_details[i];
+    if (details.width == 0)
+    {
+      CFile::Delete(CTextureCache::GetCachedPath(details.file));
+      return false;
+    }
+    CTextureCache::GetInstance().AddCachedTexture(GetThumbUrl(m_path, i), details);
+    return true;
+  }
+
+  std::string m_path;
+  unsigned int m_interval;
+  unsigned int m_width;
+  std::vector<CTextureDetails> m_details;
+  std::vector<CTrickplayIndex::Thumb> m_thumbs;
+};
+} // unnamed namespace
+
+CTrickplayIndex::~CTrickplayIndex()
+{
+  CancelJob();
+}
+
+void CTrickplayIndex::SetItem(const CFileItem* item)
+{
+  std::string path;
+  if (item && item->IsVideo() && !item->IsStack() && CThumbExtractor::CanExtractFrom(*item))
+    path = item->GetDynPath();
+
+  CSingleLock lock(m_section);
+  if (path == m_path)
+    return;
+
+  CancelJob();
+  m_path = path;
+  m_thumbs.clear();
+  m_published = 0;
+  m_generate = false;
+
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  if (m_path.empty() || advancedSettings->m_videoTrickplayInterval <= 0)
+    return;
+
+  // thumbs may have been removed by the texture cache cleanup since the index was written
+  if (Load(GetIndexFile(m_path), m_thumbs) &&
+      (m_thumbs.empty() || (CFile::Exists(CTextureCache::GetCachedPath(m_thumbs.front().file)) &&
+                            CFile::Exists(CTextureCache::GetCachedPath(m_thumbs.back().file)))))
+    return;
+  m_thumbs.clear();
+
+  // pausable jobs don't run during video playback, so rather than competing with the player
+  // from the start the job is deferred until previews are asked for
+  m_generate = true;
+}
+
+std::string CTrickplayIndex::GetThumb(int64_t time)
+{
+  CSingleLock lock(m_section);
+  if (m_generate)
+  {
+    m_generate = false;
+    const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    CLog::Log(LOGDEBUG, "CTrickplayIndex: generating seek previews for %s", CURL::GetRedacted(m_path).c_str());
+    m_jobId = CJobManager::GetInstance().AddJob(
+        new CTrickplayIndexJob(m_path, advancedSettings->m_videoTrickplayInterval * 1000,
+                               advancedSettings->m_videoTrickplayWidth),
+        this, CJob::PRIORITY_LOW);
+  }
+
+  auto it = std::upper_bound(m_thumbs.begin(), m_thumbs.end(), time,
+                             [](int64_t time, const Thumb& thumb) { return time < thumb.time; });
+  if (it == m_thumbs.begin())
+    return "";
+
+  return CTextureCache::GetCachedPath((--it)->file);
+}
+
+void CTrickplayIndex::OnJobProgress(unsigned int jobID,
+                                    unsigned int progress,
+                                    unsigned int total,
+                                    const CJob* job)
+{
+  CSingleLock lock(m_section);
+  if (jobID != m_jobId)
+    return;
+
+  // publish the thumbs as they are extracted, they come in time order
+  const auto& thumbs = static_cast<const CTrickplayIndexJob*>(job)->GetThumbs();
+  for (; m_published < thumbs.size(); ++m_published)
+  {
+    if (!thumbs[m_published].file.empty())
+      m_thumbs.push_back(thumbs[m_published]);
+  }
+}
+
+void CTrickplayIndex::OnJobComplete(unsigned int jobID, bool success, CJob* job)
+{
+  CSingleLock lock(m_section);
+  if (jobID == m_jobId)
+    m_jobId = 0;
+}
+
+void CTrickplayIndex::CancelJob()
+{
+  if (m_jobId)
+    CJobManager::GetInstance().CancelJob(m_jobId);
+  m_jobId = 0;
+}
+
+std::string CTrickplayIndex::GetIndexFile(const std::string& path)
+{
+  return CTextureCache::GetCachedPath(CTextureCache::GetCacheFile(GetIndexUrl(path)) + ".json");
+}
+
+bool CTrickplayIndex::Load(const std::string& indexFile, std::vector<Thumb>& thumbs)
+{
+  thumbs.clear();
+
+  XUTILS::auto_buffer buffer;
+  CFile file;
+  if (!CFile::Exists(indexFile) || file.LoadFile(indexFile, buffer) <= 0)
+    return false;
+
+  CVariant data;
+  if (!CJSONVariantParser::Parse(std::string(buffer.get(), buffer.size()), data) ||
+      data["version"].asInteger() != INDEX_VERSION)
+  {
+    CLog::Log(LOGWARNING, "CTrickplayIndex: Ignoring invalid index %s", indexFile.c_str());
+    return false;
+  }
+
+  const CVariant& entries = data["thumbs"];
+  thumbs.reserve(entries.size());
+  for (auto entry = entries.begin_array(); entry != entries.end_array(); ++entry)
+    thumbs.push_back({(*entry)[0].asInteger(), (*entry)[1].asString()});
+
+  return true;
+}
+
+bool CTrickplayIndex::Save(const std::string& indexFile, const std::vector<Thumb>& thumbs)
+{
+  CVariant entries(CVariant::VariantTypeArray);
+  for (const auto& thumb : thumbs)
+  {
+    CVariant e(CVariant::VariantTypeArray);
+    e.push_back(thumb.time);
+    e.push_back(thumb.file);
+    entries.push_back(std::move(e));
+  }
+
+  CVariant data(CVariant::VariantTypeObject);
+  data["version"] = INDEX_VERSION;
+  data["thumbs"] = std::move(entries);
+
+  std::string json;
+  CFile file;
+  if (!CJSONVariantWriter::Write(data, json, true) || !file.OpenForWrite(indexFile, true) ||
+      file.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CTrickplayIndex: Unable to save index %s", indexFile.c_str());
+    return false;
+  }
+  return true;
+}
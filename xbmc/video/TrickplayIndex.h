@@ -0,0 +1,85 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "utils/Job.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class CFileItem;
+
+namespace VIDEO
+{
+  /*!
+   \brief Seek preview thumbs of the playing video.
+
+   The index is a list of small thumbs taken at a fixed interval, generated once per file
+   by a background job using the regular demux/decode stack. The thumbs are stored in the
+   texture cache folder together with a timestamp table (a .json file next to them), so
+   later playbacks of the file have previews available immediately. Both are registered
+   with the texture database under trickplay:// urls, so the texture cache cleanup removes
+   them like any other cached image. The job is started on the first request for a thumb,
+   so files that are played without seeking don't pay for it. Thumbs become available while
+   the job is still running.
+
+   Seek previews are disabled unless <video><trickplayinterval> is set in advancedsettings.xml.
+   */
+  class CTrickplayIndex : public IJobCallback
+  {
+  public:
+    CTrickplayIndex() = default;
+    ~CTrickplayIndex() override;
+
+    /*! \brief Switch to the index of an item
+     Loads the stored index of the item, or marks it to be generated on first use.
+     \param item the playing item, nullptr to clear the index
+     */
+    void SetItem(const CFileItem* item);
+
+    /*! \brief Get the thumb of the preview closest before a time
+     Queues the job generating the index if it is still missing.
+     \param time playback time in ms
+     \return path of the cached thumb, empty if there is none yet
+     */
+    std::string GetThumb(int64_t time);
+
+    // IJobCallback implementation
+    void OnJobComplete(unsigned int jobID, bool success, CJob* job) override;
+    void OnJobProgress(unsigned int jobID, unsigned int progress, unsigned int total, const CJob* job) override;
+
+    struct Thumb
+    {
+      int64_t time; //!< position in ms
+      std::string file; //!< cache file, relative to the texture cache folder
+    };
+
+    /*! \brief Get the path of the timestamp table of a file
+     */
+    static std::string GetIndexFile(const std::string& path);
+
+    static bool Load(const std::string& indexFile, std::vector<Thumb>& thumbs);
+    static bool Save(const std::string& indexFile, const std::vector<Thumb>& thumbs);
+
+  private:
+    CTrickplayIndex(const CTrickplayIndex&) = delete;
+    CTrickplayIndex& operator=(const CTrickplayIndex&) = delete;
+
+    void CancelJob();
+
+    mutable CCriticalSection m_section;
+    std::string m_path;
+    std::vector<Thumb> m_thumbs; //!< sorted by time
+    size_t m_published = 0; //!< number of thumbs of the running job looked at
+    unsigned int m_jobId = 0;
+    bool m_generate = false; //!< index is missing and no job was queued yet
+  };
+}
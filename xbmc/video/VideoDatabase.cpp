@@ -70,6 +70,31 @@ using namespace ADDON;
 using namespace KODI::MESSAGING;
 using namespace KODI::GUILIB;
 
+namespace
+{
+/*! \brief SQL recomputing the tvshowcounts rows of the shows matching the given condition.
+ tvshowcounts is a table maintained by triggers rather than a view, so that listing
+ TV shows doesn't aggregate over every episode and file of the library.
+ */
+std::string RefreshTvShowCountsSQL(const std::string& showCondition)
+{
+  return "REPLACE INTO tvshowcounts (idShow, lastPlayed, totalCount, watchedcount, totalSeasons, dateAdded) "
+         "SELECT tvshow.idShow,"
+         "  MAX(files.lastPlayed),"
+         "  NULLIF(COUNT(episode.c12), 0),"
+         "  COUNT(files.playCount),"
+         "  NULLIF(COUNT(DISTINCT(episode.c12)), 0),"
+         "  MAX(files.dateAdded) "
+         "FROM tvshow"
+         "  LEFT JOIN episode ON"
+         "    episode.idShow=tvshow.idShow"
+         "  LEFT JOIN files ON"
+         "    files.idFile=episode.idFile "
+         "WHERE " + showCondition + " "
+         "GROUP BY tvshow.idShow";
+}
+}
+
 //********************************************************************************************************************************
 CVideoDatabase::CVideoDatabase(void) = default;
 
@@ -185,6 +210,9 @@ void CVideoDatabase::CreateTables()
   CLog::Log(LOGINFO, "create seasons table");
   m_pDS->exec("CREATE TABLE seasons ( idSeason integer primary key, idShow integer, season integer, name text, userrating integer)");
 
+  CLog::Log(LOGINFO, "create tvshowcounts table");
+  m_pDS->exec("CREATE TABLE tvshowcounts ( idShow integer primary key, lastPlayed text, totalCount integer, watchedcount integer, totalSeasons integer, dateAdded text)");
+
   CLog::Log(LOGINFO, "create art table");
   m_pDS->exec("CREATE TABLE art(art_id INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, type TEXT, url TEXT)");
 
@@ -308,6 +336,10 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM tag_link WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM rating WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM uniqueid WHERE media_id=old.idShow AND media_type='tvshow'; "
+              "DELETE FROM tvshowcounts WHERE idShow=old.idShow; "
+              "END");
+  m_pDS->exec("CREATE TRIGGER insert_tvshow AFTER INSERT ON tvshow FOR EACH ROW BEGIN "
+              "INSERT INTO tvshowcounts (idShow, watchedcount) VALUES (new.idShow, 0); "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_musicvideo AFTER DELETE ON musicvideo FOR EACH ROW BEGIN "
               "DELETE FROM actor_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
@@ -323,7 +355,14 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM writer_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM art WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM rating WHERE media_id=old.idEpisode AND media_type='episode'; "
-              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; "
+              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; " +
+              RefreshTvShowCountsSQL("tvshow.idShow=old.idShow") + "; "
+              "END");
+  m_pDS->exec("CREATE TRIGGER insert_episode AFTER INSERT ON episode FOR EACH ROW BEGIN " +
+              RefreshTvShowCountsSQL("tvshow.idShow=new.idShow") + "; "
+              "END");
+  m_pDS->exec("CREATE TRIGGER update_episode AFTER UPDATE ON episode FOR EACH ROW BEGIN " +
+              RefreshTvShowCountsSQL("tvshow.idShow IN (old.idShow, new.idShow)") + "; "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_season AFTER DELETE ON seasons FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.idSeason AND media_type='season'; "
@@ -343,6 +382,9 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM stacktimes WHERE idFile=old.idFile; "
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
               "END");
+  m_pDS->exec("CREATE TRIGGER update_file AFTER UPDATE ON files FOR EACH ROW BEGIN " +
+              RefreshTvShowCountsSQL("tvshow.idShow IN (SELECT idShow FROM episode WHERE idFile=new.idFile)") + "; "
+              "END");
 
   CreateViews();
 }
@@ -391,22 +433,6 @@ void CVideoDatabase::CreateViews()
                                       VIDEODB_ID_EPISODE_IDENT_ID);
   m_pDS->exec(episodeview);
 
-  CLog::Log(LOGINFO, "create tvshowcounts");
-  std::string tvshowcounts = PrepareSQL("CREATE VIEW tvshowcounts AS SELECT "
-                                       "      tvshow.idShow AS idShow,"
-                                       "      MAX(files.lastPlayed) AS lastPlayed,"
-                                       "      NULLIF(COUNT(episode.c12), 0) AS totalCount,"
-                                       "      COUNT(files.playCount) AS watchedcount,"
-                                       "      NULLIF(COUNT(DISTINCT(episode.c12)), 0) AS totalSeasons, "
-                                       "      MAX(files.dateAdded) as dateAdded "
-                                       "    FROM tvshow"
-                                       "      LEFT JOIN episode ON"
-                                       "        episode.idShow=tvshow.idShow"
-                                       "      LEFT JOIN files ON"
-                                       "        files.idFile=episode.idFile "
-                                       "GROUP BY tvshow.idShow");
-  m_pDS->exec(tvshowcounts);
-
   CLog::Log(LOGINFO, "create tvshowlinkpath_minview");
   // This view only exists to workaround a limitation in MySQL <5.7 which is not able to
   // perform subqueries in joins.
@@ -5709,11 +5735,17 @@ void CVideoDatabase::UpdateTables(int iVersion)
 
   if (iVersion < 119)
     m_pDS->exec("ALTER TABLE path ADD allAudio bool");
+
+  if (iVersion < 120)
+  { // tvshowcounts used to be a view, it is now maintained by triggers
+    m_pDS->exec("CREATE TABLE tvshowcounts ( idShow integer primary key, lastPlayed text, totalCount integer, watchedcount integer, totalSeasons integer, dateAdded text)");
+    m_pDS->exec(RefreshTvShowCountsSQL("1=1"));
+  }
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 119;
+  return 120;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -45,6 +45,7 @@
 #include "utils/Variant.h"
 #include "utils/log.h"
 #include "video/VideoLibraryQueue.h"
+#include "video/VideoScanPrefetcher.h"
 #include "video/VideoThumbLoader.h"
 
 #include <algorithm>
@@ -102,6 +103,13 @@ namespace VIDEO
 
       m_database.Open();
 
+      m_dirsScanned = 0;
+      m_dirsUnchanged = 0;
+      m_itemsScanned = 0;
+      const int prefetchThreads = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iVideoScannerPrefetchThreads;
+      if (prefetchThreads > 0)
+        m_prefetcher.reset(new CVideoScanPrefetcher(prefetchThreads));
+
       m_bCanInterrupt = true;
 
       CLog::Log(LOGINFO, "VideoInfoScanner: Starting scan ..");
@@ -123,6 +131,16 @@ namespace VIDEO
          * occurs.
          */
         std::string directory = *m_pathsToScan.begin();
+
+        // keep the prefetcher busy with the folders that come after this one
+        if (m_prefetcher)
+        {
+          unsigned int ahead = 0;
+          for (auto it = std::next(m_pathsToScan.begin());
+               it != m_pathsToScan.end() && ahead < PrefetchWindow(); ++it, ++ahead)
+            PrefetchDirectory(*it);
+        }
+
         if (m_bStop)
         {
           bCancelled = true;
@@ -159,12 +177,20 @@ namespace VIDEO
       tick = XbmcThreads::SystemClockMillis() - tick;
       CLog::Log(LOGINFO, "VideoInfoScanner: Finished scan. Scanning for video info took %s",
                 StringUtils::SecondsToTimeString(tick / 1000).c_str());
+      CLog::Log(LOGINFO,
+                "VideoInfoScanner: Scanned %u folders (%u unchanged), %u items (%.1f items/s)",
+                m_dirsScanned, m_dirsUnchanged, m_itemsScanned,
+                tick ? m_itemsScanned * 1000.0 / tick : 0.0);
+      if (m_prefetcher)
+        CLog::Log(LOGDEBUG, "VideoInfoScanner: Prefetched %u of %u folder lookups",
+                  m_prefetcher->GetHits(), m_prefetcher->GetHits() + m_prefetcher->GetMisses());
     }
     catch (...)
     {
       CLog::Log(LOGERROR, "VideoInfoScanner: Exception while scanning.");
     }
 
+    m_prefetcher.reset();
     m_bRunning = false;
     CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary,
                                                        "OnScanFinished");
@@ -219,6 +245,52 @@ namespace VIDEO
     m_bStop = true;
   }
 
+  void CVideoInfoScanner::PrefetchDirectory(const std::string& directory)
+  {
+    if (m_prefetcher->IsQueued(directory) || URIUtils::IsPlugin(directory))
+      return;
+
+    SScanSettings settings;
+    bool foundDirectly = false;
+    ScraperPtr info = m_database.GetScraperForPath(directory, settings, foundDirectly);
+    if (!info || (info->Content() != CONTENT_MOVIES && info->Content() != CONTENT_MUSICVIDEOS))
+      return;
+    if (!m_scanAll && settings.noupdate)
+      return;
+
+    const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    if (CUtil::ExcludeFileOrFolder(directory, *advancedSettings->m_moviesExcludeFromScanRegExpSet))
+      return;
+
+    std::string dbHash;
+    m_database.GetPathHash(directory, dbHash);
+    m_prefetcher->Queue(directory, dbHash, advancedSettings->m_moviesExcludeFromScanRegExps,
+                        advancedSettings->m_bVideoLibraryUseFastHash);
+  }
+
+  void CVideoInfoScanner::PrefetchSubfolders(const CFileItemList& items, int start)
+  {
+    if (!m_prefetcher)
+      return;
+
+    unsigned int queued = 0;
+    for (int i = start; i < items.Size() && queued < PrefetchWindow(); ++i)
+    {
+      const CFileItemPtr& item = items[i];
+      if (item->m_bIsFolder && !item->IsParentFolder() && !item->IsPlayList())
+      {
+        PrefetchDirectory(item->GetPath());
+        queued++;
+      }
+    }
+  }
+
+  unsigned int CVideoInfoScanner::PrefetchWindow() const
+  {
+    // enough to keep every prefetch worker busy while the scanner thread catches up
+    return 2 * CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iVideoScannerPrefetchThreads;
+  }
+
   static void OnDirectoryScanned(const std::string& strDirectory)
   {
     CGUIMessage msg(GUI_MSG_DIRECTORY_SCANNED, 0, 0, 0);
@@ -252,10 +324,13 @@ namespace VIDEO
     CONTENT_TYPE content = info ? info->Content() : CONTENT_NONE;
 
     // exclude folders that match our exclude regexps
-    const std::vector<std::string> &regexps = content == CONTENT_TVSHOWS ? CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowExcludeFromScanRegExps
-                                                         : CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_moviesExcludeFromScanRegExps;
+    const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    const std::vector<std::string> &regexps = content == CONTENT_TVSHOWS ? advancedSettings->m_tvshowExcludeFromScanRegExps
+                                                         : advancedSettings->m_moviesExcludeFromScanRegExps;
+    const std::shared_ptr<const CRegExpSet> regExpSet = content == CONTENT_TVSHOWS ? advancedSettings->m_tvshowExcludeFromScanRegExpSet
+                                                                                   : advancedSettings->m_moviesExcludeFromScanRegExpSet;
 
-    if (CUtil::ExcludeFileOrFolder(strDirectory, regexps))
+    if (CUtil::ExcludeFileOrFolder(strDirectory, *regExpSet))
       return true;
 
     if (HasNoMedia(strDirectory))
@@ -283,8 +358,16 @@ namespace VIDEO
         m_handle->SetTitle(StringUtils::Format(g_localizeStrings.Get(str).c_str(), info->Name().c_str()));
       }
 
+      CVideoScanPrefetcher::Result prefetched;
+      const bool isPrefetched =
+          m_prefetcher && m_prefetcher->Take(strDirectory, prefetched, [this]() { return m_bStop; });
+      if (m_bStop)
+        return false;
+
       std::string fastHash;
-      if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseFastHash && !URIUtils::IsPlugin(strDirectory))
+      if (isPrefetched)
+        fastHash = prefetched.fastHash;
+      else if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseFastHash && !URIUtils::IsPlugin(strDirectory))
         fastHash = GetFastHash(strDirectory, regexps);
 
       if (m_database.GetPathHash(strDirectory, dbHash) && !fastHash.empty() && StringUtils::EqualsNoCase(fastHash, dbHash))
@@ -293,12 +376,17 @@ namespace VIDEO
       }
       else
       { // need to fetch the folder
-        CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
-                                 DIR_FLAG_DEFAULTS);
-        items.Stack();
+        if (isPrefetched && prefetched.hasListing)
+          items.Assign(prefetched.items);
+        else
+        {
+          CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
+                                   DIR_FLAG_DEFAULTS);
+          items.Stack();
+        }
 
         // check whether to re-use previously computed fast hash
-        if (!CanFastHash(items, regexps) || fastHash.empty())
+        if (!CanFastHash(items, *regExpSet) || fastHash.empty())
           GetPathHash(items, hash);
         else
           hash = fastHash;
@@ -352,8 +440,18 @@ namespace VIDEO
       }
     }
 
+    m_dirsScanned++;
+    if (bSkip)
+      m_dirsUnchanged++;
+
+    // list the first subfolders we are going to recurse into while this folder is scraped
+    const bool recurse = settings.recurse > 0 && content != CONTENT_TVSHOWS;
+    if (recurse)
+      PrefetchSubfolders(items, 0);
+
     if (!bSkip)
     {
+      m_itemsScanned += items.Size();
       if (RetrieveVideoInfo(items, settings.parent_name_root, content))
       {
         if (!m_bStop && (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS))
@@ -388,8 +486,9 @@ namespace VIDEO
 
       // if we have a directory item (non-playlist) we then recurse into that folder
       // do not recurse for tv shows - we have already looked recursively for episodes
-      if (pItem->m_bIsFolder && !pItem->IsParentFolder() && !pItem->IsPlayList() && settings.recurse > 0 && content != CONTENT_TVSHOWS)
+      if (pItem->m_bIsFolder && !pItem->IsParentFolder() && !pItem->IsPlayList() && recurse)
       {
+        PrefetchSubfolders(items, i + 1);
         if (!DoScan(pItem->GetPath()))
         {
           m_bStop = true;
@@ -432,8 +531,8 @@ namespace VIDEO
         continue;
 
       // Discard all exclude files defined by regExExclude
-      if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), (content == CONTENT_TVSHOWS) ? CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowExcludeFromScanRegExps
-                                                                    : CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_moviesExcludeFromScanRegExps))
+      if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), (content == CONTENT_TVSHOWS) ? *CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowExcludeFromScanRegExpSet
+                                                                    : *CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_moviesExcludeFromScanRegExpSet))
         continue;
 
       if (info2->Content() == CONTENT_MOVIES || info2->Content() == CONTENT_MUSICVIDEOS)
@@ -838,6 +937,7 @@ namespace VIDEO
   {
     CFileItemList items;
     const std::vector<std::string> &regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowExcludeFromScanRegExps;
+    const std::shared_ptr<const CRegExpSet> regExpSet = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowExcludeFromScanRegExpSet;
 
     bool bSkip = false;
 
@@ -982,7 +1082,7 @@ namespace VIDEO
         continue;
 
       // Discard all exclude files defined by regExExcludes
-      if (CUtil::ExcludeFileOrFolder(items[i]->GetPath(), regexps))
+      if (CUtil::ExcludeFileOrFolder(items[i]->GetPath(), *regExpSet))
         continue;
 
       /*
@@ -1097,7 +1197,8 @@ namespace VIDEO
 
   bool CVideoInfoScanner::EnumerateEpisodeItem(const CFileItem *item, EPISODELIST& episodeList)
   {
-    SETTINGS_TVSHOWLIST expression = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowEnumRegExps;
+    const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    const SETTINGS_TVSHOWLIST& expression = advancedSettings->m_tvshowEnumRegExps;
 
     std::string strLabel;
 
@@ -1116,7 +1217,7 @@ namespace VIDEO
     for (unsigned int i=0;i<expression.size();++i)
     {
       CRegExp reg(true, CRegExp::autoUtf8);
-      if (!reg.RegComp(expression[i].regexp))
+      if (!reg.RegComp(expression[i].regexp, CRegExp::StudyWithJitComp))
         continue;
 
       int regexppos, regexp2pos;
@@ -1186,7 +1287,7 @@ namespace VIDEO
 
       CRegExp reg2(true, CRegExp::autoUtf8);
       // check the remainder of the string for any further episodes.
-      if (!byDate && reg2.RegComp(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowMultiPartEnumRegExp))
+      if (!byDate && reg2.RegComp(advancedSettings->m_tvshowMultiPartEnumRegExp, CRegExp::StudyWithJitComp))
       {
         int offset = 0;
 
@@ -1934,7 +2035,7 @@ namespace VIDEO
     return count;
   }
 
-  bool CVideoInfoScanner::CanFastHash(const CFileItemList &items, const std::vector<std::string> &excludes) const
+  bool CVideoInfoScanner::CanFastHash(const CFileItemList &items, const CRegExpSet &excludes) const
   {
     if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseFastHash || items.IsPlugin())
       return false;
@@ -1948,7 +2049,7 @@ namespace VIDEO
   }
 
   std::string CVideoInfoScanner::GetFastHash(const std::string &directory,
-      const std::vector<std::string> &excludes) const
+      const std::vector<std::string> &excludes)
   {
     CDigest digest{CDigest::Type::MD5};
 
@@ -12,17 +12,20 @@
 #include "VideoDatabase.h"
 #include "addons/Scraper.h"
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 class CRegExp;
+class CRegExpSet;
 class CFileItem;
 class CFileItemList;
 
 namespace VIDEO
 {
   class IVideoInfoTagLoader;
+  class CVideoScanPrefetcher;
 
   typedef struct SScanSettings
   {
@@ -188,7 +191,7 @@ namespace VIDEO
      \param excludes string array of exclude expressions
      \return the md5 hash of the folder"
      */
-    std::string GetFastHash(const std::string &directory, const std::vector<std::string> &excludes) const;
+    static std::string GetFastHash(const std::string &directory, const std::vector<std::string> &excludes);
 
     /*! \brief Retrieve a "fast" hash of the given directory recursively (if available)
      Performs a stat() on the directory, and uses modified time to create a "fast"
@@ -207,10 +210,10 @@ namespace VIDEO
      fast hash technique uses modified time to determine when folder content changes, which
      is generally not propagated up the directory tree.
      \param items the directory listing
-     \param excludes string array of exclude expressions
+     \param excludes compiled exclude expressions
      \return true if this directory listing can be fast hashed, false otherwise
      */
-    bool CanFastHash(const CFileItemList &items, const std::vector<std::string> &excludes) const;
+    bool CanFastHash(const CFileItemList &items, const CRegExpSet &excludes) const;
 
     /*! \brief Process a series folder, filling in episode details and adding them to the database.
      @todo Ideally we would return INFO_HAVE_ALREADY if we don't have to update any episodes
@@ -225,6 +228,19 @@ namespace VIDEO
      */
     INFO_RET OnProcessSeriesFolder(EPISODELIST& files, const ADDON::ScraperPtr &scraper, bool useLocal, const CVideoInfoTag& showInfo, CGUIDialogProgress* pDlgProgress = NULL);
 
+    /*! \brief Queue a movie or music video folder for background listing.
+     Folders whose scraper content is not movies or music videos, and excluded folders, are ignored.
+     \param directory folder the scanner is going to visit
+     */
+    void PrefetchDirectory(const std::string& directory);
+
+    /*! \brief Queue the next few subfolders of a listing for background listing.
+     \param items the folder listing
+     \param start index of the first item to consider
+     */
+    void PrefetchSubfolders(const CFileItemList& items, int start);
+    unsigned int PrefetchWindow() const;
+
     bool EnumerateSeriesFolder(CFileItem* item, EPISODELIST& episodeList);
     bool ProcessItemByVideoInfoTag(const CFileItem *item, EPISODELIST &episodeList);
 
@@ -234,8 +250,14 @@ namespace VIDEO
     CVideoDatabase m_database;
     std::set<std::string> m_pathsToCount;
     std::set<int> m_pathsToClean;
+    std::unique_ptr<CVideoScanPrefetcher> m_prefetcher;
+    unsigned int m_dirsScanned = 0;
+    unsigned int m_dirsUnchanged = 0;
+    unsigned int m_itemsScanned = 0;
 
   private:
+    friend class CVideoScanPrefetcher;
+
     static void AddLocalItemArtwork(CGUIListItem::ArtMap& itemArt,
       const std::vector<std::string>& wantedArtTypes, const std::string& itemPath,
       bool addAll, bool exactName);
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoScanPrefetcher.h"
+
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "filesystem/Directory.h"
+#include "utils/FileExtensionProvider.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+#include "video/VideoInfoScanner.h"
+
+#include <algorithm>
+
+using namespace XFILE;
+
+namespace
+{
+constexpr unsigned int WAIT_SLICE_MS = 100;
+} // unnamed namespace
+
+namespace VIDEO
+{
+
+CVideoScanPrefetcher::CVideoScanPrefetcher(unsigned int threads)
+  : m_queue(false, std::max(threads, 1u), CJob::PRIORITY_NORMAL, true)
+{
+}
+
+CVideoScanPrefetcher::~CVideoScanPrefetcher()
+{
+  Cancel();
+}
+
+void CVideoScanPrefetcher::Queue(const std::string& directory,
+                                 const std::string& dbHash,
+                                 const std::vector<std::string>& excludes,
+                                 bool useFastHash)
+{
+  if (m_entries.find(directory) != m_entries.end())
+    return;
+
+  std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+  m_entries.insert(std::make_pair(directory, entry));
+
+  // the job only holds on to the entry, so it may safely outlive the prefetcher
+  m_queue.Submit([entry, directory, dbHash, excludes, useFastHash]() {
+    if (!entry->cancelled)
+    {
+      Result& result = entry->result;
+      if (useFastHash)
+        result.fastHash = CVideoInfoScanner::GetFastHash(directory, excludes);
+
+      if (result.fastHash.empty() || !StringUtils::EqualsNoCase(result.fastHash, dbHash))
+      {
+        CDirectory::GetDirectory(directory, result.items,
+                                 CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
+                                 DIR_FLAG_DEFAULTS);
+        result.items.Stack();
+        result.hasListing = true;
+      }
+    }
+    entry->done.Set();
+  });
+}
+
+bool CVideoScanPrefetcher::IsQueued(const std::string& directory) const
+{
+  return m_entries.find(directory) != m_entries.end();
+}
+
+bool CVideoScanPrefetcher::Take(const std::string& directory,
+                                Result& result,
+                                const std::function<bool()>& stopped)
+{
+  auto it = m_entries.find(directory);
+  if (it == m_entries.end())
+  {
+    m_misses++;
+    return false;
+  }
+
+  std::shared_ptr<Entry> entry = it->second;
+  m_entries.erase(it);
+
+  // wait in slices, a fetch stuck on an unresponsive share mustn't block stopping the scan
+  while (!entry->done.WaitMSec(WAIT_SLICE_MS))
+  {
+    if (stopped && stopped())
+    {
+      entry->cancelled = true;
+      return false;
+    }
+  }
+  if (entry->cancelled)
+    return false;
+
+  result.fastHash = entry->result.fastHash;
+  result.hasListing = entry->result.hasListing;
+  result.items.Assign(entry->result.items);
+  m_hits++;
+
+  CLog::Log(LOGDEBUG, "VideoScanPrefetcher: Using prefetched %s for '%s'",
+            result.hasListing ? "listing" : "fast hash", CURL::GetRedacted(directory).c_str());
+  return true;
+}
+
+void CVideoScanPrefetcher::Cancel()
+{
+  for (auto& it : m_entries)
+    it.second->cancelled = true;
+  m_entries.clear();
+  m_queue.CancelJobs();
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "FileItem.h"
+#include "threads/Event.h"
+#include "utils/JobManager.h"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VIDEO
+{
+  /*!
+   \brief Fetches folder listings for the video scanner ahead of time.
+
+   Listing folders on network shares is latency bound, so the scanner queues the folders
+   it is going to visit next and they are stat'ed and listed on a bounded number of job
+   workers while the scanner thread keeps scraping. Workers never touch the database;
+   all database reads and writes stay on the scanner thread.
+   */
+  class CVideoScanPrefetcher
+  {
+  public:
+    struct Result
+    {
+      std::string fastHash; //!< fast hash of the folder, empty if not computed
+      bool hasListing = false; //!< whether items holds the (stacked) folder listing
+      CFileItemList items;
+    };
+
+    /*! \brief Create a prefetcher
+     \param threads maximum number of folders fetched concurrently
+     */
+    explicit CVideoScanPrefetcher(unsigned int threads);
+    ~CVideoScanPrefetcher();
+
+    /*! \brief Queue a folder for prefetching. Folders already queued are ignored.
+     \param directory folder to fetch
+     \param dbHash hash currently stored in the database for the folder
+     \param excludes exclude from scan expressions used for the fast hash
+     \param useFastHash whether a matching fast hash makes the listing unnecessary
+     */
+    void Queue(const std::string& directory,
+               const std::string& dbHash,
+               const std::vector<std::string>& excludes,
+               bool useFastHash);
+
+    /*! \brief Check whether a folder has been queued and not yet taken
+     */
+    bool IsQueued(const std::string& directory) const;
+
+    /*! \brief Retrieve the prefetched data of a folder, waiting for it if still in progress
+     \param directory folder to retrieve
+     \param result [out] the prefetched data
+     \param stopped polled while waiting, the wait is abandoned once it returns true
+     \return true if the folder was queued and fetched, false otherwise
+     */
+    bool Take(const std::string& directory,
+              Result& result,
+              const std::function<bool()>& stopped = nullptr);
+
+    /*! \brief Drop all queued folders and abandon the ones being fetched
+     */
+    void Cancel();
+
+    unsigned int GetHits() const { return m_hits; }
+    unsigned int GetMisses() const { return m_misses; }
+
+  private:
+    struct Entry
+    {
+      CEvent done{true};
+      std::atomic<bool> cancelled{false};
+      Result result;
+    };
+
+    CJobQueue m_queue;
+    std::map<std::string, std::shared_ptr<Entry>> m_entries;
+    unsigned int m_hits = 0;
+    unsigned int m_misses = 0;
+  };
+}
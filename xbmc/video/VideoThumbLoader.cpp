@@ -78,29 +78,37 @@ bool CThumbExtractor::operator==(const CJob* job) const
   return false;
 }
 
-bool CThumbExtractor::DoWork()
+bool CThumbExtractor::CanExtractFrom(const CFileItem& item)
 {
-  if (m_item.IsLiveTV()
+  if (item.IsLiveTV()
   // Due to a pvr addon api design flaw (no support for multiple concurrent streams
   // per addon instance), pvr recording thumbnail extraction does not work (reliably).
-  ||  URIUtils::IsPVRRecording(m_item.GetDynPath())
-  ||  URIUtils::IsUPnP(m_item.GetPath())
-  ||  URIUtils::IsBluray(m_item.GetPath())
-  ||  URIUtils::IsPlugin(m_item.GetDynPath()) // plugin path not fully resolved
-  ||  m_item.IsBDFile()
-  ||  m_item.IsDVD()
-  ||  m_item.IsDiscImage()
-  ||  m_item.IsDVDFile(false, true)
-  ||  m_item.IsInternetStream()
-  ||  m_item.IsDiscStub()
-  ||  m_item.IsPlayList())
+  ||  URIUtils::IsPVRRecording(item.GetDynPath())
+  ||  URIUtils::IsUPnP(item.GetPath())
+  ||  URIUtils::IsBluray(item.GetPath())
+  ||  URIUtils::IsPlugin(item.GetDynPath()) // plugin path not fully resolved
+  ||  item.IsBDFile()
+  ||  item.IsDVD()
+  ||  item.IsDiscImage()
+  ||  item.IsDVDFile(false, true)
+  ||  item.IsInternetStream()
+  ||  item.IsDiscStub()
+  ||  item.IsPlayList())
     return false;
 
   // For HTTP/FTP we only allow extraction when on a LAN
-  if (URIUtils::IsRemote(m_item.GetPath()) &&
-     !URIUtils::IsOnLAN(m_item.GetPath())  &&
-     (URIUtils::IsFTP(m_item.GetPath())    ||
-      URIUtils::IsHTTP(m_item.GetPath())))
+  if (URIUtils::IsRemote(item.GetPath()) &&
+     !URIUtils::IsOnLAN(item.GetPath())  &&
+     (URIUtils::IsFTP(item.GetPath())    ||
+      URIUtils::IsHTTP(item.GetPath())))
+    return false;
+
+  return true;
+}
+
+bool CThumbExtractor::DoWork()
+{
+  if (!CanExtractFrom(m_item))
     return false;
 
   bool result=false;
@@ -177,6 +185,57 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
+CThumbBatchExtractor::CThumbBatchExtractor(const CFileItem& item,
+                                           std::vector<std::pair<std::string, int64_t>> thumbs)
+  : m_item(item), m_thumbs(std::move(thumbs))
+{
+  if (m_item.IsStack())
+    m_item.SetPath(CStackDirectory::GetFirstStackedFile(m_item.GetPath()));
+}
+
+bool CThumbBatchExtractor::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) == 0)
+  {
+    const CThumbBatchExtractor* jobExtract = dynamic_cast<const CThumbBatchExtractor*>(job);
+    if (jobExtract && jobExtract->m_item.GetPath() == m_item.GetPath() &&
+        jobExtract->m_thumbs == m_thumbs)
+      return true;
+  }
+  return false;
+}
+
+bool CThumbBatchExtractor::DoWork()
+{
+  if (m_thumbs.empty() || !CThumbExtractor::CanExtractFrom(m_item))
+    return false;
+
+  CLog::Log(LOGDEBUG, "{} - trying to extract {} thumbs from video file {}", __FUNCTION__,
+            m_thumbs.size(), CURL::GetRedacted(m_item.GetPath()));
+
+  std::vector<int64_t> positions;
+  std::vector<CTextureDetails> details(m_thumbs.size());
+  for (size_t i = 0; i < m_thumbs.size(); ++i)
+  {
+    positions.push_back(m_thumbs[i].second);
+    details[i].file = CTextureCache::GetCacheFile(m_thumbs[i].first) + ".jpg";
+  }
+
+  size_t done = 0;
+  int extracted = CDVDFileInfo::ExtractThumbs(
+      m_item, positions, details, [this, &details, &done](unsigned int processed) {
+        // register the finished thumbs before reporting them
+        for (; done < processed; ++done)
+        {
+          if (details[done].width > 0)
+            CTextureCache::GetInstance().AddCachedTexture(m_thumbs[done].first, details[done]);
+        }
+        return !ShouldCancel(processed, m_thumbs.size());
+      });
+
+  return extracted > 0;
+}
+
 CVideoThumbLoader::CVideoThumbLoader() :
   CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
 {
@@ -13,6 +13,7 @@
 #include "utils/JobManager.h"
 
 #include <map>
+#include <utility>
 #include <vector>
 
 class CStreamDetails;
@@ -48,6 +49,12 @@ public:
 
   bool operator==(const CJob* job) const override;
 
+  /*!
+   \brief Check whether thumbs can be extracted from an item.
+   Excludes live streams, disc images and remote files that are not on the LAN.
+   */
+  static bool CanExtractFrom(const CFileItem& item);
+
   std::string m_target; ///< thumbpath
   std::string m_listpath; ///< path used in fileitem list
   CFileItem  m_item;
@@ -56,6 +63,35 @@ public:
   bool m_fillStreamDetails; ///< fill in stream details?
 };
 
+/*!
+ \ingroup thumbs,jobs
+ \brief Job extracting several thumbs from one video file in a single pass
+
+ The file is opened and its decoder set up once for all thumbs, which makes it
+ suitable for chapter thumbs. Progress is reported after each thumb, with the
+ number of processed thumbs as progress value.
+
+ \sa CThumbExtractor and CDVDFileInfo::ExtractThumbs
+ */
+class CThumbBatchExtractor : public CJob
+{
+public:
+  CThumbBatchExtractor(const CFileItem& item, std::vector<std::pair<std::string, int64_t>> thumbs);
+  ~CThumbBatchExtractor() override = default;
+
+  bool DoWork() override;
+
+  const char* GetType() const override
+  {
+    return kJobTypeMediaFlags;
+  }
+
+  bool operator==(const CJob* job) const override;
+
+  CFileItem m_item;
+  std::vector<std::pair<std::string, int64_t>> m_thumbs; ///< thumbpath and position in ms of each thumb
+};
+
 class CVideoThumbLoader : public CThumbLoader, public CJobQueue
 {
 public:
@@ -261,6 +261,8 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
   }
 
   // add chapters if around
+  std::vector<std::pair<std::string, int64_t>> chapterThumbs;
+  std::vector<unsigned int> chapterIndexes;
   for (int i = 1; i <= g_application.GetAppPlayer().GetChapterCount(); ++i)
   {
     std::string chapterName;
@@ -283,10 +285,8 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
       item->SetArt("thumb", cachefile);
     else if (i > m_jobsStarted && CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTCHAPTERTHUMBS))
     {
-      CFileItem item(m_filePath, false);
-      CJob* job = new CThumbExtractor(item, m_filePath, true, chapterPath, pos * 1000, false);
-      AddJob(job);
-      m_mapJobsChapter[job] = i;
+      chapterThumbs.emplace_back(chapterPath, pos * 1000);
+      chapterIndexes.push_back(i);
       m_jobsStarted++;
     }
 
@@ -296,6 +296,14 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
+  // extract all missing chapter thumbs in a single pass over the file
+  if (!chapterThumbs.empty())
+  {
+    CJob* job = new CThumbBatchExtractor(CFileItem(m_filePath, false), std::move(chapterThumbs));
+    m_mapJobsChapter[job] = std::move(chapterIndexes);
+    AddJob(job);
+  }
+
   // sort items by resume point
   std::sort(items.begin(), items.end(), [](const CFileItemPtr &item1, const CFileItemPtr &item2) {
     return item1->GetProperty("resumepoint").asDouble() < item2->GetProperty("resumepoint").asDouble();
@@ -557,19 +565,31 @@ bool CGUIDialogVideoBookmarks::OnAddEpisodeBookmark()
   return bReturn;
 }
 
+void CGUIDialogVideoBookmarks::OnJobProgress(unsigned int jobID,
+                                             unsigned int progress,
+                                             unsigned int total,
+                                             const CJob* job)
+{
+  if (progress == 0 || !IsActive())
+    return;
+
+  // refresh each chapter as soon as its thumb has been extracted
+  CSingleLock lock(m_refreshSection);
+  MAPJOBSCHAPS::const_iterator iter = m_mapJobsChapter.find(const_cast<CJob*>(job));
+  if (iter != m_mapJobsChapter.end() && progress <= iter->second.size())
+  {
+    unsigned int chapterIdx = iter->second[progress - 1];
+    CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
+    CApplicationMessenger::GetInstance().SendGUIMessage(m);
+  }
+}
+
 void CGUIDialogVideoBookmarks::OnJobComplete(unsigned int jobID,
                                              bool success, CJob* job)
 {
-  if (success && IsActive())
   {
-    MAPJOBSCHAPS::iterator iter = m_mapJobsChapter.find(job);
-    if (iter != m_mapJobsChapter.end())
-    {
-      unsigned int chapterIdx = (*iter).second;
-      CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
-      CApplicationMessenger::GetInstance().SendGUIMessage(m);
-      m_mapJobsChapter.erase(iter);
-    }
+    CSingleLock lock(m_refreshSection);
+    m_mapJobsChapter.erase(job);
   }
   CJobQueue::OnJobComplete(jobID, success, job);
 }
@@ -17,7 +17,7 @@ class CFileItemList;
 
 class CGUIDialogVideoBookmarks : public CGUIDialog, public CJobQueue
 {
-  typedef std::map<CJob*, unsigned int> MAPJOBSCHAPS;
+  typedef std::map<CJob*, std::vector<unsigned int>> MAPJOBSCHAPS;
 
 public:
   CGUIDialogVideoBookmarks(void);
@@ -60,6 +60,7 @@ protected:
   void OnPopupMenu(int item);
   CGUIControl *GetFirstFocusableControl(int id) override;
 
+  void OnJobProgress(unsigned int jobID, unsigned int progress, unsigned int total, const CJob* job) override;
   void OnJobComplete(unsigned int jobID, bool success, CJob* job) override;
 
   CFileItemList* m_vecItems;